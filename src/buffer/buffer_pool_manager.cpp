@@ -58,14 +58,33 @@ Page *BufferPoolManager::FetchPage(page_id_t page_id) {
     }
   }
   auto result = pages_ + frame_id;
-  result->pin_count_ = 1;
-  result->is_dirty_ = false;
-  result->page_id_ = page_id;
+  ResetFrame(result, page_id);
   page_table_[page_id] = frame_id;
   disk_manager_->ReadPage(page_id, result->GetData());
   return result;
 }
 
+Page *BufferPoolManager::FetchPage(page_id_t page_id, Page *&ref) {
+  // 帧仍然存放着该页时直接pin住，不查page_table_
+  if (swizzling_ && ref != nullptr && ref->page_id_ == page_id) {
+    if (ref->pin_count_++ == 0) {
+      replacer_->Pin(ref - pages_);
+    }
+    return ref;
+  }
+  Page *result = FetchPage(page_id);
+  ref = result;
+  return result;
+}
+
+void BufferPoolManager::ResetFrame(Page *page, page_id_t page_id) {
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  page->page_id_ = page_id;
+  // 旧页面的引用对新页面没有意义
+  page->swizzled_.clear();
+}
+
 Page *BufferPoolManager::NewPage(page_id_t &page_id) {
   // 0.   Make sure you call AllocatePage!
   // 1.   If all the pages in the buffer pool are pinned, return nullptr.
@@ -103,9 +122,7 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
   page_id = AllocatePage();
   auto result = pages_ + frame_id;
   result->ResetMemory();
-  result->pin_count_ = 1;
-  result->is_dirty_ = false;
-  result->page_id_ = page_id;
+  ResetFrame(result, page_id);
   page_table_[page_id] = frame_id;
   //  std::cout << "\tresult page_id is " << result->page_id_ << std::endl;
   return result;
@@ -117,27 +134,44 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
   // 1.   If P does not exist, return true.
   // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
   // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
-  auto temp = page_table_.find(page_id);
-  if (temp != page_table_.end()) {
-    DeallocatePage(page_id);
-    auto frame_id = temp->second;
-    Page *page_pointer = &pages_[frame_id];
-    if (page_pointer->GetPinCount() != 0) {
-      // If P exists, but has a non-zero pin-count, return false. Someone is using the page.
-      return false;
-    }
-    if (page_pointer->is_dirty_) {
-      // dirty, write it to disk
-      disk_manager_->WritePage(page_id, page_pointer->GetData());
-      page_pointer->is_dirty_ = false;
+  if (!EvictDeletedPage(page_id)) {
+    // If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+    return false;
+  }
+  // P is not (or no longer) in the buffer, free it on disk
+  DeallocatePage(page_id);
+  return true;
+}
+
+bool BufferPoolManager::DeletePages(const std::vector<page_id_t> &page_ids) {
+  std::vector<page_id_t> freed;
+  freed.reserve(page_ids.size());
+  for (auto page_id : page_ids) {
+    if (EvictDeletedPage(page_id)) {
+      freed.push_back(page_id);
     }
-    page_table_.erase(page_id);
-    replacer_->Pin(frame_id);
-    // TODO reset page?
-    free_list_.push_back(frame_id);
+  }
+  disk_manager_->DeAllocatePages(freed);
+  return freed.size() == page_ids.size();
+}
+
+bool BufferPoolManager::EvictDeletedPage(page_id_t page_id) {
+  auto temp = page_table_.find(page_id);
+  if (temp == page_table_.end()) {
     return true;
   }
-  // not exist, return true
+  auto frame_id = temp->second;
+  Page *page_pointer = &pages_[frame_id];
+  if (page_pointer->GetPinCount() != 0) {
+    return false;
+  }
+  // the content is dropped with the page, no need to write it back
+  page_pointer->is_dirty_ = false;
+  page_pointer->page_id_ = INVALID_PAGE_ID;
+  page_pointer->swizzled_.clear();
+  page_table_.erase(temp);
+  replacer_->Pin(frame_id);
+  free_list_.push_back(frame_id);
   return true;
 }
 
@@ -178,6 +212,8 @@ void BufferPoolManager::DeallocatePage(page_id_t page_id) { disk_manager_->DeAll
 
 bool BufferPoolManager::IsPageFree(page_id_t page_id) { return disk_manager_->IsPageFree(page_id); }
 
+bool BufferPoolManager::IsPageResident(page_id_t page_id) { return page_table_.count(page_id) != 0; }
+
 // Only used for debug
 bool BufferPoolManager::CheckAllUnpinned() {
   bool res = true;
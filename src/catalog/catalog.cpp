@@ -117,6 +117,10 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
 }
 
 CatalogManager::~CatalogManager() {
+  // 将索引缓存在内存中的条目写回磁盘
+  for (auto &it : indexes_) {
+    it.second->GetIndex()->Flush();
+  }
   FlushCatalogMetaPage();
   delete heap_;
 }
@@ -127,6 +131,15 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   if (table_names_.count(table_name) != 0) {
     return DB_TABLE_ALREADY_EXIST;
   }
+  // unique列和主键上都会建立索引，键放不下时不能建表
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    if (schema->GetColumn(i)->IsUnique() && IndexMetadata::GetKeySizeFor(schema, {i}) == 0) {
+      return DB_INDEX_KEY_TOO_LONG;
+    }
+  }
+  if (IndexMetadata::GetKeySizeFor(schema, schema->getPrimaryKeys()) == 0) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
   TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, schema, txn, log_manager_, lock_manager_, heap_);
   // 如果schema中主键为空，那么遍历schema，寻找一个unique的属性
   if (schema->getPrimaryKeys().size() == 0) {
@@ -212,7 +225,7 @@ dberr_t CatalogManager::GetTables(vector<TableInfo *> &tables) const {
 
 dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string &index_name,
                                     const std::vector<std::string> &index_keys, Transaction *txn,
-                                    IndexInfo *&index_info) {
+                                    IndexInfo *&index_info, IndexType index_type) {
   // ASSERT(false, "Not Implemented yet");
   auto temp = table_names_.find(table_name);
   if (temp == table_names_.end()) {
@@ -273,7 +286,11 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
       }
     }
   }
-  auto index_meta = IndexMetadata::Create(next_index_id_, index_name, temp->second, keys, heap_);
+  uint32_t key_size = IndexMetadata::GetKeySizeFor(schema, keys);
+  if (key_size == 0) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  auto index_meta = IndexMetadata::Create(next_index_id_, index_name, temp->second, keys, heap_, index_type, key_size);
 
   index_info = IndexInfo::Create(heap_);
   index_info->Init(index_meta, table_info->second, buffer_pool_manager_);
@@ -289,16 +306,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
     (index_names_.find(table_name)->second).emplace(index_name, next_index_id_++);
   }
   //插入表中的数据
-  auto table_heap = table_info->second->GetTableHeap();
-  vector<Field> f;
-  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
-    f.clear();
-    for (auto pos : keys) {
-      f.push_back(*(it->GetField(pos)));
-    }
-    Row row(f);
-    index_info->GetIndex()->InsertEntry(row, it->GetRowId(), nullptr);
-  }
+  BuildIndex(index_info, keys);
   next_index_id_++;
   //将新的index写入磁盘中
   page_id_t new_index_page_id = INVALID_PAGE_ID;
@@ -350,6 +358,21 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
   // 删除对应的记录
   auto table_info = tables_.find(temp->second);
   assert(table_info != tables_.end());
+  // 先删除表上的索引
+  auto table_indexes = index_names_.find(table_name);
+  if (table_indexes != index_names_.end()) {
+    vector<string> index_names;
+    for (auto &it : table_indexes->second) {
+      index_names.push_back(it.first);
+    }
+    for (auto &index_name : index_names) {
+      DropIndex(table_name, index_name);
+    }
+    index_names_.erase(table_name);
+  }
+  // 释放堆表和元信息所占的页
+  table_info->second->GetTableHeap()->FreeHeap();
+  buffer_pool_manager_->DeletePage(catalog_meta_->table_meta_pages_[temp->second]);
   // 改变metapage
   catalog_meta_->table_meta_pages_.erase(temp->second);
   // 修改内存中的map
@@ -368,6 +391,9 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
     return DB_INDEX_NOT_FOUND;
   }
   index_id_t index_id = temp->second.find(index_name)->second;
+  // 释放索引和元信息所占的页
+  indexes_[index_id]->GetIndex()->Destroy();
+  buffer_pool_manager_->DeletePage(catalog_meta_->index_meta_pages_[index_id]);
   heap_->Free(indexes_[index_id]);
   indexes_.erase(index_id);
   (index_names_[table_name]).erase(index_name);
@@ -375,6 +401,29 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
   return FlushCatalogMetaPage();
 }
 
+dberr_t CatalogManager::AnalyzeTable(const string &table_name) {
+  TableInfo *table_info = nullptr;
+  if (GetTable(table_name, table_info) != DB_SUCCESS) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto table_heap = table_info->GetTableHeap();
+  auto statistics = TableStatistics::Build(table_heap, table_info->GetSchema());
+  table_heap->SetCounts(statistics->row_count, statistics->page_count);
+  auto table_meta = table_info->GetTableMeta();
+  table_meta->SetStatistics(std::move(statistics));
+  // 重写表的元信息页
+  page_id_t page_id = catalog_meta_->table_meta_pages_[table_info->GetTableId()];
+  auto table_meta_page = buffer_pool_manager_->FetchPage(page_id);
+  if (table_meta_page == nullptr) {
+    return DB_FAILED;
+  }
+  memset(table_meta_page->GetData(), 0, PAGE_SIZE);
+  table_meta->SerializeTo(table_meta_page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  buffer_pool_manager_->FlushPage(page_id);
+  return DB_SUCCESS;
+}
+
 dberr_t CatalogManager::FlushCatalogMetaPage() const {
   auto CatalogMetaPage = buffer_pool_manager_->FetchPage(CATALOG_META_PAGE_ID);
   assert(CatalogMetaPage != nullptr);
@@ -398,6 +447,10 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
   TableHeap *tableheap = TableHeap::Create(buffer_pool_manager_, table_page->GetFirstPageId(), table_page->GetSchema(),
                                            nullptr, nullptr, heap_);
   table_info->Init(table_page, tableheap);
+  // 分析过的表从统计信息中得到行数与页数
+  if (table_page->GetStatistics() != nullptr) {
+    tableheap->SetCounts(table_page->GetStatistics()->row_count, table_page->GetStatistics()->page_count);
+  }
   tables_.emplace(table_id, table_info);
   buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID, false);
   buffer_pool_manager_->UnpinPage(page_id, false);
@@ -419,6 +472,10 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
   GetTable(index_page->GetTableId(), tableinfo);
   assert(tableinfo != nullptr);
   index_info->Init(index_page, tableinfo, buffer_pool_manager_);
+  // ART索引只在内存中，每次加载时从表中重建
+  if (index_info->GetIndexType() == kIndexART) {
+    BuildIndex(index_info, index_page->GetKeyMapping());
+  }
   indexes_.emplace(index_id, index_info);
   auto temp = index_names_.find(index_info->GetTableInfo()->GetTableName());
   if (temp == index_names_.end()) {
@@ -433,6 +490,19 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
   return DB_SUCCESS;
 }
 
+void CatalogManager::BuildIndex(IndexInfo *index_info, const std::vector<uint32_t> &key_map) {
+  auto table_heap = index_info->GetTableInfo()->GetTableHeap();
+  vector<Field> f;
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+    f.clear();
+    for (auto pos : key_map) {
+      f.push_back(*(it->GetField(pos)));
+    }
+    Row row(f);
+    index_info->GetIndex()->InsertEntry(row, it->GetRowId(), nullptr);
+  }
+}
+
 dberr_t CatalogManager::GetTable(const table_id_t table_id, TableInfo *&table_info) {
   auto temp = tables_.find(table_id);
   if (temp == tables_.end()) {
@@ -1,9 +1,34 @@
 #include "catalog/indexes.h"
 
 IndexMetadata *IndexMetadata::Create(const index_id_t index_id, const string &index_name, const table_id_t table_id,
-                                     const vector<uint32_t> &key_map, MemHeap *heap) {
+                                     const vector<uint32_t> &key_map, MemHeap *heap, IndexType index_type,
+                                     uint32_t key_size) {
   void *buf = heap->Allocate(sizeof(IndexMetadata));
-  return new (buf) IndexMetadata(index_id, index_name, table_id, key_map);
+  if (key_size < MIN_KEY_SIZE || key_size > MAX_KEY_SIZE || (key_size & (key_size - 1)) != 0) {
+    // 旧版本没有记录键长，当时所有索引都使用64字节的键
+    key_size = LEGACY_KEY_SIZE;
+  }
+  return new (buf) IndexMetadata(index_id, index_name, table_id, key_map, index_type, key_size);
+}
+
+uint32_t IndexMetadata::GetKeySizeFor(const Schema *schema, const vector<uint32_t> &key_map) {
+  // 与Row::GetSerializedSize一致：列数 + 空位图 + 各列最大长度
+  uint32_t size = sizeof(uint32_t) + sizeof(uint32_t) * static_cast<uint32_t>(ceil(1.0 * key_map.size() / 8));
+  for (auto column_index : key_map) {
+    auto column = schema->GetColumn(column_index);
+    size += column->GetLength();
+    if (column->GetType() == kTypeChar) {
+      size += sizeof(uint32_t);
+    }
+  }
+  if (size > MAX_KEY_SIZE) {
+    return 0;
+  }
+  uint32_t key_size = MIN_KEY_SIZE;
+  while (key_size < size) {
+    key_size *= 2;
+  }
+  return key_size;
 }
 
 uint32_t IndexMetadata::SerializeTo(char *buf) const {
@@ -42,13 +67,24 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
   move += sizeof(size_key_map);
   // 接下来写入index_key
   memcpy(buf + move, &key_map_[0], sizeof(uint32_t) * size_key_map);
+  move += sizeof(uint32_t) * size_key_map;
+
+  // then write index_type_
+  uint32_t index_type = index_type_;
+  memcpy(buf + move, &index_type, sizeof(index_type));
+  move += sizeof(index_type);
+
+  // finally write key_size_
+  memcpy(buf + move, &key_size_, sizeof(key_size_));
+  move += sizeof(key_size_);
 
   return move;
 }
 
 uint32_t IndexMetadata::GetSerializedSize() const {
-  return sizeof(INDEX_METADATA_MAGIC_NUM) + sizeof(index_id_) + sizeof(size_t) + sizeof(index_name_.size()) +
-         sizeof(table_id_) + sizeof(size_t) + sizeof(uint32_t) * key_map_.size();
+  return sizeof(INDEX_METADATA_MAGIC_NUM) + sizeof(index_id_) + sizeof(size_t) + index_name_.size() +
+         sizeof(table_id_) + sizeof(size_t) + sizeof(uint32_t) * key_map_.size() + sizeof(uint32_t) +
+         sizeof(key_size_);
 }
 
 uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta, MemHeap *heap) {
@@ -94,6 +130,14 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta, M
   move += sizeof(uint32_t) * size_key_map;
   memcpy(&temp_vec[0], arr, sizeof(uint32_t) * size_key_map);
   delete[] arr;
-  index_meta = Create(index_id, temp_str, tid, temp_vec, heap);
+  // get index type, pages written before it was stored hold 0 here
+  uint32_t index_type = kIndexBPlusTree;
+  memcpy(&index_type, buf + move, sizeof(index_type));
+  move += sizeof(index_type);
+  // get key size, pages written before it was stored hold 0 here
+  uint32_t key_size = 0;
+  memcpy(&key_size, buf + move, sizeof(key_size));
+  move += sizeof(key_size);
+  index_meta = Create(index_id, temp_str, tid, temp_vec, heap, static_cast<IndexType>(index_type), key_size);
   return move;
 }
\ No newline at end of file
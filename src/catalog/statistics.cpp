@@ -0,0 +1,366 @@
+#include "catalog/statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "record/compare_kernels.h"
+
+static StatisticsValue ToValue(const Field &field, TypeId type) {
+  StatisticsValue value;
+  if (type == kTypeChar) {
+    value.text.assign(field.GetData(), field.GetCharLength());
+  } else if (type == kTypeInt) {
+    value.number = field.GetIntData();
+  } else {
+    value.number = field.GetFloatData();
+  }
+  return value;
+}
+
+// 与Type的比较一致：char逐字节比较，数值精确比较
+static int CompareValues(const StatisticsValue &lhs, const StatisticsValue &rhs, TypeId type) {
+  if (type == kTypeChar) {
+    return CompareChars(lhs.text.data(), lhs.text.size(), rhs.text.data(), rhs.text.size());
+  }
+  return CompareNumbers(lhs.number, rhs.number);
+}
+
+// 等值比较时float有1e-3的误差
+static bool EqualValues(const StatisticsValue &lhs, const StatisticsValue &rhs, TypeId type) {
+  if (type == kTypeFloat) {
+    return std::fabs(lhs.number - rhs.number) <= 1e-3;
+  }
+  return CompareValues(lhs, rhs, type) == 0;
+}
+
+static uint32_t SerializeValue(const StatisticsValue &value, TypeId type, char *buf) {
+  if (type == kTypeChar) {
+    MACH_WRITE_UINT32(buf, value.text.size());
+    memcpy(buf + sizeof(uint32_t), value.text.data(), value.text.size());
+    return sizeof(uint32_t) + value.text.size();
+  }
+  MACH_WRITE_TO(double, buf, value.number);
+  return sizeof(double);
+}
+
+static uint32_t GetValueSize(const StatisticsValue &value, TypeId type) {
+  return type == kTypeChar ? sizeof(uint32_t) + value.text.size() : sizeof(double);
+}
+
+static uint32_t DeserializeValue(char *buf, TypeId type, StatisticsValue &value) {
+  if (type == kTypeChar) {
+    uint32_t len = MACH_READ_UINT32(buf);
+    value.text.assign(buf + sizeof(uint32_t), len);
+    return sizeof(uint32_t) + len;
+  }
+  value.number = MACH_READ_FROM(double, buf);
+  return sizeof(double);
+}
+
+/*****************************************************************************
+ * COLUMN STATISTICS
+ *****************************************************************************/
+double ColumnStatistics::GetHistogramFraction() const {
+  double fraction = 1 - null_fraction;
+  for (auto mcv_fraction : mcv_fractions) {
+    fraction -= mcv_fraction;
+  }
+  return std::max(fraction, 0.0);
+}
+
+double ColumnStatistics::EstimateEqual(const Field &field) const {
+  if (field.IsNull()) {
+    return 0;
+  }
+  StatisticsValue value = ToValue(field, type);
+  for (size_t i = 0; i < mcv_values.size(); i++) {
+    if (EqualValues(mcv_values[i], value, type)) {
+      return mcv_fractions[i];
+    }
+  }
+  if (bounds.empty()) {
+    return 0;
+  }
+  // 其余的值平分直方图中的行
+  double others = std::max(distinct_count - mcv_values.size(), 1.0);
+  return GetHistogramFraction() / others;
+}
+
+double ColumnStatistics::EstimateLess(const Field &field, bool inclusive) const {
+  if (field.IsNull()) {
+    return 0;
+  }
+  StatisticsValue value = ToValue(field, type);
+  double fraction = 0;
+  for (size_t i = 0; i < mcv_values.size(); i++) {
+    int cmp = CompareValues(mcv_values[i], value, type);
+    if (cmp < 0 || (inclusive && cmp == 0)) {
+      fraction += mcv_fractions[i];
+    }
+  }
+  if (bounds.empty() || CompareValues(value, bounds.front(), type) < 0) {
+    return fraction;
+  }
+  size_t buckets = bounds.size() - 1;
+  if (buckets == 0 || CompareValues(value, bounds.back(), type) > 0) {
+    return fraction + GetHistogramFraction();
+  }
+  // 找到值所在的桶，桶内按线性分布估计
+  size_t k = 0;
+  while (k + 1 < buckets && CompareValues(value, bounds[k + 1], type) > 0) {
+    k++;
+  }
+  const StatisticsValue &low = bounds[k];
+  const StatisticsValue &high = bounds[k + 1];
+  double within = 0.5;
+  if (type != kTypeChar && high.number > low.number) {
+    within = (value.number - low.number) / (high.number - low.number);
+  } else if (CompareValues(low, high, type) == 0) {
+    within = inclusive ? 1 : 0;
+  }
+  return fraction + (k + within) / buckets * GetHistogramFraction();
+}
+
+uint32_t ColumnStatistics::SerializeTo(char *buf) const {
+  char *pos = buf;
+  MACH_WRITE_UINT32(pos, type);
+  pos += sizeof(uint32_t);
+  MACH_WRITE_TO(double, pos, null_fraction);
+  pos += sizeof(double);
+  MACH_WRITE_TO(double, pos, distinct_count);
+  pos += sizeof(double);
+  MACH_WRITE_UINT32(pos, mcv_values.size());
+  pos += sizeof(uint32_t);
+  for (size_t i = 0; i < mcv_values.size(); i++) {
+    pos += SerializeValue(mcv_values[i], type, pos);
+    MACH_WRITE_TO(double, pos, mcv_fractions[i]);
+    pos += sizeof(double);
+  }
+  MACH_WRITE_UINT32(pos, bounds.size());
+  pos += sizeof(uint32_t);
+  for (auto &bound : bounds) {
+    pos += SerializeValue(bound, type, pos);
+  }
+  return pos - buf;
+}
+
+uint32_t ColumnStatistics::GetSerializedSize() const {
+  uint32_t size = 3 * sizeof(uint32_t) + 2 * sizeof(double) + mcv_fractions.size() * sizeof(double);
+  for (auto &value : mcv_values) {
+    size += GetValueSize(value, type);
+  }
+  for (auto &bound : bounds) {
+    size += GetValueSize(bound, type);
+  }
+  return size;
+}
+
+uint32_t ColumnStatistics::DeserializeFrom(char *buf) {
+  char *pos = buf;
+  type = static_cast<TypeId>(MACH_READ_UINT32(pos));
+  pos += sizeof(uint32_t);
+  null_fraction = MACH_READ_FROM(double, pos);
+  pos += sizeof(double);
+  distinct_count = MACH_READ_FROM(double, pos);
+  pos += sizeof(double);
+  uint32_t mcv_count = MACH_READ_UINT32(pos);
+  pos += sizeof(uint32_t);
+  mcv_values.resize(mcv_count);
+  mcv_fractions.resize(mcv_count);
+  for (uint32_t i = 0; i < mcv_count; i++) {
+    pos += DeserializeValue(pos, type, mcv_values[i]);
+    mcv_fractions[i] = MACH_READ_FROM(double, pos);
+    pos += sizeof(double);
+  }
+  uint32_t bound_count = MACH_READ_UINT32(pos);
+  pos += sizeof(uint32_t);
+  bounds.resize(bound_count);
+  for (auto &bound : bounds) {
+    pos += DeserializeValue(pos, type, bound);
+  }
+  return pos - buf;
+}
+
+/*****************************************************************************
+ * TABLE STATISTICS
+ *****************************************************************************/
+/*
+ * Statistics of one column from its values in the sample. The distinct count
+ * is scaled up to the table with the Duj1 estimator of Haas and Stokes,
+ * n * d / (n - f1 + f1 * n / N), where d values were seen in n sampled rows
+ * out of N and f1 of them only once.
+ */
+static ColumnStatistics BuildColumn(std::vector<StatisticsValue> values, TypeId type, size_t sample_rows,
+                                    uint64_t row_count) {
+  ColumnStatistics column;
+  column.type = type;
+  if (sample_rows == 0) {
+    return column;
+  }
+  double n = values.size();
+  column.null_fraction = 1 - n / sample_rows;
+  if (values.empty()) {
+    return column;
+  }
+  std::sort(values.begin(), values.end(), [type](const StatisticsValue &lhs, const StatisticsValue &rhs) {
+    return CompareValues(lhs, rhs, type) < 0;
+  });
+  // 相同的值连在一起，统计每个值出现的次数
+  std::vector<std::pair<size_t, size_t>> groups;  // first position, count
+  for (size_t i = 0; i < values.size(); i++) {
+    if (groups.empty() || CompareValues(values[groups.back().first], values[i], type) != 0) {
+      groups.emplace_back(i, 0);
+    }
+    groups.back().second++;
+  }
+  double d = groups.size();
+  double f1 = std::count_if(groups.begin(), groups.end(), [](auto &group) { return group.second == 1; });
+  double total = row_count * (1 - column.null_fraction);
+  if (n >= total) {
+    column.distinct_count = d;
+  } else {
+    column.distinct_count = std::min(std::max(n * d / (n - f1 + f1 * n / total), d), total);
+  }
+
+  // 值不多时全部作为最常见值，否则只取明显多于平均次数的值
+  std::vector<std::pair<size_t, size_t>> common(groups);
+  std::stable_sort(common.begin(), common.end(), [](auto &lhs, auto &rhs) { return lhs.second > rhs.second; });
+  if (common.size() > static_cast<size_t>(STATISTICS_MCV_COUNT)) {
+    double threshold = std::max(1.25 * n / d, 2.0);
+    common.erase(std::find_if(common.begin(), common.end(), [&](auto &group) { return group.second < threshold; }),
+                 common.end());
+    common.resize(std::min(common.size(), static_cast<size_t>(STATISTICS_MCV_COUNT)));
+  }
+  std::vector<bool> is_common(values.size(), false);
+  for (auto &group : common) {
+    column.mcv_values.push_back(values[group.first]);
+    column.mcv_fractions.push_back(static_cast<double>(group.second) / sample_rows);
+    std::fill(is_common.begin() + group.first, is_common.begin() + group.first + group.second, true);
+  }
+
+  // 其余的值按顺序分成行数相同的桶
+  std::vector<size_t> rest;
+  for (size_t i = 0; i < values.size(); i++) {
+    if (!is_common[i]) {
+      rest.push_back(i);
+    }
+  }
+  if (rest.empty()) {
+    return column;
+  }
+  size_t buckets = std::max<size_t>(std::min<size_t>(STATISTICS_BUCKET_COUNT, rest.size() - 1), 1);
+  for (size_t k = 0; k <= buckets; k++) {
+    column.bounds.push_back(values[rest[k * (rest.size() - 1) / buckets]]);
+  }
+  return column;
+}
+
+std::unique_ptr<TableStatistics> TableStatistics::Build(TableHeap *table_heap, Schema *schema, uint32_t sample_size) {
+  auto statistics = std::make_unique<TableStatistics>();
+  // 页是链表，需要逐页读取，顺便得到准确的行数与页数。只有被抽中的行才解码
+  std::vector<std::unique_ptr<Row>> sample;
+  std::mt19937_64 random(sample_size);
+  uint64_t seen = 0;
+  uint32_t pages = 0;
+  for (page_id_t page_id = table_heap->GetFirstPageId(); page_id != INVALID_PAGE_ID; pages++) {
+    page_id = table_heap->ScanPage(page_id, [&](const RowId &rid, const char *data) {
+      uint64_t slot = seen++;
+      if (slot >= sample_size) {
+        slot = random() % seen;
+        if (slot >= sample_size) {
+          return;
+        }
+      }
+      auto row = std::make_unique<Row>(rid);
+      row->DeserializeFrom(const_cast<char *>(data), schema);
+      if (slot < sample.size()) {
+        sample[slot] = std::move(row);
+      } else {
+        sample.push_back(std::move(row));
+      }
+    });
+  }
+  statistics->row_count = seen;
+  statistics->page_count = std::max(pages, 1u);
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    TypeId type = schema->GetColumn(i)->GetType();
+    std::vector<StatisticsValue> values;
+    values.reserve(sample.size());
+    for (auto &row : sample) {
+      const Field *field = row->GetField(i);
+      if (!field->IsNull()) {
+        values.push_back(ToValue(*field, type));
+      }
+    }
+    statistics->columns.push_back(BuildColumn(std::move(values), type, sample.size(), seen));
+  }
+  return statistics;
+}
+
+void TableStatistics::ShrinkTo(uint32_t size) {
+  while (GetSerializedSize() > size) {
+    auto largest = std::max_element(columns.begin(), columns.end(), [](auto &lhs, auto &rhs) {
+      return lhs.bounds.size() + lhs.mcv_values.size() < rhs.bounds.size() + rhs.mcv_values.size() ||
+             (lhs.bounds.size() + lhs.mcv_values.size() == rhs.bounds.size() + rhs.mcv_values.size() &&
+              lhs.GetSerializedSize() < rhs.GetSerializedSize());
+    });
+    if (largest == columns.end() || (largest->bounds.empty() && largest->mcv_values.empty())) {
+      return;
+    }
+    auto &bounds = largest->bounds;
+    if (bounds.size() > 2) {
+      // 桶数减半，剩下的桶仍然等深
+      size_t buckets = bounds.size() - 1;
+      size_t half = buckets / 2;
+      std::vector<StatisticsValue> kept;
+      for (size_t k = 0; k <= half; k++) {
+        kept.push_back(bounds[k * buckets / half]);
+      }
+      bounds = std::move(kept);
+    } else if (!largest->mcv_values.empty()) {
+      // 最常见值按出现次数从多到少排列，去掉最少的一个
+      largest->mcv_values.pop_back();
+      largest->mcv_fractions.pop_back();
+    } else {
+      bounds.clear();
+    }
+  }
+}
+
+uint32_t TableStatistics::SerializeTo(char *buf) const {
+  char *pos = buf;
+  MACH_WRITE_TO(uint64_t, pos, row_count);
+  pos += sizeof(uint64_t);
+  MACH_WRITE_UINT32(pos, page_count);
+  pos += sizeof(uint32_t);
+  MACH_WRITE_UINT32(pos, columns.size());
+  pos += sizeof(uint32_t);
+  for (auto &column : columns) {
+    pos += column.SerializeTo(pos);
+  }
+  return pos - buf;
+}
+
+uint32_t TableStatistics::GetSerializedSize() const {
+  uint32_t size = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+  for (auto &column : columns) {
+    size += column.GetSerializedSize();
+  }
+  return size;
+}
+
+uint32_t TableStatistics::DeserializeFrom(char *buf, std::unique_ptr<TableStatistics> &statistics) {
+  statistics = std::make_unique<TableStatistics>();
+  char *pos = buf;
+  statistics->row_count = MACH_READ_FROM(uint64_t, pos);
+  pos += sizeof(uint64_t);
+  statistics->page_count = MACH_READ_UINT32(pos);
+  pos += sizeof(uint32_t);
+  uint32_t column_count = MACH_READ_UINT32(pos);
+  pos += sizeof(uint32_t);
+  statistics->columns.resize(column_count);
+  for (auto &column : statistics->columns) {
+    pos += column.DeserializeFrom(pos);
+  }
+  return pos - buf;
+}
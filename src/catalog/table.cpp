@@ -25,11 +25,32 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
 
   ASSERT(schema_ != nullptr, "schema to be serialize cannot be nullptr");
   move += schema_->SerializeTo(buf + move);
+
+  if (statistics_ != nullptr) {
+    MACH_WRITE_UINT32(buf + move, TABLE_STATISTICS_MAGIC_NUM);
+    move += sizeof(uint32_t);
+    move += statistics_->SerializeTo(buf + move);
+  }
   return move;
 }
 
 uint32_t TableMetadata::GetSerializedSize() const {
-  return sizeof(uint32_t) + sizeof(table_id_) + sizeof(size_t) + table_name_.size() + schema_->GetSerializedSize();
+  uint32_t size = sizeof(uint32_t) + sizeof(table_id_) + sizeof(size_t) + table_name_.size() + sizeof(root_page_id_) +
+                  schema_->GetSerializedSize();
+  if (statistics_ != nullptr) {
+    size += sizeof(uint32_t) + statistics_->GetSerializedSize();
+  }
+  return size;
+}
+
+void TableMetadata::SetStatistics(std::unique_ptr<TableStatistics> statistics) {
+  statistics_ = nullptr;
+  uint32_t base_size = GetSerializedSize() + sizeof(uint32_t);
+  ASSERT(base_size <= PAGE_SIZE, "table metadata exceeds its page");
+  statistics->ShrinkTo(PAGE_SIZE - base_size);
+  if (statistics->GetSerializedSize() <= PAGE_SIZE - base_size) {
+    statistics_ = std::move(statistics);
+  }
 }
 
 /**
@@ -71,6 +92,12 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta, M
   Schema *schema = nullptr;
   move += Schema::DeserializeFrom(buf + move, schema, heap);
   table_meta = Create(tid, temp_str, root_page_id, schema, heap);
+
+  // 页的其余部分为0，有标记时才有统计信息
+  if (move + sizeof(uint32_t) <= PAGE_SIZE && MACH_READ_UINT32(buf + move) == TABLE_STATISTICS_MAGIC_NUM) {
+    move += sizeof(uint32_t);
+    move += TableStatistics::DeserializeFrom(buf + move, table_meta->statistics_);
+  }
   return move;
 }
 
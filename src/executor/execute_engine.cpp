@@ -65,6 +65,8 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast, ExecuteContext *context) {
       return ExecuteExecfile(ast, context);
     case kNodeQuit:
       return ExecuteQuit(ast, context);
+    case kNodeAnalyze:
+      return ExecuteAnalyze(ast, context);
     default:
       break;
   }
@@ -221,16 +223,16 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
     //    Column(std::string column_name, TypeId type, uint32_t length, uint32_t index, bool nullable, bool unique);
     Column *new_column{nullptr};
     string column_name = begin_pos->child_->val_;
-    // 只支持float 和 string，（输入的int全部被转换为float)
     string type = begin_pos->child_->next_->val_;
     if ((strcmp(type.c_str(), int_) == 0) || (strcmp(type.c_str(), float_) == 0)) {
+      TypeId type_id = strcmp(type.c_str(), int_) == 0 ? kTypeInt : kTypeFloat;
       // 根据ycj助教的要求，只需要在unique和主键上实现not null
       if (begin_pos->val_ && !strcmp(begin_pos->val_, "unique")) {
         // unique
-        new_column = new Column(column_name, kTypeFloat, index++, false, true);
+        new_column = new Column(column_name, type_id, index++, false, true);
       } else {
         // not unique
-        new_column = new Column(column_name, kTypeFloat, index++, true, false);
+        new_column = new Column(column_name, type_id, index++, true, false);
       }
     } else {
       // char
@@ -315,6 +317,20 @@ dberr_t ExecuteEngine::ExecuteShowIndexes(pSyntaxNode ast, ExecuteContext *conte
     for_each(index_info.begin(), index_info.end(),
              [&](IndexInfo *it) -> void { std::cout << it->GetIndexName() << " "; });
     puts("");
+    // b+树索引额外输出叶子页数和填充率，前缀压缩的b+树按字节计算填充率
+    for (auto index : index_info) {
+      BPlusTreeStatistics stats;
+      if (index->GetIndexType() == kIndexBPlusTree) {
+        index->VisitBPlusTreeIndex([&](auto *tree) { stats = tree->GetStatistics(); });
+      } else if (index->GetIndexType() == kIndexPrefixBPlusTree) {
+        stats = static_cast<PrefixBPlusTreeIndex *>(index->GetIndex())->GetStatistics();
+      } else {
+        continue;
+      }
+      printf("\t%s: height %d, %zu leaf pages, %zu entries, leaf fill %.1f%%, internal fill %.1f%%\n",
+             index->GetIndexName().c_str(), stats.height, stats.leaf_pages, stats.entries,
+             stats.leaf_fill_factor * 100, stats.internal_fill_factor * 100);
+    }
   }
   return DB_SUCCESS;
 }
@@ -339,7 +355,26 @@ dberr_t ExecuteEngine::ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *conte
     index_names.emplace_back(begin->val_);
     begin = begin->next_;
   }
-  auto result = catalog_manager->CreateIndex(table_name, index_name, index_names, nullptr, temp);
+  // optional "using <type>" clause
+  IndexType index_type = kIndexBPlusTree;
+  pSyntaxNode type_node = ast->child_->next_->next_->next_;
+  if (type_node != nullptr && type_node->type_ == kNodeIndexType) {
+    string type_name = type_node->child_->val_;
+    std::transform(type_name.begin(), type_name.end(), type_name.begin(), ::tolower);
+    if (type_name == "hash") {
+      index_type = kIndexHash;
+    } else if (type_name == "lsm") {
+      index_type = kIndexLSM;
+    } else if (type_name == "art") {
+      index_type = kIndexART;
+    } else if (type_name == "prefix") {
+      index_type = kIndexPrefixBPlusTree;
+    } else if (type_name != "btree" && type_name != "bplustree") {
+      std::cout << "unknown index type " << type_name << std::endl;
+      return DB_FAILED;
+    }
+  }
+  auto result = catalog_manager->CreateIndex(table_name, index_name, index_names, nullptr, temp, index_type);
   return result;
 }
 
@@ -374,483 +409,351 @@ dberr_t ExecuteEngine::ExecuteDropIndex(pSyntaxNode ast, ExecuteContext *context
   }
   return DB_SUCCESS;
 }
-dberr_t ExecuteEngine::get_columns_by_condition(pSyntaxNode condition_node, vector<RowId> &result_vec,
-                                                CatalogManager *catalog_manager, string &table_name) {
-  dberr_t result = DB_FAILED;
-  TableInfo *table_info{nullptr};
-  bool empty = false;
-  // 获得表信息
-  result = catalog_manager->GetTable(table_name, table_info);
+dberr_t ExecuteEngine::BuildScan(pSyntaxNode condition_node, TableInfo *table_info, CatalogManager *catalog_manager,
+                                 ConditionList &conditions, std::unique_ptr<Operator> &scan) {
+  auto table_heap = table_info->GetTableHeap();
+  if (condition_node == nullptr) {
+    // select * from xxx，无条件
+    scan = std::make_unique<SeqScanOperator>(table_heap);
+    return DB_SUCCESS;
+  }
+  ParseConditions(condition_node, conditions);
+  dberr_t result = BindConditions(conditions, table_info->GetSchema());
   if (result != DB_SUCCESS) {
     return result;
   }
+  return BuildAccessPath(table_info, catalog_manager, conditions, scan);
+}
 
-  if (condition_node) {
-    vector<char *> compare(0);                            // 存储compare指令，如not
-    vector<char *> connector;                             // 存储连接指令，如and
-    vector<tuple<string, char *, SyntaxNodeType>> pairs;  // 存储比较的列名和其对应的的值和类型，如id,12,kNodeNumber
-    auto begin_condition = condition_node->child_;
-    bool tag = true;
-    // 从语法树来看，应该不断向左下遍历
-    while (begin_condition->type_ != kNodeCompareOperator) {
-      connector.push_back(begin_condition->val_);
-      auto temp = begin_condition->child_;
-      compare.push_back(temp->next_->val_);
-      pairs.emplace_back(temp->next_->child_->val_, temp->next_->child_->next_->val_,
-                         temp->next_->child_->next_->type_);
-      if (temp->next_->child_->next_->type_ == kNodeNull) {
-        tag = false;
+dberr_t ExecuteEngine::BuildAccessPath(TableInfo *table_info, CatalogManager *catalog_manager,
+                                       ConditionList &conditions, std::unique_ptr<Operator> &scan) {
+  auto table_heap = table_info->GetTableHeap();
+  /// 按代价在顺序扫描与索引之间选择
+  vector<IndexInfo *> indexes(0);
+  catalog_manager->GetTableIndexes(table_info->GetTableName(), indexes);
+  AccessPath path = Planner(table_info, indexes).ChooseAccessPath(conditions);
+  vector<Row> keys;
+  if (path.empty) {
+    // 条件不可能成立，输出空结果
+    scan = std::make_unique<IndexScanOperator>(nullptr, table_heap, std::move(keys));
+    return DB_SUCCESS;
+  }
+  if (path.range) {
+    // 按上下界扫描索引，严格的不等式也在取回的行上再检查一次
+    std::unique_ptr<Row> bounds[2];
+    int conditions_of_bounds[2] = {path.low_condition, path.high_condition};
+    for (int k = 0; k < 2; k++) {
+      if (conditions_of_bounds[k] >= 0) {
+        vector<Field> fields;
+        fields.push_back(conditions.to_be_compared[conditions_of_bounds[k]]);
+        bounds[k] = std::make_unique<Row>(fields);
+      }
+    }
+    scan = std::make_unique<FilterOperator>(
+        std::make_unique<IndexScanOperator>(path.index->GetIndex(), table_heap, std::move(bounds[0]),
+                                            std::move(bounds[1])),
+        [&conditions](const Row &row) { return conditions.predicate->Evaluate(row); });
+    return DB_SUCCESS;
+  }
+  if (path.index != nullptr) {
+    // 构造查询用的row，键与列的类型相同。in-list的每个常量各是一个键
+    vector<bool> used(conditions.pairs.size(), false);
+    vector<Field> fields;
+    for (auto i : path.key_conditions) {
+      used[i] = true;
+      fields.push_back(conditions.to_be_compared[i]);
+      if (path.in_list) {
+        keys.emplace_back(fields);
+        fields.clear();
       }
-      begin_condition = begin_condition->child_;
     }
-    // 最后一个条件
-    compare.push_back(begin_condition->val_);
-    pairs.emplace_back(begin_condition->child_->val_, begin_condition->child_->next_->val_,
-                       begin_condition->child_->next_->type_);
+    if (!path.in_list) {
+      keys.emplace_back(fields);
+    }
+    scan = std::make_unique<IndexScanOperator>(path.index->GetIndex(), table_heap, std::move(keys));
+    if (path.in_list) {
+      return DB_SUCCESS;
+    }
+    // 其余的条件在取回的行上过滤
+    std::shared_ptr<Predicate> residual = CompilePredicate(conditions, table_info->GetSchema(), used);
+    if (residual != nullptr) {
+      scan = std::make_unique<FilterOperator>(std::move(scan),
+                                              [residual](const Row &row) { return residual->Evaluate(row); });
+    }
+    return DB_SUCCESS;
+  }
+  // 无索引查询，直接遍历
+  scan = std::make_unique<FilterOperator>(std::make_unique<SeqScanOperator>(table_heap), [&conditions](const Row &row) {
+    return conditions.predicate->Evaluate(row);
+  });
+  return DB_SUCCESS;
+}
 
-    /// 查看能否使用索引（只支持等值查询）
-    vector<IndexInfo *> indexes(0);
-    result = catalog_manager->GetTableIndexes(table_name, indexes);
-    // 只支持相等，and
-    for (uint32_t i = 0; tag && i < compare.size(); i++) {
-      tag = (strcmp(compare[i], "=") == 0);
-    }
-    for (uint32_t i = 0; tag && i < connector.size(); i++) {
-      tag = (strcmp(connector[i], "and") == 0);
-    }
-    if (tag && result == DB_SUCCESS) {
-      // 可能有索引
-      // 那么先查看有无索引
-      // 获得所使用的列的名字
-      std::map<std::string, int> mymap;
-      std::string index_name;
-      for (uint32_t i = 0; i < pairs.size(); i++) {
-        auto temp = mymap.emplace(get<0>(pairs[i]), i);
-        if (!temp.second) {
-          //重复键值，检查值是否相等
-          if (strcmp(get<1>(pairs[temp.first->second]), get<1>(pairs[i])) != 0) {
-            // 同样的键，但是值不同，输出空结果并返回
-            empty = true;
-            break;
-          }
-        }
+void ExecuteEngine::ParseConditions(pSyntaxNode condition_node, ConditionList &conditions) {
+  auto begin_condition = condition_node->child_;
+  // 从语法树来看，应该不断向左下遍历
+  while (begin_condition->type_ != kNodeCompareOperator) {
+    conditions.connector.push_back(begin_condition->val_);
+    auto temp = begin_condition->child_;
+    conditions.compare.push_back(temp->next_->val_);
+    conditions.pairs.emplace_back(temp->next_->child_->val_, temp->next_->child_->next_->val_,
+                                  temp->next_->child_->next_->type_);
+    begin_condition = begin_condition->child_;
+  }
+  // 最后一个条件
+  conditions.compare.push_back(begin_condition->val_);
+  conditions.pairs.emplace_back(begin_condition->child_->val_, begin_condition->child_->next_->val_,
+                                begin_condition->child_->next_->type_);
+}
+
+// 整数常量，带小数或超出int范围时返回false
+static bool ParseInteger(const char *text, int32_t &value) {
+  char *end;
+  long long integer = strtoll(text, &end, 10);
+  if (*end != '\0') {
+    double number = strtod(text, &end);
+    if (*end != '\0' || number != floor(number) || fabs(number) > INT32_MAX) {
+      return false;
+    }
+    integer = static_cast<long long>(number);
+  }
+  if (integer < INT32_MIN || integer > INT32_MAX) {
+    return false;
+  }
+  value = static_cast<int32_t>(integer);
+  return true;
+}
+
+// 整数列与带小数或超出int范围的常量比较，改写成与整数的比较：id < 2.5即id <= 2，
+// id <> 2.5对非null的值总是成立。返回false时没有满足的行
+static bool RoundIntegerBound(const char *text, CompareOp &op, int32_t &value) {
+  double number = strtod(text, nullptr);
+  switch (op) {
+    case CompareOp::kEqual:
+      return false;
+    case CompareOp::kNotEqual:
+    case CompareOp::kNotNull:
+      op = CompareOp::kNotNull;
+      return true;
+    case CompareOp::kLess:
+    case CompareOp::kLessEqual:
+      if (floor(number) < INT32_MIN) {
+        return false;
       }
-      if (!empty && mymap.size() == 1) {
-        // 查看是否存在对应索引（必须全部相等）
-        auto judge = find_if(indexes.begin(), indexes.end(),
-                             [&](IndexInfo *it) -> bool { return it->GetIndexKeySchema()->AllEqual(mymap); });
-        if (judge != indexes.end()) {
-          // 拿到索引名
-          index_name = static_cast<IndexInfo *>(*judge)->GetIndexName();
-          IndexInfo *index_info{nullptr};
-          // 构造查询用的row
-          vector<Field> fields;
+      op = CompareOp::kLessEqual;
+      value = static_cast<int32_t>(std::min<double>(floor(number), INT32_MAX));
+      return true;
+    default:
+      if (ceil(number) > INT32_MAX) {
+        return false;
+      }
+      op = CompareOp::kGreaterEqual;
+      value = static_cast<int32_t>(std::max<double>(ceil(number), INT32_MIN));
+      return true;
+  }
+}
 
-          for (auto &it : mymap) {
-            Field *new_field{nullptr};
-            if (get<2>(pairs[it.second]) == kNodeNumber) {
-              // float
-              new_field = new Field(kTypeFloat, (float)(atof(get<1>(pairs[it.second]))));
-            } else if (get<2>(pairs[it.second]) == kNodeNull) {
-              // null
-              new_field = new Field(kTypeChar, nullptr, 0, false);
-            } else {
-              // char
-              auto temp_char = get<1>(pairs[it.second]);
-              new_field = new Field(kTypeChar, temp_char, strlen(temp_char), true);
-            }
-            fields.push_back(*new_field);
-            delete new_field;
-          }
-          Row row(fields);
-          result = catalog_manager->GetIndex(table_name, index_name, index_info);
-          result = index_info->GetIndex()->ScanKey(row, result_vec, nullptr);
-        } else {
-          // 无索引查询
-          // 直接遍历
-          // 获取schema
-          auto schema = table_info->GetSchema();
-          // 初始化需要的field，方便后续比较
-          vector<Field> to_be_compared;
-          to_be_compared.reserve(pairs.size());
-          for (uint32_t i = 0; i < pairs.size(); i++) {
-            // tuple<string, char *, SyntaxNodeType>
-            auto cur_type = get<2>(pairs[i]);
-            if (cur_type == kNodeNumber) {
-              to_be_compared.emplace_back(kTypeFloat, (float)(atof(get<1>(pairs[i]))));
-            } else if (cur_type == kNodeString) {
-              auto temp = get<1>(pairs[i]);
-              to_be_compared.emplace_back(kTypeChar, temp, strlen(temp), true);
-            } else {
-              // null
-              to_be_compared.emplace_back(kTypeChar, nullptr, 0, false);
-            }
-          }
-          for (auto it = table_info->GetTableHeap()->Begin(nullptr); it != table_info->GetTableHeap()->End(); it++) {
-            deque<bool> single_result;  // 每一个比较的结果
-            // 从下往上遍历
-            for (int i = static_cast<int>(pairs.size()) - 1; i >= 0; i--) {
-              auto temp_ = pairs[i];
-              uint32_t pos = -1;
-              bool single = false;
-              result = schema->GetColumnIndex(get<0>(temp_), pos);
-              if (result != DB_SUCCESS) {
-                return result;
-              }
-              // 获取表中的实际值
-              TypeFloat tf;
-              TypeChar tc;
-              auto field = it->GetField(pos);
-              if (!strcmp(compare[i], "=")) {
-                //相等比较
-                auto type = get<2>(temp_);
-                if (type == kNodeNumber) {
-                  if (tf.CompareEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                } else {
-                  if (tc.CompareEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                }
-              } else if (!strcmp(compare[i], "<>")) {
-                //相等比较
-                auto type = get<2>(temp_);
-                if (type == kNodeNumber) {
-                  if (!tf.CompareEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                } else {
-                  if (!tc.CompareEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                }
-              } else if (!strcmp(compare[i], "<")) {
-                //相等比较
-                auto type = get<2>(temp_);
-                if (type == kNodeNumber) {
-                  if (tf.CompareLessThan(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                } else {
-                  if (tc.CompareLessThan(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                }
-              } else if (!strcmp(compare[i], "<=")) {
-                //相等比较
-                auto type = get<2>(temp_);
-                if (type == kNodeNumber) {
-                  if (tf.CompareLessThanEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                } else {
-                  if (tc.CompareLessThanEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                }
-              } else if (!strcmp(compare[i], ">")) {
-                auto type = get<2>(temp_);
-                if (type == kNodeNumber) {
-                  if (tf.CompareGreaterThan(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                } else {
-                  if (tc.CompareGreaterThan(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                }
-              } else if (!strcmp(compare[i], ">=")) {
-                auto type = get<2>(temp_);
-                if (type == kNodeNumber) {
-                  if (tf.CompareGreaterThanEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                } else {
-                  if (tc.CompareGreaterThanEquals(*field, to_be_compared[i])) {
-                    single = true;
-                  }
-                }
-              } else if (!strcmp(compare[i], "is")) {
-                single = field->IsNull();
-              } else if (!strcmp(compare[i], "not")) {
-                single = !field->IsNull();
-              }
-              single_result.push_back(single);
-            }
-            bool satisfy = single_result[0];
-            for (uint32_t i = 1; i < single_result.size(); i++) {
-              if (!strcmp(connector[connector.size() - i], "and")) {
-                satisfy = satisfy && single_result[i];
-              } else {
-                satisfy = satisfy || single_result[i];
-              }
-            }
-            if (satisfy) {
-              result_vec.push_back(it->GetRowId());
-            }
-          }
-        }
+// 按列的类型构造常量，整数直接存为int，不经过float
+static dberr_t BindLiteral(char *text, SyntaxNodeType node_type, TypeId type, vector<Field> &fields) {
+  int32_t integer;
+  if (node_type == kNodeNull) {
+    fields.emplace_back(type);
+  } else if (node_type == kNodeNumber && type == kTypeInt && ParseInteger(text, integer)) {
+    fields.emplace_back(kTypeInt, integer);
+  } else if (node_type == kNodeNumber && type == kTypeFloat) {
+    fields.emplace_back(kTypeFloat, static_cast<float>(atof(text)));
+  } else if (node_type == kNodeString && type == kTypeChar) {
+    fields.emplace_back(kTypeChar, text, strlen(text), true);
+  } else {
+    return DB_TYPE_MISMATCH;
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::BindConditions(ConditionList &conditions, Schema *schema) {
+  conditions.column_index.resize(conditions.pairs.size());
+  conditions.to_be_compared.clear();
+  conditions.to_be_compared.reserve(conditions.pairs.size());
+  for (uint32_t i = 0; i < conditions.pairs.size(); i++) {
+    auto &pair = conditions.pairs[i];
+    if (get<2>(pair) == kNodeIdentifier) {
+      // 两列之间的比较只在连接查询中处理
+      return DB_FAILED;
+    }
+    dberr_t result = schema->GetColumnIndex(get<0>(pair), conditions.column_index[i]);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+    // 常量转换为列的类型，不能转换时用null代替，没有满足条件的行
+    TypeId column_type = schema->GetColumn(conditions.column_index[i])->GetType();
+    if (BindLiteral(get<1>(pair), get<2>(pair), column_type, conditions.to_be_compared) == DB_SUCCESS) {
+      continue;
+    }
+    CompareOp op = ParseCompareOp(conditions.compare[i]);
+    int32_t integer;
+    if (get<2>(pair) == kNodeNumber && column_type == kTypeInt && RoundIntegerBound(get<1>(pair), op, integer)) {
+      // 改写后规划器按整数的范围估计与选择索引
+      static char kLessEqual[] = "<=";
+      static char kGreaterEqual[] = ">=";
+      static char kNotNull[] = "not";
+      if (op == CompareOp::kNotNull) {
+        conditions.compare[i] = kNotNull;
+        conditions.to_be_compared.emplace_back(column_type);
       } else {
-        // 无索引查询
-        // 直接遍历
-        // 获取schema
-        auto schema = table_info->GetSchema();
-        // 初始化需要的field，方便后续比较
-        vector<Field> to_be_compared;
-        to_be_compared.reserve(pairs.size());
-        for (uint32_t i = 0; i < pairs.size(); i++) {
-          // tuple<string, char *, SyntaxNodeType>
-          auto cur_type = get<2>(pairs[i]);
-          if (cur_type == kNodeNumber) {
-            to_be_compared.emplace_back(kTypeFloat, (float)(atof(get<1>(pairs[i]))));
-          } else if (cur_type == kNodeString) {
-            auto temp = get<1>(pairs[i]);
-            to_be_compared.emplace_back(kTypeChar, temp, strlen(temp), true);
-          } else {
-            // null
-            to_be_compared.emplace_back(kTypeChar, nullptr, 0, false);
-          }
-        }
-        for (auto it = table_info->GetTableHeap()->Begin(nullptr); it != table_info->GetTableHeap()->End(); it++) {
-          deque<bool> single_result;  // 每一个比较的结果
-          // 从下往上遍历
-          for (int i = static_cast<int>(pairs.size()) - 1; i >= 0; i--) {
-            auto temp_ = pairs[i];
-            uint32_t pos = -1;
-            bool single = false;
-            result = schema->GetColumnIndex(get<0>(temp_), pos);
-            if (result != DB_SUCCESS) {
-              return result;
-            }
-            // 获取表中的实际值
-            TypeFloat tf;
-            TypeChar tc;
-            auto field = it->GetField(pos);
-            if (!strcmp(compare[i], "=")) {
-              //相等比较
-              auto type = get<2>(temp_);
-              if (type == kNodeNumber) {
-                if (tf.CompareEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              } else {
-                if (tc.CompareEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              }
-            } else if (!strcmp(compare[i], "<>")) {
-              //相等比较
-              auto type = get<2>(temp_);
-              if (type == kNodeNumber) {
-                if (!tf.CompareEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              } else {
-                if (!tc.CompareEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              }
-            } else if (!strcmp(compare[i], "<")) {
-              //相等比较
-              auto type = get<2>(temp_);
-              if (type == kNodeNumber) {
-                if (tf.CompareLessThan(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              } else {
-                if (tc.CompareLessThan(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              }
-            } else if (!strcmp(compare[i], "<=")) {
-              //相等比较
-              auto type = get<2>(temp_);
-              if (type == kNodeNumber) {
-                if (tf.CompareLessThanEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              } else {
-                if (tc.CompareLessThanEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              }
-            } else if (!strcmp(compare[i], ">")) {
-              auto type = get<2>(temp_);
-              if (type == kNodeNumber) {
-                if (tf.CompareGreaterThan(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              } else {
-                if (tc.CompareGreaterThan(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              }
-            } else if (!strcmp(compare[i], ">=")) {
-              auto type = get<2>(temp_);
-              if (type == kNodeNumber) {
-                if (tf.CompareGreaterThanEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              } else {
-                if (tc.CompareGreaterThanEquals(*field, to_be_compared[i])) {
-                  single = true;
-                }
-              }
-            } else if (!strcmp(compare[i], "is")) {
-              single = field->IsNull();
-            } else if (!strcmp(compare[i], "not")) {
-              single = !field->IsNull();
-            }
-            single_result.push_back(single);
-          }
-          bool satisfy = single_result[0];
-          for (uint32_t i = 1; i < single_result.size(); i++) {
-            if (!strcmp(connector[connector.size() - i], "and")) {
-              satisfy = satisfy && single_result[i];
-            } else {
-              satisfy = satisfy || single_result[i];
-            }
-          }
-          if (satisfy) {
-            result_vec.push_back(it->GetRowId());
-          }
-        }
+        conditions.compare[i] = op == CompareOp::kLessEqual ? kLessEqual : kGreaterEqual;
+        conditions.to_be_compared.emplace_back(kTypeInt, integer);
       }
-    } else {
-      // 无索引查询
-      // 直接遍历
-      // 获取schema
-      auto schema = table_info->GetSchema();
-      // 初始化需要的field，方便后续比较
-      vector<Field> to_be_compared;
-      to_be_compared.reserve(pairs.size());
-      for (uint32_t i = 0; i < pairs.size(); i++) {
-        // tuple<string, char *, SyntaxNodeType>
-        auto cur_type = get<2>(pairs[i]);
-        if (cur_type == kNodeNumber) {
-          to_be_compared.emplace_back(kTypeFloat, (float)(atof(get<1>(pairs[i]))));
-        } else if (cur_type == kNodeString) {
-          auto temp = get<1>(pairs[i]);
-          to_be_compared.emplace_back(kTypeChar, temp, strlen(temp), true);
-        } else {
-          // null
-          to_be_compared.emplace_back(kTypeChar, nullptr, 0, false);
-        }
+      continue;
+    }
+    conditions.to_be_compared.emplace_back(column_type);
+  }
+  // 编译成谓词树：列号、比较运算与常量的类型都在这里确定，逐行求值时不再有字符串操作
+  conditions.predicate = CompilePredicate(conditions, schema, {});
+  return DB_SUCCESS;
+}
+
+std::unique_ptr<Predicate> ExecuteEngine::CompilePredicate(const ConditionList &conditions, Schema *schema,
+                                                           const vector<bool> &skip) {
+  std::unique_ptr<Predicate> predicate;
+  for (int i = static_cast<int>(conditions.pairs.size()) - 1; i >= 0; i--) {
+    if (!skip.empty() && skip[i]) {
+      continue;
+    }
+    uint32_t column = conditions.column_index[i];
+    CompareOp op = ParseCompareOp(conditions.compare[i]);
+    auto literal = get<1>(conditions.pairs[i]);
+    auto literal_type = get<2>(conditions.pairs[i]);
+    TypeId column_type = schema->GetColumn(column)->GetType();
+    bool is_char = column_type == kTypeChar;
+    std::unique_ptr<Predicate> single;
+    int32_t integer;
+    if (op == CompareOp::kIsNull || op == CompareOp::kNotNull) {
+      single = Predicate::MakeNullTest(column, op == CompareOp::kIsNull);
+    } else if (!conditions.compared_column.empty() && conditions.compared_column[i] >= 0) {
+      uint32_t other = conditions.compared_column[i];
+      single = Predicate::MakeColumnCompare(column, column_type, other, schema->GetColumn(other)->GetType(), op);
+    } else if (literal_type == kNodeNumber && column_type == kTypeInt && ParseInteger(literal, integer)) {
+      single = Predicate::MakeIntCompare(column, op, integer);
+    } else if (literal_type == kNodeNumber && column_type == kTypeInt) {
+      if (!RoundIntegerBound(literal, op, integer)) {
+        single = Predicate::MakeFalse();
+      } else if (op == CompareOp::kNotNull) {
+        single = Predicate::MakeNullTest(column, false);
+      } else {
+        single = Predicate::MakeIntCompare(column, op, integer);
       }
-      for (auto it = table_info->GetTableHeap()->Begin(nullptr); it != table_info->GetTableHeap()->End(); it++) {
-        deque<bool> single_result;  // 每一个比较的结果
-        // 从下往上遍历
-        for (int i = static_cast<int>(pairs.size()) - 1; i >= 0; i--) {
-          auto temp_ = pairs[i];
-          uint32_t pos = -1;
-          bool single = false;
-          result = schema->GetColumnIndex(get<0>(temp_), pos);
-          if (result != DB_SUCCESS) {
-            return result;
-          }
-          // 获取表中的实际值
-          TypeFloat tf;
-          TypeChar tc;
-          auto field = it->GetField(pos);
-          if (!strcmp(compare[i], "=")) {
-            //相等比较
-            auto type = get<2>(temp_);
-            if (type == kNodeNumber) {
-              if (tf.CompareEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            } else {
-              if (tc.CompareEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            }
-          } else if (!strcmp(compare[i], "<>")) {
-            //相等比较
-            auto type = get<2>(temp_);
-            if (type == kNodeNumber) {
-              if (!tf.CompareEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            } else {
-              if (!tc.CompareEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            }
-          } else if (!strcmp(compare[i], "<")) {
-            //相等比较
-            auto type = get<2>(temp_);
-            if (type == kNodeNumber) {
-              if (tf.CompareLessThan(*field, to_be_compared[i])) {
-                single = true;
-              }
-            } else {
-              if (tc.CompareLessThan(*field, to_be_compared[i])) {
-                single = true;
-              }
-            }
-          } else if (!strcmp(compare[i], "<=")) {
-            //相等比较
-            auto type = get<2>(temp_);
-            if (type == kNodeNumber) {
-              if (tf.CompareLessThanEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            } else {
-              if (tc.CompareLessThanEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            }
-          } else if (!strcmp(compare[i], ">")) {
-            auto type = get<2>(temp_);
-            if (type == kNodeNumber) {
-              if (tf.CompareGreaterThan(*field, to_be_compared[i])) {
-                single = true;
-              }
-            } else {
-              if (tc.CompareGreaterThan(*field, to_be_compared[i])) {
-                single = true;
-              }
-            }
-          } else if (!strcmp(compare[i], ">=")) {
-            auto type = get<2>(temp_);
-            if (type == kNodeNumber) {
-              if (tf.CompareGreaterThanEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            } else {
-              if (tc.CompareGreaterThanEquals(*field, to_be_compared[i])) {
-                single = true;
-              }
-            }
-          } else if (!strcmp(compare[i], "is")) {
-            single = field->IsNull();
-          } else if (!strcmp(compare[i], "not")) {
-            single = !field->IsNull();
-          }
-          single_result.push_back(single);
-        }
-        bool satisfy = single_result[0];
-        for (uint32_t i = 1; i < single_result.size(); i++) {
-          if (!strcmp(connector[connector.size() - i], "and")) {
-            satisfy = satisfy && single_result[i];
-          } else {
-            satisfy = satisfy || single_result[i];
-          }
-        }
-        if (satisfy) {
-          result_vec.push_back(it->GetRowId());
-        }
+    } else if (literal_type == kNodeNumber && !is_char) {
+      single = Predicate::MakeNumberCompare(column, column_type, op, static_cast<float>(atof(literal)));
+    } else if (literal_type == kNodeString && is_char) {
+      single = Predicate::MakeTextCompare(column, op, literal);
+    } else {
+      // 与null比较，或者类型不匹配，结果总是false
+      single = Predicate::MakeFalse();
+    }
+    if (predicate == nullptr) {
+      predicate = std::move(single);
+    } else if (!strcmp(conditions.connector[i], "and")) {
+      predicate = Predicate::MakeAnd(std::move(predicate), std::move(single));
+    } else {
+      predicate = Predicate::MakeOr(std::move(predicate), std::move(single));
+    }
+  }
+  return predicate;
+}
+
+// 是否引用了带表名的列，或者比较了两列，这样的查询按连接处理
+static bool HasColumnReference(pSyntaxNode node) {
+  for (; node != nullptr; node = node->next_) {
+    if (node->type_ == kNodeIdentifier && strchr(node->val_, '.') != nullptr) {
+      return true;
+    }
+    if (node->type_ == kNodeCompareOperator && node->child_->next_->type_ == kNodeIdentifier) {
+      return true;
+    }
+    if (HasColumnReference(node->child_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 是否有group by或者聚集函数，这样的查询在连接之后聚集
+static bool HasAggregation(pSyntaxNode ast) {
+  for (auto node = ast->child_; node != nullptr; node = node->next_) {
+    if (node->type_ == kNodeGroupBy) {
+      return true;
+    }
+  }
+  if (ast->child_->type_ == kNodeAllColumns) {
+    return false;
+  }
+  for (auto node = ast->child_->child_; node != nullptr; node = node->next_) {
+    if (node->type_ == kNodeAggregate) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 单表上不分组、只选聚集函数的查询，可以在按列成批的扫描上直接聚集
+static bool IsPlainAggregate(pSyntaxNode ast) {
+  for (auto node = ast->child_; node != nullptr; node = node->next_) {
+    if (node->type_ == kNodeGroupBy) {
+      return false;
+    }
+  }
+  if (ast->child_->type_ == kNodeAllColumns) {
+    return false;
+  }
+  for (auto node = ast->child_->child_; node != nullptr; node = node->next_) {
+    if (node->type_ != kNodeAggregate) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static const std::pair<const char *, AggregateType> kAggregateFunctions[] = {{"count", AggregateType::kCount},
+                                                                             {"sum", AggregateType::kSum},
+                                                                             {"avg", AggregateType::kAvg},
+                                                                             {"min", AggregateType::kMin},
+                                                                             {"max", AggregateType::kMax}};
+
+// 聚集函数的名字，不区分大小写
+static const std::pair<const char *, AggregateType> *FindAggregateFunction(const char *name) {
+  auto function = std::find_if(std::begin(kAggregateFunctions), std::end(kAggregateFunctions),
+                               [name](auto &function) { return !strcasecmp(function.first, name); });
+  return function == std::end(kAggregateFunctions) ? nullptr : function;
+}
+
+// 列名解析为连接结果中的位置及所在的表，不带表名的列只能出现在一个表中
+static dberr_t ResolveJoinColumn(const vector<TableInfo *> &tables, const vector<uint32_t> &offsets,
+                                 const string &name, uint32_t &table, uint32_t &position) {
+  size_t dot = name.find('.');
+  bool found = false;
+  for (uint32_t i = 0; i < tables.size(); i++) {
+    string column_name = name;
+    if (dot != string::npos) {
+      if (name.substr(0, dot) != tables[i]->GetTableName()) {
+        continue;
       }
+      column_name = name.substr(dot + 1);
     }
-  } else {
-    // select * from xxx，无条件
-    for (TableIterator it = table_info->GetTableHeap()->Begin(nullptr); it != table_info->GetTableHeap()->End(); it++) {
-      result_vec.push_back(it->GetRowId());
+    uint32_t column;
+    if (tables[i]->GetSchema()->GetColumnIndex(column_name, column) != DB_SUCCESS) {
+      continue;
     }
+    if (found) {
+      // 列名有歧义
+      return DB_FAILED;
+    }
+    found = true;
+    table = i;
+    position = offsets[i] + column;
   }
-  return result;
+  return found ? DB_SUCCESS : DB_COLUMN_NAME_NOT_EXIST;
 }
+
 dberr_t ExecuteEngine::ExecuteSelect(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteSelect" << std::endl;
@@ -862,7 +765,6 @@ dberr_t ExecuteEngine::ExecuteSelect(pSyntaxNode ast, ExecuteContext *context) {
   // 表的节点
   pSyntaxNode table_info_node = column_want_node->next_;
   ASSERT(ast->type_ == kNodeSelect, "节点属性错误，根节点应该是select类型");
-  vector<RowId> rows;
   // 获得catalog_manager
   CatalogManager *catalogManager{nullptr};
   auto temp = this->dbs_.find(this->current_db_);
@@ -870,11 +772,12 @@ dberr_t ExecuteEngine::ExecuteSelect(pSyntaxNode ast, ExecuteContext *context) {
     return result;
   }
   catalogManager = temp->second->catalog_mgr_;
-  string table_name = table_info_node->val_;
-  result = get_columns_by_condition(table_info_node->next_, rows, catalogManager, table_name);
-  if (result != DB_SUCCESS) {
-    return result;
+  bool aggregate = HasAggregation(ast);
+  if (table_info_node->type_ == kNodeTableList || HasColumnReference(column_want_node) ||
+      (aggregate && !IsPlainAggregate(ast))) {
+    return ExecuteJoinSelect(ast, temp->second);
   }
+  string table_name = table_info_node->val_;
   vector<string> column_wanted;
   // 获得表元信息
   TableInfo *table_info{nullptr};
@@ -887,42 +790,583 @@ dberr_t ExecuteEngine::ExecuteSelect(pSyntaxNode ast, ExecuteContext *context) {
     for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
       column_wanted.push_back(schema->GetColumns()[i]->GetName());
     }
-  } else {
+  } else if (!aggregate) {
     for (auto begin = column_want_node->child_; begin != nullptr; begin = begin->next_) {
       column_wanted.emplace_back(begin->val_);
     }
   }
-  for (auto &i : rows) {
-    Row row(i);
-    bool get_tuple_result = table_info->GetTableHeap()->GetTuple(&row, nullptr);
-    if (!get_tuple_result) {
+  // 覆盖索引：若所需的列都在某个索引的键中，直接从叶子中的键解码，不再访问堆表
+  vector<IndexInfo *> indexes;
+  catalogManager->GetTableIndexes(table_name, indexes);
+  ConditionList conditions;
+  ConditionList *conditions_ptr{nullptr};
+  AccessPath path;
+  if (table_info_node->next_ != nullptr) {
+    ParseConditions(table_info_node->next_, conditions);
+    result = BindConditions(conditions, schema);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+    conditions_ptr = &conditions;
+    path = Planner(table_info, indexes).ChooseAccessPath(conditions);
+  }
+  // 索引探查比扫描便宜时，只需按结果访问堆表，不走覆盖扫描
+  bool use_index = path.index != nullptr;
+  bool empty = path.empty;
+  if (aggregate) {
+    // 顺序扫描时按列成批地聚集，走索引时逐行聚集
+    if (use_index || empty) {
+      return ExecuteJoinSelect(ast, temp->second);
+    }
+    return AggregateVectorized(table_info, conditions_ptr, column_want_node);
+  }
+  if (!use_index) {
+    IndexInfo *covering = GetCoveringIndex(conditions_ptr, column_wanted, indexes);
+    if (covering != nullptr && !empty) {
+      size_t count = 0;
+      result = ScanCoveringIndex(covering, conditions_ptr, column_wanted, count);
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+      std::cout << "total " << count << " records\n";
+      return result;
+    }
+  }
+  vector<uint32_t> column_index(column_wanted.size());
+  for (uint32_t i = 0; i < column_wanted.size(); i++) {
+    result = schema->GetColumnIndex(column_wanted[i], column_index[i]);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+  }
+  if (!use_index && !empty) {
+    // 顺序扫描时按列成批地解码、过滤和投影
+    size_t count = 0;
+    result = ScanVectorized(table_info, conditions_ptr, column_index, count);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+    std::cout << "total " << count << " records\n";
+    return result;
+  }
+  // 扫描、过滤、投影组成流水线，每一行只从页中读取一次
+  ConditionList scan_conditions;
+  std::unique_ptr<Operator> scan;
+  result = BuildScan(table_info_node->next_, table_info, catalogManager, scan_conditions, scan);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  ProjectionOperator projection(std::move(scan), column_index);
+  result = projection.Init();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  size_t count = 0;
+  for (const Row *row = projection.Next(); row != nullptr; row = projection.Next()) {
+    for (uint32_t i = 0; i < row->GetFieldCount(); i++) {
+      PrintField(row->GetField(i));
+    }
+    cout << '\n';
+    count++;
+  }
+  result = projection.GetStatus();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  std::cout << "total " << count << " records\n";
+  return result;
+}
+
+dberr_t ExecuteEngine::ExecuteJoinSelect(pSyntaxNode ast, DBStorageEngine *storage_engine) {
+  static char kAnd[] = "and";
+  CatalogManager *catalog_manager = storage_engine->catalog_mgr_;
+  pSyntaxNode column_want_node = ast->child_;
+  pSyntaxNode table_node = column_want_node->next_;
+  // FROM中的表，ON条件与WHERE条件一样都是内连接的条件
+  vector<TableInfo *> tables;
+  vector<pSyntaxNode> condition_nodes;
+  bool is_list = table_node->type_ == kNodeTableList;
+  for (auto node = is_list ? table_node->child_ : table_node; node != nullptr; node = is_list ? node->next_ : nullptr) {
+    if (node->type_ == kNodeConditions) {
+      condition_nodes.push_back(node);
+      continue;
+    }
+    TableInfo *table_info{nullptr};
+    dberr_t result = catalog_manager->GetTable(node->val_, table_info);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+    tables.push_back(table_info);
+  }
+  pSyntaxNode group_node{nullptr};
+  for (auto node = table_node->next_; node != nullptr; node = node->next_) {
+    if (node->type_ == kNodeConditions) {
+      condition_nodes.push_back(node);
+    } else if (node->type_ == kNodeGroupBy) {
+      group_node = node;
+    }
+  }
+  // 连接结果的列依次是各个表的列
+  vector<Column *> columns;
+  vector<uint32_t> offsets;
+  for (auto table_info : tables) {
+    offsets.push_back(columns.size());
+    for (auto column : table_info->GetSchema()->GetColumns()) {
+      columns.push_back(column);
+    }
+  }
+  Schema joined(columns);
+
+  // 条件分为三类：只含一个表与常量的条件下推到该表的扫描，两个表的列相等作为连接键，
+  // 其余的在连接到所涉及的最后一个表之后过滤。含有or的条件整体过滤
+  uint32_t table_count = tables.size();
+  vector<ConditionList> lists(condition_nodes.size());
+  vector<vector<uint32_t>> levels(lists.size());
+  vector<ConditionList> table_conditions(table_count);
+  vector<vector<uint32_t>> left_keys(table_count);
+  vector<vector<uint32_t>> right_keys(table_count);
+  for (uint32_t k = 0; k < lists.size(); k++) {
+    ConditionList &list = lists[k];
+    ParseConditions(condition_nodes[k], list);
+    bool all_and = std::all_of(list.connector.begin(), list.connector.end(),
+                               [](char *connector) { return !strcmp(connector, "and"); });
+    uint32_t size = list.pairs.size();
+    list.column_index.resize(size);
+    list.compared_column.assign(size, -1);
+    levels[k].assign(size, 0);
+    for (uint32_t i = 0; i < size; i++) {
+      auto &pair = list.pairs[i];
+      uint32_t table;
+      dberr_t result = ResolveJoinColumn(tables, offsets, get<0>(pair), table, list.column_index[i]);
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+      levels[k][i] = table;
+      if (get<2>(pair) == kNodeIdentifier) {
+        uint32_t other_table, other;
+        result = ResolveJoinColumn(tables, offsets, get<1>(pair), other_table, other);
+        if (result != DB_SUCCESS) {
+          return result;
+        }
+        list.compared_column[i] = other;
+        levels[k][i] = std::max(table, other_table);
+        if (all_and && table != other_table && !strcmp(list.compare[i], "=")) {
+          // 连接键，左边是前面的表连接的结果中的位置，右边是后连接的表中的列号
+          uint32_t later = std::max(table, other_table);
+          uint32_t left = table < other_table ? list.column_index[i] : other;
+          uint32_t right = table < other_table ? other : list.column_index[i];
+          left_keys[later].push_back(left);
+          right_keys[later].push_back(right - offsets[later]);
+          levels[k][i] = table_count;
+        }
+      } else if (all_and) {
+        ConditionList &pushed = table_conditions[table];
+        if (!pushed.pairs.empty()) {
+          pushed.connector.push_back(kAnd);
+        }
+        pushed.compare.push_back(list.compare[i]);
+        pushed.pairs.emplace_back(joined.GetColumn(list.column_index[i])->GetName(), get<1>(pair), get<2>(pair));
+        levels[k][i] = table_count;
+      }
+    }
+    if (!all_and) {
+      uint32_t level = *std::max_element(levels[k].begin(), levels[k].end());
+      levels[k].assign(size, level);
+    }
+  }
+  // 连接到第t个表之后过滤的条件
+  vector<std::shared_ptr<Predicate>> residuals(table_count);
+  for (uint32_t t = 0; t < table_count; t++) {
+    std::unique_ptr<Predicate> residual;
+    for (uint32_t k = 0; k < lists.size(); k++) {
+      vector<bool> skip(levels[k].size());
+      for (uint32_t i = 0; i < skip.size(); i++) {
+        skip[i] = levels[k][i] != t;
+      }
+      std::unique_ptr<Predicate> predicate = CompilePredicate(lists[k], &joined, skip);
+      if (predicate == nullptr) {
+        continue;
+      }
+      residual = residual == nullptr ? std::move(predicate)
+                                     : Predicate::MakeAnd(std::move(residual), std::move(predicate));
+    }
+    residuals[t] = std::move(residual);
+  }
+
+  // 各表的扫描，按估计的行数选择哈希表建在哪一侧，行数未知时建在右侧。
+  // 后连接的表在连接列上有索引、且逐行探查比读整个表便宜时，用索引嵌套循环连接
+  std::unique_ptr<Operator> plan;
+  double left_rows = -1;
+  for (uint32_t t = 0; t < table_count; t++) {
+    vector<IndexInfo *> indexes;
+    catalog_manager->GetTableIndexes(tables[t]->GetTableName(), indexes);
+    Planner planner(tables[t], indexes);
+    double rows = planner.HasRowCount() ? planner.GetRowCount() : -1;
+    double inner_cost = planner.GetSeqScanCost();
+    ConditionList &pushed = table_conditions[t];
+    if (!pushed.pairs.empty()) {
+      dberr_t result = BindConditions(pushed, tables[t]->GetSchema());
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+      AccessPath path = planner.ChooseAccessPath(pushed);
+      inner_cost = path.empty ? 0 : path.cost;
+      if (rows >= 0) {
+        rows *= planner.EstimateSelectivity(pushed);
+      }
+    }
+    vector<uint32_t> key_order;
+    IndexInfo *join_index{nullptr};
+    if (t > 0 && !right_keys[t].empty()) {
+      join_index = planner.ChooseJoinIndex(right_keys[t], left_rows, inner_cost, key_order);
+    }
+    if (join_index != nullptr) {
+      vector<uint32_t> outer_keys;
+      for (auto k : key_order) {
+        outer_keys.push_back(left_keys[t][k]);
+      }
+      std::function<bool(const Row &)> inner_filter;
+      if (!pushed.pairs.empty()) {
+        inner_filter = [&pushed](const Row &row) { return pushed.predicate->Evaluate(row); };
+      }
+      plan = std::make_unique<IndexJoinOperator>(std::move(plan), join_index, tables[t]->GetTableHeap(),
+                                                 std::move(outer_keys), std::move(inner_filter));
+    } else {
+      std::unique_ptr<Operator> scan;
+      if (pushed.pairs.empty()) {
+        scan = std::make_unique<SeqScanOperator>(tables[t]->GetTableHeap());
+      } else {
+        dberr_t result = BuildAccessPath(tables[t], catalog_manager, pushed, scan);
+        if (result != DB_SUCCESS) {
+          return result;
+        }
+      }
+      if (t == 0) {
+        plan = std::move(scan);
+      } else {
+        bool build_left = left_rows >= 0 && rows >= 0 && left_rows < rows;
+        plan = std::make_unique<HashJoinOperator>(std::move(plan), std::move(scan), left_keys[t], right_keys[t],
+                                                  build_left, storage_engine->bpm_);
+      }
+    }
+    if (t == 0) {
+      left_rows = rows;
+    } else if (left_rows >= 0 && rows >= 0) {
+      left_rows = left_keys[t].empty() ? left_rows * rows : std::max(left_rows, rows);
+    } else {
+      left_rows = -1;
+    }
+    if (residuals[t] != nullptr) {
+      std::shared_ptr<Predicate> residual = residuals[t];
+      plan = std::make_unique<FilterOperator>(std::move(plan),
+                                              [residual](const Row &row) { return residual->Evaluate(row); });
+    }
+  }
+
+  vector<uint32_t> column_index;
+  if (HasAggregation(ast)) {
+    // 按分组列聚集，输出的是分组列与各个聚集函数的值
+    if (column_want_node->type_ == kNodeAllColumns) {
       return DB_FAILED;
     }
-    for (auto &j : column_wanted) {
-      uint32_t index;
-      result = schema->GetColumnIndex(j, index);
+    vector<uint32_t> group_columns;
+    for (auto node = group_node == nullptr ? nullptr : group_node->child_; node != nullptr; node = node->next_) {
+      uint32_t table, position;
+      dberr_t result = ResolveJoinColumn(tables, offsets, node->val_, table, position);
       if (result != DB_SUCCESS) {
         return result;
       }
-      auto field = row.GetField(index);
-      if (field->GetType() == kTypeFloat) {
-        float f = field->GetFloatData();
-        if (abs(f - floor(f)) <= 1e-5 || abs(f - ceil(f)) <= 1e-5) {
-          printf("%d ", static_cast<int>(field->GetFloatData()));
-        } else {
-          printf("%lf ", field->GetFloatData());
+      group_columns.push_back(position);
+    }
+    vector<std::pair<AggregateType, int>> aggregates;
+    for (auto begin = column_want_node->child_; begin != nullptr; begin = begin->next_) {
+      if (begin->type_ != kNodeAggregate) {
+        // 不是聚集函数的列必须是分组列
+        uint32_t table, position;
+        dberr_t result = ResolveJoinColumn(tables, offsets, begin->val_, table, position);
+        if (result != DB_SUCCESS) {
+          return result;
+        }
+        auto group = std::find(group_columns.begin(), group_columns.end(), position);
+        if (group == group_columns.end()) {
+          return DB_FAILED;
+        }
+        column_index.push_back(group - group_columns.begin());
+        continue;
+      }
+      auto function = FindAggregateFunction(begin->val_);
+      if (function == nullptr) {
+        return DB_FAILED;
+      }
+      int column = -1;
+      if (begin->child_->type_ == kNodeAllColumns) {
+        // 只有count可以用*
+        if (function->second != AggregateType::kCount) {
+          return DB_FAILED;
         }
       } else {
-        string temp_str(field->GetData(), field->GetLength());  // 避免乱码出现
-        std::cout << temp_str << " ";
+        uint32_t table, position;
+        dberr_t result = ResolveJoinColumn(tables, offsets, begin->child_->val_, table, position);
+        if (result != DB_SUCCESS) {
+          return result;
+        }
+        if (function->second != AggregateType::kCount && joined.GetColumn(position)->GetType() == kTypeChar) {
+          return DB_TYPE_MISMATCH;
+        }
+        column = position;
       }
+      column_index.push_back(group_columns.size() + aggregates.size());
+      aggregates.emplace_back(function->second, column);
+    }
+    plan = std::make_unique<HashAggregateOperator>(std::move(plan), std::move(group_columns), std::move(aggregates),
+                                                   storage_engine->bpm_);
+  } else if (column_want_node->type_ == kNodeAllColumns) {
+    for (uint32_t i = 0; i < columns.size(); i++) {
+      column_index.push_back(i);
+    }
+  } else {
+    for (auto begin = column_want_node->child_; begin != nullptr; begin = begin->next_) {
+      uint32_t table, position;
+      dberr_t result = ResolveJoinColumn(tables, offsets, begin->val_, table, position);
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+      column_index.push_back(position);
+    }
+  }
+  ProjectionOperator projection(std::move(plan), column_index);
+  dberr_t result = projection.Init();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  size_t count = 0;
+  for (const Row *row = projection.Next(); row != nullptr; row = projection.Next()) {
+    for (uint32_t i = 0; i < row->GetFieldCount(); i++) {
+      PrintField(row->GetField(i));
     }
     cout << '\n';
+    count++;
+  }
+  result = projection.GetStatus();
+  if (result != DB_SUCCESS) {
+    return result;
   }
-  std::cout << "total " << rows.size() << " records\n";
+  std::cout << "total " << count << " records\n";
   return result;
 }
 
+IndexInfo *ExecuteEngine::GetCoveringIndex(const ConditionList *conditions, const vector<string> &columns,
+                                           vector<IndexInfo *> &indexes) {
+  IndexInfo *covering{nullptr};
+  for (auto index_info : indexes) {
+    // 哈希索引无法按序遍历
+    if (index_info->GetIndexType() != kIndexBPlusTree) {
+      continue;
+    }
+    auto key_schema = index_info->GetIndexKeySchema();
+    uint32_t unused;
+    bool cover = all_of(columns.begin(), columns.end(), [&](const string &name) -> bool {
+      return key_schema->GetColumnIndex(name, unused) == DB_SUCCESS;
+    });
+    if (cover && conditions != nullptr) {
+      cover = all_of(conditions->pairs.begin(), conditions->pairs.end(), [&](auto &pair) -> bool {
+        return key_schema->GetColumnIndex(get<0>(pair), unused) == DB_SUCCESS;
+      });
+    }
+    // 选择键最短的索引
+    if (cover && (covering == nullptr ||
+                  key_schema->GetColumnCount() < covering->GetIndexKeySchema()->GetColumnCount())) {
+      covering = index_info;
+    }
+  }
+  return covering;
+}
+
+dberr_t ExecuteEngine::ScanCoveringIndex(IndexInfo *index_info, ConditionList *conditions,
+                                         const vector<string> &columns, size_t &count) {
+  auto key_schema = index_info->GetIndexKeySchema();
+  vector<uint32_t> column_index(columns.size());
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    key_schema->GetColumnIndex(columns[i], column_index[i]);
+  }
+  if (conditions != nullptr) {
+    dberr_t result = BindConditions(*conditions, key_schema);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+  }
+  // 键长因索引而异，按具体的b+树类型遍历
+  index_info->VisitBPlusTreeIndex([&](auto *index) {
+    auto end = index->GetEndIterator();
+    for (auto iter = index->GetBeginIterator(); iter != end; ++iter) {
+      Row row(INVALID_ROWID);
+      (*iter).first.DeserializeToKey(row, key_schema);
+      if (conditions != nullptr && !conditions->predicate->Evaluate(row)) {
+        continue;
+      }
+      for (auto i : column_index) {
+        PrintField(row.GetField(i));
+      }
+      cout << '\n';
+      count++;
+    }
+  });
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::BuildVectorScan(TableInfo *table_info, ConditionList *conditions,
+                                       std::unique_ptr<VectorOperator> &plan) {
+  auto schema = table_info->GetSchema();
+  vector<uint32_t> all_columns(schema->GetColumnCount());
+  for (uint32_t i = 0; i < all_columns.size(); i++) {
+    all_columns[i] = i;
+  }
+  plan = std::make_unique<VectorScanOperator>(table_info->GetTableHeap(), schema, all_columns);
+  if (conditions != nullptr) {
+    dberr_t result = BindConditions(*conditions, schema);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+    // 条件从最下面的一个开始依次结合
+    vector<VectorPredicate> predicates;
+    vector<bool> and_connectors;
+    for (int i = static_cast<int>(conditions->pairs.size()) - 1; i >= 0; i--) {
+      VectorPredicate predicate{conditions->column_index[i], ParseCompareOp(conditions->compare[i]), true, 0, ""};
+      auto literal_type = get<2>(conditions->pairs[i]);
+      if (literal_type == kNodeNumber) {
+        predicate.number = static_cast<float>(atof(get<1>(conditions->pairs[i])));
+        predicate.integral = ParseInteger(get<1>(conditions->pairs[i]), predicate.integer);
+        const Field &constant = conditions->to_be_compared[i];
+        if (!predicate.integral && constant.GetType() == kTypeInt && !constant.IsNull()) {
+          // 整数列上改写过的范围条件
+          predicate.integral = true;
+          predicate.integer = constant.GetIntData();
+        }
+      } else if (literal_type == kNodeString) {
+        predicate.numeric = false;
+        predicate.text = get<1>(conditions->pairs[i]);
+      } else {
+        // 与null比较的结果总是false，用NaN表示
+        predicate.number = NAN;
+      }
+      predicates.push_back(std::move(predicate));
+      if (i > 0) {
+        and_connectors.push_back(!strcmp(conditions->connector[i - 1], "and"));
+      }
+    }
+    plan = std::make_unique<VectorFilterOperator>(std::move(plan), std::move(predicates), std::move(and_connectors));
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::ScanVectorized(TableInfo *table_info, ConditionList *conditions,
+                                      const vector<uint32_t> &column_index, size_t &count) {
+  std::unique_ptr<VectorOperator> plan;
+  dberr_t result = BuildVectorScan(table_info, conditions, plan);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  VectorProjectionOperator projection(std::move(plan), column_index);
+  result = projection.Init();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  for (VectorBatch *batch = projection.NextBatch(); batch != nullptr; batch = projection.NextBatch()) {
+    for (uint32_t i = 0; i < batch->GetSize(); i++) {
+      for (auto &column : batch->columns) {
+        PrintValue(column, i);
+      }
+      cout << '\n';
+    }
+    count += batch->GetSize();
+  }
+  return projection.GetStatus();
+}
+
+dberr_t ExecuteEngine::AggregateVectorized(TableInfo *table_info, ConditionList *conditions,
+                                           pSyntaxNode column_want_node) {
+  auto schema = table_info->GetSchema();
+  vector<std::pair<AggregateType, int>> aggregates;
+  for (auto begin = column_want_node->child_; begin != nullptr; begin = begin->next_) {
+    auto function = FindAggregateFunction(begin->val_);
+    if (function == nullptr) {
+      return DB_FAILED;
+    }
+    int column = -1;
+    if (begin->child_->type_ == kNodeAllColumns) {
+      // 只有count可以用*
+      if (function->second != AggregateType::kCount) {
+        return DB_FAILED;
+      }
+    } else {
+      uint32_t position;
+      dberr_t result = schema->GetColumnIndex(begin->child_->val_, position);
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+      if (function->second != AggregateType::kCount && schema->GetColumn(position)->GetType() == kTypeChar) {
+        return DB_TYPE_MISMATCH;
+      }
+      column = position;
+    }
+    aggregates.emplace_back(function->second, column);
+  }
+  std::unique_ptr<VectorOperator> plan;
+  dberr_t result = BuildVectorScan(table_info, conditions, plan);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  VectorAggregateOperator aggregate(std::move(plan), std::move(aggregates));
+  result = aggregate.Init();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  VectorBatch *batch = aggregate.NextBatch();
+  if (batch == nullptr) {
+    return aggregate.GetStatus();
+  }
+  for (auto &column : batch->columns) {
+    PrintValue(column, 0);
+  }
+  cout << '\n';
+  std::cout << "total 1 records\n";
+  return DB_SUCCESS;
+}
+
+// 整数值的浮点数按整数输出
+static void PrintFloat(float f) {
+  if (abs(f - floor(f)) <= 1e-5 || abs(f - ceil(f)) <= 1e-5) {
+    printf("%d ", static_cast<int>(f));
+  } else {
+    printf("%lf ", f);
+  }
+}
+
+void ExecuteEngine::PrintValue(const ColumnVector &column, uint32_t i) {
+  if (column.IsNull(i)) {
+    std::cout << "null ";
+  } else if (column.GetType() == kTypeFloat) {
+    PrintFloat(column.GetFloats()[i]);
+  } else if (column.GetType() == kTypeInt) {
+    printf("%d ", column.GetInts()[i]);
+  } else {
+    std::cout << string(column.GetChars(i), column.GetCharLength(i)) << " ";
+  }
+}
+
+void ExecuteEngine::PrintField(Field *field) {
+  if (field->IsNull()) {
+    std::cout << "null ";
+  } else if (field->GetType() == kTypeFloat) {
+    PrintFloat(field->GetFloatData());
+  } else if (field->GetType() == kTypeInt) {
+    printf("%d ", field->GetIntData());
+  } else {
+    string temp_str(field->GetData(), field->GetLength());  // 避免乱码出现
+    std::cout << temp_str << " ";
+  }
+}
+
 dberr_t ExecuteEngine::ExecuteInsert(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteInsert" << std::endl;
@@ -937,85 +1381,38 @@ dberr_t ExecuteEngine::ExecuteInsert(pSyntaxNode ast, ExecuteContext *context) {
   string table_name = table_info_node->val_;
   pSyntaxNode begin = table_info_node->next_->child_;
 
-  size_t begin_sise = tempo->second->bpm_->GetFreeSize();
-
   CatalogManager *catalogmanager = tempo->second->catalog_mgr_;
   TableInfo *tableInfo;
   auto result = catalogmanager->GetTable(table_name, tableInfo);
   if (result != DB_SUCCESS) {
     return result;
   }
+  // 按列的类型构造各个值
+  auto schema = tableInfo->GetSchema();
   vector<Field> fields;
-  while (begin) {
-    if (begin->type_ == kNodeNumber) {
-      fields.emplace_back(kTypeFloat, (float)(atof(begin->val_)));
-    } else if (begin->type_ == kNodeString) {
-      fields.emplace_back(kTypeChar, begin->val_, strlen(begin->val_), true);
-    } else {
-      // null
-      fields.emplace_back(kTypeChar, nullptr, 0, false);
+  fields.reserve(schema->GetColumnCount());
+  for (uint32_t i = 0; begin; i++, begin = begin->next_) {
+    if (i >= schema->GetColumnCount()) {
+      return DB_FAILED;
+    }
+    result = BindLiteral(begin->val_, begin->type_, schema->GetColumn(i)->GetType(), fields);
+    if (result != DB_SUCCESS) {
+      return result;
     }
-    begin = begin->next_;
-  }
-  Row row(fields);
-
-  // 获取主键，查看是否重复
-  auto primary_keys = tableInfo->GetSchema()->getPrimaryKeys();
-  vector<Field> pri_fie;
-  for (uint32_t i = 0; i < primary_keys.size(); i++) {
-    pri_fie.push_back(fields[primary_keys[i]]);
-  }
-  Row pri_row(pri_fie);
-  IndexInfo *index_info;
-  vector<RowId> rid_result;
-  rid_result.clear();
-  result = catalogmanager->GetIndex(table_name, table_name + "__primary", index_info);
-  index_info->GetIndex()->ScanKey(pri_row, rid_result, nullptr);
-  if (!rid_result.empty()) {
-    // 主键冲突
-    return DB_PRIMARY_KEY_COLLISION;
   }
-
-  // 唯一性检查
-  auto uni_vec = tableInfo->GetSchema()->getUniqueKeys();
-  for (uint32_t i = 0; i < uni_vec.size(); i++) {
-    vector<Field> uni_fie;
-    uni_fie.push_back(fields[uni_vec[i]]);
-    Row uni_row(uni_fie);
-    rid_result.clear();
-    result = catalogmanager->GetIndex(table_name, table_name + "__unique__" + to_string(uni_vec[i]), index_info);
-    index_info->GetIndex()->ScanKey(uni_row, rid_result, nullptr);
-    if (!rid_result.empty()) {
-      return DB_UNIQUE_KEY_COLLISION;
-    }
-  }
-  // 插入记录
-  if (!tableInfo->GetTableHeap()->InsertTuple(row, nullptr)) {
+  if (fields.size() != schema->GetColumnCount()) {
     return DB_FAILED;
   }
-  // 插入所有的索引
+  // 插入记录及其所有索引项
   vector<IndexInfo *> index_infos;
   catalogmanager->GetTableIndexes(table_name, index_infos);
-  for (uint32_t i = 0; i < index_infos.size(); i++) {
-    vector<Field> index_fie;
-    auto index_schema = index_infos[i]->GetIndexKeySchema();
-    auto index_cols = index_schema->GetColumns();
-    for (uint32_t j = 0; j < index_schema->GetColumnCount(); j++) {
-      uint32_t col_pos;
-      tableInfo->GetSchema()->GetColumnIndex(index_cols[j]->GetName(), col_pos);
-      index_fie.push_back(fields[col_pos]);
-    }
-    Row index_row(index_fie);
-    result = index_infos[i]->GetIndex()->InsertEntry(index_row, row.GetRowId(), nullptr);
-    if (result != DB_SUCCESS) {
-      return result;
-    }
-  }
-  size_t end_sise = tempo->second->bpm_->GetFreeSize();
-  if (end_sise - begin_sise < 0) {
-    //    std::cout << "here!" << std::endl;
+  InsertOperator insert(tableInfo, index_infos, std::move(fields));
+  result = insert.Init();
+  if (result != DB_SUCCESS) {
+    return result;
   }
-  return DB_SUCCESS;
+  insert.Next();
+  return insert.GetStatus();
 }
 
 dberr_t ExecuteEngine::ExecuteDelete(pSyntaxNode ast, ExecuteContext *context) {
@@ -1027,7 +1424,6 @@ dberr_t ExecuteEngine::ExecuteDelete(pSyntaxNode ast, ExecuteContext *context) {
   // 表的节点
   pSyntaxNode table_info_node = ast->child_;
   ASSERT(ast->type_ == kNodeDelete, "节点属性错误，根节点应该是select类型");
-  vector<RowId> rows;
   // 获得catalog_manager
   CatalogManager *catalogManager{nullptr};
   auto temp = this->dbs_.find(this->current_db_);
@@ -1035,19 +1431,25 @@ dberr_t ExecuteEngine::ExecuteDelete(pSyntaxNode ast, ExecuteContext *context) {
     return result;
   }
   catalogManager = temp->second->catalog_mgr_;
-  string table_name = table_info_node->val_;
-  result = get_columns_by_condition(table_info_node->next_, rows, catalogManager, table_name);
+  TableInfo *tableinfo;
+  result = catalogManager->GetTable(table_info_node->val_, tableinfo);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  ConditionList conditions;
+  std::unique_ptr<Operator> scan;
+  result = BuildScan(table_info_node->next_, tableinfo, catalogManager, conditions, scan);
   if (result != DB_SUCCESS) {
     return result;
   }
-  TableInfo *tableinfo;
-  result = catalogManager->GetTable(table_info_node->val_, tableinfo);
   vector<IndexInfo *> index_infos;
   catalogManager->GetTableIndexes(table_info_node->val_, index_infos);
-  if (table_info_node->child_ == nullptr && table_info_node->next_ == nullptr) {
-    // 运行的是delete from table; 无条件，那么将索引drop掉之后重新创建，减小开销
+  bool rebuild_indexes = table_info_node->child_ == nullptr && table_info_node->next_ == nullptr;
+  // 运行的是delete from table; 无条件，那么将索引drop掉之后重新创建，减小开销
+  vector<pair<string, vector<string>>> index_back;
+  vector<IndexType> index_types;
+  if (rebuild_indexes) {
     // 获取所有索引的vector<string>
-    vector<pair<string, vector<string>>> index_back;
     for (uint32_t i = 0; i < index_infos.size(); i++) {
       vector<string> index_attrs;
       IndexSchema *index_single_schema = index_infos[i]->GetIndexKeySchema();
@@ -1057,63 +1459,47 @@ dberr_t ExecuteEngine::ExecuteDelete(pSyntaxNode ast, ExecuteContext *context) {
         index_attrs.emplace_back(it->GetName());
       }
       index_back.emplace_back(index_infos[i]->GetIndexName(), index_attrs);
+      index_types.push_back(index_infos[i]->GetIndexType());
     }
+    index_infos.clear();
+  }
+  // 先取出所有要删除的行，再在所有索引中逐个删除，最后删除实际的记录
+  DeleteOperator deleter(std::move(scan), tableinfo, index_infos);
+  result = deleter.Init();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  if (rebuild_indexes) {
     // drop掉所有该表的索引
     for (uint32_t i = 0; i < index_back.size(); i++) {
       catalogManager->DropIndex(tableinfo->GetTableName(), index_back[i].first);
     }
-    //再删除实际的记录
-    auto table_heap = tableinfo->GetTableHeap();
-    for (auto &it : rows) {
-      table_heap->ApplyDelete(it, nullptr);
-    }
+  }
+  size_t count = 0;
+  while (deleter.Next() != nullptr) {
+    count++;
+  }
+  if (rebuild_indexes) {
     // 重新创建索引
     IndexInfo *unused;
     for (uint32_t i = 0; i < index_back.size(); i++) {
       catalogManager->CreateIndex(tableinfo->GetTableName(), index_back[i].first, index_back[i].second, nullptr,
-                                  unused);
-    }
-  } else {
-    // 在所有索引中逐个删除
-    for (uint32_t q = 0; q < rows.size(); q++) {
-      //获取当前的列
-      Row cur(rows[q]);
-      tableinfo->GetTableHeap()->GetTuple(&cur, nullptr);
-      auto fields = cur.GetFields();
-      for (uint32_t i = 0; i < index_infos.size(); i++) {
-        vector<Field> index_fie;
-        auto index_schema = index_infos[i]->GetIndexKeySchema();
-        auto index_cols = index_schema->GetColumns();
-        for (uint32_t j = 0; j < index_schema->GetColumnCount(); j++) {
-          uint32_t col_pos;
-          tableinfo->GetSchema()->GetColumnIndex(index_cols[j]->GetName(), col_pos);
-          index_fie.push_back(*fields[col_pos]);
-        }
-        Row index_row(index_fie);
-        index_infos[i]->GetIndex()->RemoveEntry(index_row, rows[q], nullptr);
-      }
-    }
-    //再删除实际的记录
-    auto table_heap = tableinfo->GetTableHeap();
-    for (auto &it : rows) {
-      table_heap->ApplyDelete(it, nullptr);
+                                  unused, index_types[i]);
     }
   }
-  std::cout << rows.size() << "  rows affected" << std::endl;
-  return result;
+  std::cout << count << "  rows affected" << std::endl;
+  return deleter.GetStatus();
 }
 
 dberr_t ExecuteEngine::ExecuteUpdate(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteUpdate" << std::endl;
 #endif
-  // TODO 需要对对应的索引进行更新，不过验收貌似不验，先不写了
   dberr_t result = DB_FAILED;
   // 获得table节点
   // 想要的列的信息
   pSyntaxNode table_info_node = ast->child_;
   ASSERT(ast->type_ == kNodeUpdate, "节点属性错误，根节点应该是update类型");
-  vector<RowId> rows;
   // 获得catalog_manager
   CatalogManager *catalogManager{nullptr};
   auto temp = this->dbs_.find(this->current_db_);
@@ -1122,52 +1508,49 @@ dberr_t ExecuteEngine::ExecuteUpdate(pSyntaxNode ast, ExecuteContext *context) {
   }
   catalogManager = temp->second->catalog_mgr_;
   string table_name = table_info_node->val_;
-  result = get_columns_by_condition(table_info_node->next_->next_, rows, catalogManager, table_name);
-  if (result != DB_SUCCESS) {
-    return result;
-  }
   TableInfo *tableinfo;
   result = catalogManager->GetTable(table_name, tableinfo);
   if (result != DB_SUCCESS) {
     return result;
   }
-  vector<pair<string, Field>> ff_vec;
+  vector<pair<uint32_t, Field>> ff_vec;
   auto begin = ast->child_->next_->child_;
   while (begin) {
     auto col = begin->child_;
     auto val = col->next_;
-    if (val->type_ == kNodeNumber) {
-      ff_vec.emplace_back(col->val_, Field{kTypeFloat, (float)(atof(val->val_))});
-    } else if (val->type_ == kNodeString) {
-      ff_vec.emplace_back(col->val_, Field{kTypeChar, val->val_, static_cast<uint32_t>(strlen(val->val_)), false});
-    } else {
-      ff_vec.emplace_back(col->val_, Field{kTypeChar, nullptr, 0, false});
-    }
     uint32_t pos;
     result = tableinfo->GetSchema()->GetColumnIndex(col->val_, pos);
     if (result != DB_SUCCESS) {
       return result;
     }
+    vector<Field> value;
+    result = BindLiteral(val->val_, val->type_, tableinfo->GetSchema()->GetColumn(pos)->GetType(), value);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+    ff_vec.emplace_back(pos, value[0]);
     begin = begin->next_;
   }
-  for (uint32_t i = 0; i < rows.size(); i++) {
-    Row orow(rows[i]);
-    tableinfo->GetTableHeap()->GetTuple(&orow, nullptr);
-    vector<Field *> new_field = orow.GetFields();
-    for (auto &f : ff_vec) {
-      uint32_t index;
-      assert(tableinfo->GetSchema()->GetColumnIndex(f.first, index) == DB_SUCCESS);
-      new_field[index] = &f.second;
-    }
-    vector<Field> ffff;
-    for (auto it : new_field) {
-      ffff.emplace_back(*it);
-    }
-    Row row(ffff);
-    tableinfo->GetTableHeap()->UpdateTuple(row, rows[i], nullptr);
+  ConditionList conditions;
+  std::unique_ptr<Operator> scan;
+  result = BuildScan(table_info_node->next_->next_, tableinfo, catalogManager, conditions, scan);
+  if (result != DB_SUCCESS) {
+    return result;
   }
-  std::cout << rows.size() << "  rows affected" << std::endl;
-  return DB_SUCCESS;
+  // 键中有被赋值的列的索引，删除旧键并插入新键
+  vector<IndexInfo *> index_infos;
+  catalogManager->GetTableIndexes(table_name, index_infos);
+  UpdateOperator updater(std::move(scan), tableinfo, std::move(index_infos), std::move(ff_vec));
+  result = updater.Init();
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  size_t count = 0;
+  while (updater.Next() != nullptr) {
+    count++;
+  }
+  std::cout << count << "  rows affected" << std::endl;
+  return updater.GetStatus();
 }
 
 dberr_t ExecuteEngine::ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context) {
@@ -1226,6 +1609,19 @@ dberr_t ExecuteEngine::ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context)
   return DB_SUCCESS;
 }
 
+dberr_t ExecuteEngine::ExecuteAnalyze(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteAnalyze" << std::endl;
+#endif
+  ASSERT(ast->type_ == kNodeAnalyze, "ExecuteEngine::ExecuteAnalyze error: wrong input ast type");
+  auto temp = dbs_.find(current_db_);
+  if (temp == dbs_.end()) {
+    std::cout << "请先use一个数据库\n";
+    return DB_FAILED;
+  }
+  return temp->second->catalog_mgr_->AnalyzeTable(ast->child_->val_);
+}
+
 dberr_t ExecuteEngine::ExecuteTrxBegin(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteTrxBegin" << std::endl;
@@ -0,0 +1,840 @@
+#include "executor/operators.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+// 索引键中每一列在表中的位置
+static std::vector<uint32_t> GetKeyMap(IndexInfo *index_info, TableInfo *table_info) {
+  auto index_schema = index_info->GetIndexKeySchema();
+  std::vector<uint32_t> key_map(index_schema->GetColumnCount());
+  for (uint32_t i = 0; i < index_schema->GetColumnCount(); i++) {
+    table_info->GetSchema()->GetColumnIndex(index_schema->GetColumn(i)->GetName(), key_map[i]);
+  }
+  return key_map;
+}
+
+static Row GetKey(const Row &row, const std::vector<uint32_t> &key_map) {
+  std::vector<Field> fields;
+  fields.reserve(key_map.size());
+  for (auto pos : key_map) {
+    fields.push_back(*row.GetField(pos));
+  }
+  return Row(fields);
+}
+
+dberr_t SeqScanOperator::Init() {
+  // 直接初始化，避免迭代器拷贝时共享同一个row
+  iter_.reset(new TableIterator(table_heap_->Begin(nullptr)));
+  started_ = false;
+  return DB_SUCCESS;
+}
+
+const Row *SeqScanOperator::Next() {
+  if (started_) {
+    // 已经到达末尾时不能再前进
+    if (*iter_ == table_heap_->End()) {
+      return nullptr;
+    }
+    ++(*iter_);
+  }
+  started_ = true;
+  if (*iter_ == table_heap_->End()) {
+    return nullptr;
+  }
+  return &(**iter_);
+}
+
+dberr_t IndexScanOperator::Init() {
+  rids_.clear();
+  next_ = 0;
+  if (range_) {
+    status_ = index_->ScanRange(low_.get(), high_.get(), rids_, nullptr);
+    return status_;
+  }
+  if (keys_.empty()) {
+    return DB_SUCCESS;
+  }
+  if (keys_.size() == 1) {
+    status_ = index_->ScanKey(keys_[0], rids_, nullptr);
+    return status_;
+  }
+  // 多个键时批量探查索引，去掉重复的结果
+  std::vector<RowId> found;
+  status_ = index_->ScanKeys(keys_, found, nullptr);
+  std::set<int64_t> seen;
+  for (auto &rid : found) {
+    if (rid.Get() != INVALID_ROWID.Get() && seen.insert(rid.Get()).second) {
+      rids_.push_back(rid);
+    }
+  }
+  return status_;
+}
+
+const Row *IndexScanOperator::Next() {
+  if (next_ >= rids_.size()) {
+    return nullptr;
+  }
+  row_ = std::make_unique<Row>(rids_[next_++]);
+  if (!table_heap_->GetTuple(row_.get(), nullptr)) {
+    status_ = DB_FAILED;
+    return nullptr;
+  }
+  return row_.get();
+}
+
+const Row *FilterOperator::Next() {
+  const Row *row;
+  while ((row = child_->Next()) != nullptr) {
+    if (predicate_(*row)) {
+      return row;
+    }
+  }
+  status_ = child_->GetStatus();
+  return nullptr;
+}
+
+const Row *ProjectionOperator::Next() {
+  const Row *row = child_->Next();
+  if (row == nullptr) {
+    status_ = child_->GetStatus();
+    return nullptr;
+  }
+  std::vector<Field> fields;
+  fields.reserve(column_index_.size());
+  for (auto index : column_index_) {
+    fields.push_back(*row->GetField(index));
+  }
+  row_ = std::make_unique<Row>(fields);
+  row_->SetRowId(row->GetRowId());
+  return row_.get();
+}
+
+const Row *InsertOperator::Next() {
+  if (row_ != nullptr || status_ != DB_SUCCESS) {
+    return nullptr;
+  }
+  auto row = std::make_unique<Row>(values_);
+  // 插入记录
+  if (!table_info_->GetTableHeap()->InsertTuple(*row, nullptr)) {
+    status_ = DB_FAILED;
+    return nullptr;
+  }
+  // 插入所有的索引，主键索引在前。每个索引只下降一次，插入的同时完成主键与唯一性检查
+  std::string primary_name = table_info_->GetTableName() + "__primary";
+  std::stable_partition(indexes_.begin(), indexes_.end(),
+                        [&](IndexInfo *it) -> bool { return it->GetIndexName() == primary_name; });
+  std::vector<Row> keys;
+  keys.reserve(indexes_.size());
+  for (uint32_t i = 0; i < indexes_.size(); i++) {
+    keys.push_back(GetKey(*row, GetKeyMap(indexes_[i], table_info_)));
+    dberr_t result = indexes_[i]->GetIndex()->InsertIfAbsent(keys.back(), row->GetRowId(), nullptr);
+    if (result != DB_SUCCESS) {
+      // 冲突，撤销已经插入的索引项和记录
+      for (uint32_t j = 0; j < i; j++) {
+        indexes_[j]->GetIndex()->RemoveEntry(keys[j], row->GetRowId(), nullptr);
+      }
+      table_info_->GetTableHeap()->ApplyDelete(row->GetRowId(), nullptr);
+      if (result == DB_KEY_ALREADY_EXIST) {
+        result = indexes_[i]->GetIndexName() == primary_name ? DB_PRIMARY_KEY_COLLISION : DB_UNIQUE_KEY_COLLISION;
+      }
+      status_ = result;
+      return nullptr;
+    }
+  }
+  row_ = std::move(row);
+  return row_.get();
+}
+
+dberr_t DeleteOperator::Init() {
+  status_ = child_->Init();
+  if (status_ != DB_SUCCESS) {
+    return status_;
+  }
+  rows_.clear();
+  next_ = 0;
+  const Row *row;
+  while ((row = child_->Next()) != nullptr) {
+    rows_.push_back(*row);
+  }
+  status_ = child_->GetStatus();
+  return status_;
+}
+
+const Row *DeleteOperator::Next() {
+  if (next_ >= rows_.size()) {
+    return nullptr;
+  }
+  if (next_ == 0) {
+    // 在所有索引中逐个删除
+    std::vector<std::vector<uint32_t>> key_maps;
+    for (auto index_info : indexes_) {
+      key_maps.push_back(GetKeyMap(index_info, table_info_));
+    }
+    for (auto &row : rows_) {
+      for (uint32_t i = 0; i < indexes_.size(); i++) {
+        indexes_[i]->GetIndex()->RemoveEntry(GetKey(row, key_maps[i]), row.GetRowId(), nullptr);
+      }
+    }
+  }
+  const Row &row = rows_[next_++];
+  table_info_->GetTableHeap()->ApplyDelete(row.GetRowId(), nullptr);
+  return &row;
+}
+
+dberr_t UpdateOperator::Init() {
+  status_ = child_->Init();
+  if (status_ != DB_SUCCESS) {
+    return status_;
+  }
+  rows_.clear();
+  next_ = 0;
+  // 只有键中有被赋值的列的索引需要维护，主键索引在前
+  std::string primary_name = table_info_->GetTableName() + "__primary";
+  std::stable_partition(indexes_.begin(), indexes_.end(),
+                        [&](IndexInfo *it) -> bool { return it->GetIndexName() == primary_name; });
+  std::vector<IndexInfo *> changed;
+  key_maps_.clear();
+  for (auto index_info : indexes_) {
+    std::vector<uint32_t> key_map = GetKeyMap(index_info, table_info_);
+    if (std::any_of(assignments_.begin(), assignments_.end(), [&](const std::pair<uint32_t, Field> &assignment) {
+          return std::find(key_map.begin(), key_map.end(), assignment.first) != key_map.end();
+        })) {
+      changed.push_back(index_info);
+      key_maps_.push_back(std::move(key_map));
+    }
+  }
+  indexes_ = std::move(changed);
+  const Row *row;
+  while ((row = child_->Next()) != nullptr) {
+    rows_.push_back(*row);
+  }
+  status_ = child_->GetStatus();
+  return status_;
+}
+
+const Row *UpdateOperator::Next() {
+  if (next_ >= rows_.size() || status_ != DB_SUCCESS) {
+    return nullptr;
+  }
+  const Row &old_row = rows_[next_++];
+  // Field的赋值会交换两边的值，因此逐列拷贝新值或旧值
+  std::vector<const Field *> sources(old_row.GetFieldCount());
+  for (uint32_t i = 0; i < old_row.GetFieldCount(); i++) {
+    sources[i] = old_row.GetField(i);
+  }
+  for (auto &assignment : assignments_) {
+    sources[assignment.first] = &assignment.second;
+  }
+  std::vector<Field> fields;
+  fields.reserve(sources.size());
+  for (auto field : sources) {
+    fields.push_back(*field);
+  }
+  row_ = std::make_unique<Row>(fields);
+  row_->SetRowId(old_row.GetRowId());
+  // 先删除全部旧键，再插入新键，同一行内交换键值的更新不会与自己冲突
+  RowId rid = old_row.GetRowId();
+  std::vector<Row> old_keys, new_keys;
+  for (uint32_t i = 0; i < indexes_.size(); i++) {
+    old_keys.push_back(GetKey(old_row, key_maps_[i]));
+    new_keys.push_back(GetKey(*row_, key_maps_[i]));
+    indexes_[i]->GetIndex()->RemoveEntry(old_keys[i], rid, nullptr);
+  }
+  dberr_t result = DB_SUCCESS;
+  uint32_t inserted = 0;
+  for (; inserted < indexes_.size(); inserted++) {
+    result = indexes_[inserted]->GetIndex()->InsertIfAbsent(new_keys[inserted], rid, nullptr);
+    if (result != DB_SUCCESS) {
+      break;
+    }
+  }
+  if (result == DB_SUCCESS && !table_info_->GetTableHeap()->UpdateTuple(*row_, rid, nullptr)) {
+    result = DB_FAILED;
+  }
+  if (result != DB_SUCCESS) {
+    // 冲突或者记录放不下，恢复这一行的索引项
+    for (uint32_t i = 0; i < inserted; i++) {
+      indexes_[i]->GetIndex()->RemoveEntry(new_keys[i], rid, nullptr);
+    }
+    for (uint32_t i = 0; i < indexes_.size(); i++) {
+      indexes_[i]->GetIndex()->InsertIfAbsent(old_keys[i], rid, nullptr);
+    }
+    if (result == DB_KEY_ALREADY_EXIST) {
+      std::string primary_name = table_info_->GetTableName() + "__primary";
+      result = indexes_[inserted]->GetIndexName() == primary_name ? DB_PRIMARY_KEY_COLLISION
+                                                                   : DB_UNIQUE_KEY_COLLISION;
+    }
+    status_ = result;
+    return nullptr;
+  }
+  return row_.get();
+}
+
+bool HashJoinOperator::GetHashKey(const Row &row, const std::vector<uint32_t> &keys, std::string &key) {
+  key.clear();
+  for (auto pos : keys) {
+    const Field *field = row.GetField(pos);
+    if (field->IsNull()) {
+      return false;
+    }
+    // 数字统一转为double，int与float的相同值得到相同的键
+    if (field->GetType() == kTypeChar) {
+      uint32_t len = field->GetCharLength();
+      key.push_back('c');
+      key.append(reinterpret_cast<const char *>(&len), sizeof(len));
+      key.append(field->GetData(), len);
+    } else {
+      double number = field->GetType() == kTypeInt ? static_cast<double>(field->GetIntData())
+                                                     : static_cast<double>(field->GetFloatData());
+      // -0.0与0相等，与GenericComparator::Canonicalize一样统一为0.0
+      if (number == 0) {
+        number = 0.0;
+      }
+      key.push_back('n');
+      key.append(reinterpret_cast<const char *>(&number), sizeof(number));
+    }
+  }
+  return true;
+}
+
+// build表中一行大致占用的内存
+static size_t GetRowMemory(const Row &row, const std::string &key) {
+  size_t size = sizeof(Row) + sizeof(SimpleMemHeap) + key.size() + 4 * sizeof(void *);
+  for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+    const Field *field = row.GetField(i);
+    size += sizeof(Field) + sizeof(void *);
+    if (field->GetType() == kTypeChar && !field->IsNull()) {
+      size += field->GetCharLength();
+    }
+  }
+  return size;
+}
+
+void HashJoinOperator::AddBuildRow(const Row &row, std::string key) {
+  memory_ += GetRowMemory(row, key);
+  build_rows_.emplace_back(row);
+  table_.emplace(std::move(key), build_rows_.size() - 1);
+}
+
+bool HashJoinOperator::Spill() {
+  for (int i = 0; i < SPILL_PARTITIONS; i++) {
+    build_files_.push_back(std::make_unique<SpillFile>(buffer_pool_manager_));
+    probe_files_.push_back(std::make_unique<SpillFile>(buffer_pool_manager_));
+  }
+  for (auto &entry : table_) {
+    size_t partition = std::hash<std::string>()(entry.first) % SPILL_PARTITIONS;
+    if (!build_files_[partition]->AppendRow(build_rows_[entry.second])) {
+      return false;
+    }
+  }
+  table_.clear();
+  build_rows_.clear();
+  memory_ = 0;
+  return true;
+}
+
+dberr_t HashJoinOperator::Init() {
+  build_rows_.clear();
+  table_.clear();
+  memory_ = 0;
+  build_files_.clear();
+  probe_files_.clear();
+  partition_ = -1;
+  probe_row_ = nullptr;
+  status_ = left_->Init();
+  if (status_ == DB_SUCCESS) {
+    status_ = right_->Init();
+  }
+  if (status_ != DB_SUCCESS) {
+    return status_;
+  }
+  Operator *build = build_left_ ? left_.get() : right_.get();
+  Operator *probe = build_left_ ? right_.get() : left_.get();
+  const auto &build_keys = build_left_ ? left_keys_ : right_keys_;
+  const auto &probe_keys = build_left_ ? right_keys_ : left_keys_;
+  // 建立build一侧的哈希表，键中有null的行不会与任何行连接
+  std::string key;
+  const Row *row;
+  while ((row = build->Next()) != nullptr) {
+    if (!GetHashKey(*row, build_keys, key)) {
+      continue;
+    }
+    if (IsSpilled()) {
+      size_t partition = std::hash<std::string>()(key) % SPILL_PARTITIONS;
+      if (!build_files_[partition]->AppendRow(*row)) {
+        status_ = DB_FAILED;
+        return status_;
+      }
+      continue;
+    }
+    AddBuildRow(*row, key);
+    // 超出内存预算，两侧都按键的哈希值分区写入临时页，之后逐个分区连接
+    if (memory_ > memory_budget_ && !Spill()) {
+      status_ = DB_FAILED;
+      return status_;
+    }
+  }
+  status_ = build->GetStatus();
+  if (status_ != DB_SUCCESS || !IsSpilled()) {
+    return status_;
+  }
+  while ((row = probe->Next()) != nullptr) {
+    if (!GetHashKey(*row, probe_keys, key)) {
+      continue;
+    }
+    size_t partition = std::hash<std::string>()(key) % SPILL_PARTITIONS;
+    if (!probe_files_[partition]->AppendRow(*row)) {
+      status_ = DB_FAILED;
+      return status_;
+    }
+  }
+  status_ = probe->GetStatus();
+  if (status_ == DB_SUCCESS) {
+    LoadPartition();
+  }
+  return status_;
+}
+
+bool HashJoinOperator::LoadPartition() {
+  table_.clear();
+  build_rows_.clear();
+  const auto &build_keys = build_left_ ? left_keys_ : right_keys_;
+  std::vector<Field> fields;
+  std::string key;
+  while (++partition_ < SPILL_PARTITIONS) {
+    SpillFile *file = build_files_[partition_].get();
+    if (file->GetSize() == 0 || probe_files_[partition_]->GetSize() == 0) {
+      continue;
+    }
+    file->Rewind();
+    while (file->ReadRow(fields)) {
+      Row row(fields);
+      GetHashKey(row, build_keys, key);
+      AddBuildRow(row, key);
+    }
+    probe_files_[partition_]->Rewind();
+    return true;
+  }
+  return false;
+}
+
+const Row *HashJoinOperator::NextProbeRow(std::string &key) {
+  if (!IsSpilled()) {
+    Operator *probe = build_left_ ? right_.get() : left_.get();
+    const auto &probe_keys = build_left_ ? right_keys_ : left_keys_;
+    const Row *row;
+    while ((row = probe->Next()) != nullptr) {
+      if (GetHashKey(*row, probe_keys, key)) {
+        return row;
+      }
+    }
+    status_ = probe->GetStatus();
+    return nullptr;
+  }
+  // 读完当前分区的probe行后，换到下一个分区
+  const auto &probe_keys = build_left_ ? right_keys_ : left_keys_;
+  std::vector<Field> fields;
+  while (partition_ < SPILL_PARTITIONS) {
+    if (probe_files_[partition_]->ReadRow(fields)) {
+      spilled_row_ = std::make_unique<Row>(fields);
+      GetHashKey(*spilled_row_, probe_keys, key);
+      return spilled_row_.get();
+    }
+    if (!LoadPartition()) {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+const Row *HashJoinOperator::Next() {
+  if (status_ != DB_SUCCESS) {
+    return nullptr;
+  }
+  std::string key;
+  while (probe_row_ == nullptr || match_ == match_end_) {
+    probe_row_ = NextProbeRow(key);
+    if (probe_row_ == nullptr) {
+      return nullptr;
+    }
+    auto range = table_.equal_range(key);
+    match_ = range.first;
+    match_end_ = range.second;
+  }
+  const Row &build_row = build_rows_[(match_++)->second];
+  const Row &left = build_left_ ? build_row : *probe_row_;
+  const Row &right = build_left_ ? *probe_row_ : build_row;
+  std::vector<Field> fields;
+  fields.reserve(left.GetFieldCount() + right.GetFieldCount());
+  for (uint32_t i = 0; i < left.GetFieldCount(); i++) {
+    fields.push_back(*left.GetField(i));
+  }
+  for (uint32_t i = 0; i < right.GetFieldCount(); i++) {
+    fields.push_back(*right.GetField(i));
+  }
+  row_ = std::make_unique<Row>(fields);
+  return row_.get();
+}
+
+// 转换为索引列的类型，null或者在该类型中没有相等的值时返回false
+static bool ConvertKeyField(const Field &field, TypeId type, std::vector<Field> &key) {
+  if (field.IsNull() || (field.GetType() == kTypeChar) != (type == kTypeChar)) {
+    return false;
+  }
+  if (field.GetType() == type) {
+    key.push_back(field);
+  } else if (type == kTypeFloat) {
+    key.emplace_back(kTypeFloat, static_cast<float>(field.GetIntData()));
+  } else {
+    float number = field.GetFloatData();
+    if (number != std::floor(number) || std::fabs(number) > INT32_MAX) {
+      return false;
+    }
+    key.emplace_back(kTypeInt, static_cast<int32_t>(number));
+  }
+  return true;
+}
+
+dberr_t IndexJoinOperator::Init() {
+  outer_rows_.clear();
+  inner_rows_.clear();
+  match_outer_.clear();
+  next_ = 0;
+  status_ = outer_->Init();
+  return status_;
+}
+
+bool IndexJoinOperator::NextBatch() {
+  outer_rows_.clear();
+  inner_rows_.clear();
+  match_outer_.clear();
+  next_ = 0;
+  const Row *row;
+  while (outer_rows_.size() < batch_size_ && (row = outer_->Next()) != nullptr) {
+    outer_rows_.emplace_back(*row);
+  }
+  if (outer_rows_.empty()) {
+    status_ = outer_->GetStatus();
+    return false;
+  }
+  // 一批外表行的键一起探查索引，索引内部按键排序，相邻的键共用叶子页
+  auto key_schema = index_info_->GetIndexKeySchema();
+  std::vector<Row> keys;
+  std::vector<size_t> key_outer;
+  std::vector<Field> fields;
+  for (size_t i = 0; i < outer_rows_.size(); i++) {
+    fields.clear();
+    bool valid = true;
+    for (uint32_t k = 0; k < outer_keys_.size() && valid; k++) {
+      valid = ConvertKeyField(*outer_rows_[i].GetField(outer_keys_[k]), key_schema->GetColumn(k)->GetType(), fields);
+    }
+    if (valid) {
+      keys.emplace_back(fields);
+      key_outer.push_back(i);
+    }
+  }
+  std::vector<RowId> rids;
+  status_ = index_info_->GetIndex()->ScanKeys(keys, rids, nullptr);
+  if (status_ != DB_SUCCESS) {
+    return false;
+  }
+  // 按row id的顺序取回内表的行，同一页上的行只读一次页
+  std::vector<std::pair<int64_t, size_t>> found;
+  for (size_t i = 0; i < rids.size(); i++) {
+    if (rids[i].Get() != INVALID_ROWID.Get()) {
+      found.emplace_back(rids[i].Get(), key_outer[i]);
+    }
+  }
+  std::sort(found.begin(), found.end());
+  for (size_t i = 0; i < found.size(); i++) {
+    inner_rows_.emplace_back(RowId(found[i].first));
+    Row &inner = inner_rows_.back();
+    if (!inner_heap_->GetTuple(&inner, nullptr)) {
+      status_ = DB_FAILED;
+      return false;
+    }
+    if (inner_filter_ != nullptr && !inner_filter_(inner)) {
+      inner_rows_.pop_back();
+      continue;
+    }
+    match_outer_.push_back(found[i].second);
+  }
+  return true;
+}
+
+const Row *IndexJoinOperator::Next() {
+  while (next_ >= inner_rows_.size()) {
+    if (status_ != DB_SUCCESS || !NextBatch()) {
+      return nullptr;
+    }
+  }
+  const Row &outer = outer_rows_[match_outer_[next_]];
+  const Row &inner = inner_rows_[next_++];
+  std::vector<Field> fields;
+  fields.reserve(outer.GetFieldCount() + inner.GetFieldCount());
+  for (uint32_t i = 0; i < outer.GetFieldCount(); i++) {
+    fields.push_back(*outer.GetField(i));
+  }
+  for (uint32_t i = 0; i < inner.GetFieldCount(); i++) {
+    fields.push_back(*inner.GetField(i));
+  }
+  row_ = std::make_unique<Row>(fields);
+  return row_.get();
+}
+
+// 分区次数的上限，超过后不再分区，所有的组都留在内存中
+static constexpr int MAX_SPILL_DEPTH = 5;
+
+// 第depth次分区使用哈希值的不同位
+static size_t GetPartition(size_t hash, int depth) {
+  return (hash >> (16 + 8 * depth)) % SPILL_PARTITIONS;
+}
+
+void HashAggregateOperator::EncodeKey(const Row &row, std::string &key) const {
+  key.clear();
+  for (auto column : group_columns_) {
+    const Field *field = row.GetField(column);
+    key.push_back(static_cast<char>(field->GetType()));
+    key.push_back(field->IsNull());
+    if (field->IsNull()) {
+      continue;
+    }
+    if (field->GetType() == kTypeChar) {
+      uint32_t len = field->GetCharLength();
+      key.append(reinterpret_cast<const char *>(&len), sizeof(len));
+      key.append(field->GetData(), len);
+    } else if (field->GetType() == kTypeInt) {
+      int32_t value = field->GetIntData();
+      key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    } else {
+      float value = field->GetFloatData();
+      key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+  }
+}
+
+HashAggregateOperator::Group *HashAggregateOperator::FindGroup(size_t hash, const std::string &key) {
+  size_t mask = slots_.size() - 1;
+  size_t slot = hash & mask;
+  // 线性探查
+  for (; slots_[slot] >= 0; slot = (slot + 1) & mask) {
+    Group &group = groups_[slots_[slot]];
+    if (group.hash == hash && group.key_size == key.size() && memcmp(group.key, key.data(), key.size()) == 0) {
+      return &group;
+    }
+  }
+  size_t memory = arena_.GetAllocatedSize() + slots_.size() * sizeof(int32_t) + groups_.size() * sizeof(Group);
+  if (!group_columns_.empty() && depth_ < MAX_SPILL_DEPTH && memory > memory_budget_) {
+    return nullptr;
+  }
+  // 新的组，键与聚集的状态都放在arena中
+  Group group;
+  group.hash = hash;
+  group.key_size = key.size();
+  char *buf = static_cast<char *>(arena_.Allocate(key.size()));
+  memcpy(buf, key.data(), key.size());
+  group.key = buf;
+  group.states = static_cast<AggregateState *>(arena_.Allocate(sizeof(AggregateState) * aggregates_.size()));
+  for (size_t k = 0; k < aggregates_.size(); k++) {
+    group.states[k] = {0, 0, 0};
+  }
+  slots_[slot] = groups_.size();
+  groups_.push_back(group);
+  if (groups_.size() * 2 > slots_.size()) {
+    // 负载超过一半时加倍，重新放置所有的组
+    slots_.assign(slots_.size() * 2, -1);
+    mask = slots_.size() - 1;
+    for (size_t i = 0; i < groups_.size(); i++) {
+      for (slot = groups_[i].hash & mask; slots_[slot] >= 0; slot = (slot + 1) & mask) {
+      }
+      slots_[slot] = i;
+    }
+  }
+  return &groups_.back();
+}
+
+bool HashAggregateOperator::Accumulate(const Row &row) {
+  std::string key;
+  EncodeKey(row, key);
+  size_t hash = std::hash<std::string>()(key);
+  Group *group = FindGroup(hash, key);
+  if (group == nullptr) {
+    // 超出内存预算，不在内存中的组的行写入分区
+    spilled_ = true;
+    if (partitions_.empty()) {
+      for (int i = 0; i < SPILL_PARTITIONS; i++) {
+        partitions_.push_back(std::make_unique<SpillFile>(buffer_pool_manager_));
+      }
+    }
+    return partitions_[GetPartition(hash, depth_)]->AppendRow(row);
+  }
+  for (size_t k = 0; k < aggregates_.size(); k++) {
+    AggregateState &state = group->states[k];
+    if (aggregates_[k].second < 0) {
+      state.count++;
+      continue;
+    }
+    const Field *field = row.GetField(aggregates_[k].second);
+    if (field->IsNull()) {
+      continue;
+    }
+    if (aggregates_[k].first == AggregateType::kCount || field->GetType() == kTypeChar) {
+      state.count++;
+      continue;
+    }
+    input_types_[k] = field->GetType();
+    if (field->GetType() == kTypeInt) {
+      // 整数列按int64累加，避免转成浮点数后丢失精度
+      int64_t value = field->GetIntData();
+      switch (aggregates_[k].first) {
+        case AggregateType::kMin:
+          state.integer = state.count == 0 ? value : std::min(state.integer, value);
+          break;
+        case AggregateType::kMax:
+          state.integer = state.count == 0 ? value : std::max(state.integer, value);
+          break;
+        default:
+          if (__builtin_add_overflow(state.integer, value, &state.integer)) {
+            return false;
+          }
+          break;
+      }
+      state.count++;
+      continue;
+    }
+    double value = field->GetFloatData();
+    switch (aggregates_[k].first) {
+      case AggregateType::kMin:
+        state.value = state.count == 0 ? value : std::min(state.value, value);
+        break;
+      case AggregateType::kMax:
+        state.value = state.count == 0 ? value : std::max(state.value, value);
+        break;
+      default:
+        state.value += value;
+        break;
+    }
+    state.count++;
+  }
+  return true;
+}
+
+void HashAggregateOperator::Clear() {
+  arena_.Clear();
+  slots_.assign(1024, -1);
+  groups_.clear();
+  partitions_.clear();
+  next_ = 0;
+}
+
+dberr_t HashAggregateOperator::Init() {
+  Clear();
+  pending_.clear();
+  input_types_.assign(aggregates_.size(), kTypeInvalid);
+  depth_ = 0;
+  spilled_ = false;
+  status_ = child_->Init();
+  if (status_ != DB_SUCCESS) {
+    return status_;
+  }
+  const Row *row;
+  while ((row = child_->Next()) != nullptr) {
+    if (!Accumulate(*row)) {
+      status_ = DB_FAILED;
+      return status_;
+    }
+  }
+  status_ = child_->GetStatus();
+  if (status_ == DB_SUCCESS && group_columns_.empty() && groups_.empty()) {
+    // 没有group by时，即使没有行也输出一行
+    FindGroup(std::hash<std::string>()(""), "");
+  }
+  return status_;
+}
+
+bool HashAggregateOperator::NextPartition() {
+  for (auto &partition : partitions_) {
+    if (partition->GetSize() > 0) {
+      pending_.emplace_back(std::move(partition), depth_ + 1);
+    }
+  }
+  if (pending_.empty()) {
+    return false;
+  }
+  Clear();
+  std::unique_ptr<SpillFile> file = std::move(pending_.front().first);
+  depth_ = pending_.front().second;
+  pending_.pop_front();
+  file->Rewind();
+  std::vector<Field> fields;
+  while (file->ReadRow(fields)) {
+    Row row(fields);
+    if (!Accumulate(row)) {
+      status_ = DB_FAILED;
+      return false;
+    }
+  }
+  return true;
+}
+
+const Row *HashAggregateOperator::Next() {
+  while (next_ >= groups_.size()) {
+    if (status_ != DB_SUCCESS || !NextPartition()) {
+      return nullptr;
+    }
+  }
+  const Group &group = groups_[next_++];
+  // 从键中解码出分组列的值
+  std::vector<Field> fields;
+  fields.reserve(group_columns_.size() + aggregates_.size());
+  const char *pos = group.key;
+  for (size_t i = 0; i < group_columns_.size(); i++) {
+    auto type = static_cast<TypeId>(pos[0]);
+    bool is_null = pos[1];
+    pos += 2;
+    if (is_null) {
+      fields.emplace_back(type);
+    } else if (type == kTypeChar) {
+      uint32_t len;
+      memcpy(&len, pos, sizeof(len));
+      fields.emplace_back(kTypeChar, const_cast<char *>(pos + sizeof(len)), len, true);
+      pos += sizeof(len) + len;
+    } else if (type == kTypeInt) {
+      int32_t value;
+      memcpy(&value, pos, sizeof(value));
+      fields.emplace_back(kTypeInt, value);
+      pos += sizeof(value);
+    } else {
+      float value;
+      memcpy(&value, pos, sizeof(value));
+      fields.emplace_back(kTypeFloat, value);
+      pos += sizeof(value);
+    }
+  }
+  for (size_t k = 0; k < aggregates_.size(); k++) {
+    const AggregateState &state = group.states[k];
+    AggregateType type = aggregates_[k].first;
+    // 整数列的SUM、MIN、MAX仍是整数，AVG总是浮点数
+    bool is_int = input_types_[k] == kTypeInt && type != AggregateType::kAvg;
+    if (type == AggregateType::kCount) {
+      fields.emplace_back(kTypeInt, static_cast<int32_t>(state.count));
+    } else if (state.count == 0) {
+      fields.emplace_back(is_int ? kTypeInt : kTypeFloat);
+    } else if (is_int) {
+      if (state.integer < INT32_MIN || state.integer > INT32_MAX) {
+        // 和超出了int的范围
+        status_ = DB_FAILED;
+        return nullptr;
+      }
+      fields.emplace_back(kTypeInt, static_cast<int32_t>(state.integer));
+    } else if (input_types_[k] == kTypeInt) {
+      fields.emplace_back(kTypeFloat, static_cast<float>(static_cast<double>(state.integer) / state.count));
+    } else if (type == AggregateType::kAvg) {
+      fields.emplace_back(kTypeFloat, static_cast<float>(state.value / state.count));
+    } else {
+      fields.emplace_back(kTypeFloat, static_cast<float>(state.value));
+    }
+  }
+  row_ = std::make_unique<Row>(fields);
+  return row_.get();
+}
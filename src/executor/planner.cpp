@@ -0,0 +1,289 @@
+#include "executor/planner.h"
+#include <algorithm>
+#include <limits>
+
+// 没有更多信息时使用的选择率
+static constexpr double DEFAULT_EQUAL_SELECTIVITY = 0.1;
+static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3;
+static constexpr double DEFAULT_NULL_SELECTIVITY = 0.1;
+
+Planner::Planner(TableInfo *table_info, std::vector<IndexInfo *> indexes)
+    : table_info_(table_info), indexes_(std::move(indexes)) {
+  counts_known_ = table_info_->GetTableHeap()->GetCounts(row_count_, page_count_);
+}
+
+std::vector<uint32_t> Planner::GetKeyColumns(IndexInfo *index_info) const {
+  auto key_schema = index_info->GetIndexKeySchema();
+  std::vector<uint32_t> key_columns(key_schema->GetColumnCount());
+  for (uint32_t i = 0; i < key_columns.size(); i++) {
+    table_info_->GetSchema()->GetColumnIndex(key_schema->GetColumn(i)->GetName(), key_columns[i]);
+  }
+  return key_columns;
+}
+
+bool Planner::IsDistinct(uint32_t column) const {
+  if (table_info_->GetSchema()->GetColumn(column)->IsUnique()) {
+    return true;
+  }
+  // 索引的键都是唯一的，单列索引的列上没有重复的值
+  return std::any_of(indexes_.begin(), indexes_.end(), [&](IndexInfo *index_info) {
+    return GetKeyColumns(index_info) == std::vector<uint32_t>{column};
+  });
+}
+
+double Planner::EstimateSelectivity(const ConditionList &conditions, uint32_t i) const {
+  CompareOp op = ParseCompareOp(conditions.compare[i]);
+  auto statistics = table_info_->GetStatistics();
+  double null_fraction = DEFAULT_NULL_SELECTIVITY;
+  if (statistics != nullptr && conditions.column_index[i] < statistics->columns.size()) {
+    null_fraction = statistics->columns[conditions.column_index[i]].null_fraction;
+  }
+  if (op == CompareOp::kIsNull) {
+    return null_fraction;
+  }
+  if (op == CompareOp::kNotNull) {
+    return 1 - null_fraction;
+  }
+  // 与null或者无法转换的常量比较，没有满足的行
+  const Field &constant = conditions.to_be_compared[i];
+  if (constant.IsNull()) {
+    return 0;
+  }
+  // 分析过的表按直方图与最常见值估计
+  if (statistics != nullptr && conditions.column_index[i] < statistics->columns.size()) {
+    const ColumnStatistics &column = statistics->columns[conditions.column_index[i]];
+    double not_null = 1 - column.null_fraction;
+    switch (op) {
+      case CompareOp::kEqual:
+        return column.EstimateEqual(constant);
+      case CompareOp::kNotEqual:
+        return std::max(not_null - column.EstimateEqual(constant), 0.0);
+      case CompareOp::kLess:
+        return column.EstimateLess(constant, false);
+      case CompareOp::kLessEqual:
+        return column.EstimateLess(constant, true);
+      case CompareOp::kGreater:
+        return std::max(not_null - column.EstimateLess(constant, true), 0.0);
+      default:
+        return std::max(not_null - column.EstimateLess(constant, false), 0.0);
+    }
+  }
+  double equal = IsDistinct(conditions.column_index[i])
+                     ? 1.0 / std::max<uint64_t>(row_count_, 1)
+                     : DEFAULT_EQUAL_SELECTIVITY;
+  switch (op) {
+    case CompareOp::kEqual:
+      return equal;
+    case CompareOp::kNotEqual:
+      return 1 - equal;
+    default:
+      return DEFAULT_RANGE_SELECTIVITY;
+  }
+}
+
+double Planner::EstimateSelectivity(const ConditionList &conditions) const {
+  // 与条件的结合顺序相同，从最下面的一个开始
+  size_t n = conditions.pairs.size();
+  double selectivity = EstimateSelectivity(conditions, n - 1);
+  for (int k = static_cast<int>(n) - 2; k >= 0; k--) {
+    double single = EstimateSelectivity(conditions, k);
+    if (!strcmp(conditions.connector[k], "and")) {
+      selectivity *= single;
+    } else {
+      selectivity = selectivity + single - selectivity * single;
+    }
+  }
+  return selectivity;
+}
+
+double Planner::GetSeqScanCost() const {
+  if (!counts_known_) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return page_count_ * SEQ_PAGE_COST + row_count_ * CPU_TUPLE_COST;
+}
+
+double Planner::GetIndexScanCost(IndexInfo *index_info, double probes, double matches) const {
+  double lookup_pages = index_info->GetIndex()->GetLookupPages();
+  return (probes * lookup_pages + matches) * RANDOM_PAGE_COST + matches * CPU_TUPLE_COST;
+}
+
+AccessPath Planner::ChooseAccessPath(const ConditionList &conditions) const {
+  AccessPath best;
+  size_t n = conditions.pairs.size();
+  best.rows = row_count_ * EstimateSelectivity(conditions);
+  best.cost = GetSeqScanCost();
+  bool all_and = std::all_of(conditions.connector.begin(), conditions.connector.end(),
+                             [](const char *connector) { return !strcmp(connector, "and"); });
+  bool all_or = std::all_of(conditions.connector.begin(), conditions.connector.end(),
+                            [](const char *connector) { return !strcmp(connector, "or"); });
+  std::vector<CompareOp> ops(n);
+  for (uint32_t i = 0; i < n; i++) {
+    ops[i] = ParseCompareOp(conditions.compare[i]);
+  }
+
+  if (all_and) {
+    // 每一列上的等值条件，同一列上的常量不相等时结果为空
+    std::vector<int> equal_condition(table_info_->GetSchema()->GetColumnCount(), -1);
+    for (uint32_t i = 0; i < n; i++) {
+      if (ops[i] == CompareOp::kIsNull || ops[i] == CompareOp::kNotNull) {
+        continue;
+      }
+      const Field &constant = conditions.to_be_compared[i];
+      int &previous = equal_condition[conditions.column_index[i]];
+      if (constant.IsNull() || (ops[i] == CompareOp::kEqual && previous >= 0 &&
+                                conditions.to_be_compared[previous].CompareEquals(constant) != kTrue)) {
+        best.empty = true;
+        best.rows = 0;
+        best.cost = 0;
+        return best;
+      }
+      if (ops[i] == CompareOp::kEqual) {
+        previous = static_cast<int>(i);
+      }
+    }
+    // 键的每一列都有等值条件的索引，各探查一次
+    for (auto index_info : indexes_) {
+      std::vector<uint32_t> key_conditions;
+      for (auto column : GetKeyColumns(index_info)) {
+        if (equal_condition[column] < 0) {
+          break;
+        }
+        key_conditions.push_back(equal_condition[column]);
+      }
+      if (key_conditions.size() != index_info->GetIndexKeySchema()->GetColumnCount()) {
+        continue;
+      }
+      double matches = counts_known_ ? std::min(1.0, best.rows) : 1.0;
+      double cost = GetIndexScanCost(index_info, 1, matches);
+      if (cost < best.cost) {
+        best.index = index_info;
+        best.key_conditions = std::move(key_conditions);
+        best.cost = cost;
+      }
+    }
+    // 有序的单列索引，从最紧的下界扫描到最紧的上界
+    for (auto index_info : indexes_) {
+      std::vector<uint32_t> key_columns = GetKeyColumns(index_info);
+      if (index_info->GetIndexType() == kIndexHash || key_columns.size() != 1) {
+        continue;
+      }
+      uint32_t length = table_info_->GetSchema()->GetColumn(key_columns[0])->GetLength();
+      int low = -1;
+      int high = -1;
+      for (uint32_t i = 0; i < n; i++) {
+        const Field &constant = conditions.to_be_compared[i];
+        // 比键更长的字符串不能作为索引的键
+        if (conditions.column_index[i] != key_columns[0] ||
+            (constant.GetType() == kTypeChar && constant.GetLength() > length)) {
+          continue;
+        }
+        if (ops[i] == CompareOp::kGreater || ops[i] == CompareOp::kGreaterEqual) {
+          if (low < 0 || constant.CompareGreaterThan(conditions.to_be_compared[low]) == kTrue) {
+            low = static_cast<int>(i);
+          }
+        } else if (ops[i] == CompareOp::kLess || ops[i] == CompareOp::kLessEqual) {
+          if (high < 0 || constant.CompareLessThan(conditions.to_be_compared[high]) == kTrue) {
+            high = static_cast<int>(i);
+          }
+        }
+      }
+      if (low < 0 && high < 0) {
+        continue;
+      }
+      // 同一列上的两个界不是独立的，分析过的表取两界之间的部分
+      double selectivity = 1;
+      for (int bound : {low, high}) {
+        if (bound >= 0) {
+          selectivity *= EstimateSelectivity(conditions, bound);
+        }
+      }
+      auto statistics = table_info_->GetStatistics();
+      if (low >= 0 && high >= 0 && statistics != nullptr && key_columns[0] < statistics->columns.size()) {
+        double not_null = 1 - statistics->columns[key_columns[0]].null_fraction;
+        selectivity = std::max(EstimateSelectivity(conditions, low) + EstimateSelectivity(conditions, high) - not_null,
+                               0.0);
+      }
+      double cost = GetIndexScanCost(index_info, 1, row_count_ * selectivity);
+      if (cost < best.cost) {
+        best.index = index_info;
+        best.key_conditions.clear();
+        best.range = true;
+        best.low_condition = low;
+        best.high_condition = high;
+        best.cost = cost;
+      }
+    }
+    return best;
+  }
+
+  if (all_or && n >= 2) {
+    // 同一列上用or连接的等值条件，由这一列上的单列索引批量探查
+    for (uint32_t i = 0; i < n; i++) {
+      if (ops[i] != CompareOp::kEqual || conditions.column_index[i] != conditions.column_index[0]) {
+        return best;
+      }
+    }
+    std::vector<uint32_t> key_conditions;
+    for (uint32_t i = 0; i < n; i++) {
+      if (!conditions.to_be_compared[i].IsNull()) {
+        key_conditions.push_back(i);
+      }
+    }
+    for (auto index_info : indexes_) {
+      if (GetKeyColumns(index_info) != std::vector<uint32_t>{conditions.column_index[0]}) {
+        continue;
+      }
+      double probes = key_conditions.size();
+      double cost = GetIndexScanCost(index_info, probes, probes);
+      if (cost < best.cost) {
+        best.index = index_info;
+        best.key_conditions = key_conditions;
+        best.in_list = true;
+        best.cost = cost;
+      }
+    }
+  }
+  return best;
+}
+
+IndexInfo *Planner::ChooseJoinIndex(const std::vector<uint32_t> &key_columns, double outer_rows, double inner_cost,
+                                    std::vector<uint32_t> &key_order) const {
+  if (outer_rows < 0 && counts_known_) {
+    return nullptr;
+  }
+  // 同一列出现两次时，索引只能检查其中一个等值条件
+  std::vector<uint32_t> sorted(key_columns);
+  std::sort(sorted.begin(), sorted.end());
+  if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+    return nullptr;
+  }
+  // 每个外表行探查一次索引，索引唯一，至多取回一行。表的大小未知时总是使用索引
+  IndexInfo *best{nullptr};
+  double best_cost = counts_known_ ? inner_cost : std::numeric_limits<double>::infinity();
+  for (auto index_info : indexes_) {
+    std::vector<uint32_t> index_columns = GetKeyColumns(index_info);
+    if (index_columns.size() != key_columns.size()) {
+      continue;
+    }
+    std::vector<uint32_t> order;
+    for (auto column : index_columns) {
+      auto it = std::find(key_columns.begin(), key_columns.end(), column);
+      if (it == key_columns.end()) {
+        break;
+      }
+      order.push_back(it - key_columns.begin());
+    }
+    if (order.size() != key_columns.size()) {
+      continue;
+    }
+    double probes = std::max(outer_rows, 0.0);
+    double cost = GetIndexScanCost(index_info, probes, probes);
+    if (cost < best_cost) {
+      best = index_info;
+      best_cost = cost;
+      key_order = std::move(order);
+    }
+  }
+  return best;
+}
@@ -0,0 +1,169 @@
+#include "executor/predicate.h"
+
+CompareOp ParseCompareOp(const char *op) {
+  if (!strcmp(op, "<>")) {
+    return CompareOp::kNotEqual;
+  } else if (!strcmp(op, "<")) {
+    return CompareOp::kLess;
+  } else if (!strcmp(op, "<=")) {
+    return CompareOp::kLessEqual;
+  } else if (!strcmp(op, ">")) {
+    return CompareOp::kGreater;
+  } else if (!strcmp(op, ">=")) {
+    return CompareOp::kGreaterEqual;
+  } else if (!strcmp(op, "is")) {
+    return CompareOp::kIsNull;
+  } else if (!strcmp(op, "not")) {
+    return CompareOp::kNotNull;
+  }
+  return CompareOp::kEqual;
+}
+
+template <typename T, CompareOp op>
+bool Predicate::NumberKernel(const Predicate &predicate, const Field &field) {
+  if constexpr (std::is_same<T, int32_t>::value) {
+    return ApplyCompare<op, float>(static_cast<float>(field.GetIntData()), predicate.number_);
+  } else {
+    return ApplyCompare<op, float>(field.GetFloatData(), predicate.number_);
+  }
+}
+
+template <CompareOp op>
+bool Predicate::IntKernel(const Predicate &predicate, const Field &field) {
+  return ApplyCompare<op, int32_t>(field.GetIntData(), predicate.integer_);
+}
+
+template <CompareOp op>
+bool Predicate::TextKernel(const Predicate &predicate, const Field &field) {
+  const std::string &text = predicate.text_;
+  return ApplyCompare<op, int>(CompareChars(field.GetData(), field.GetCharLength(), text.data(), text.size()), 0);
+}
+
+std::unique_ptr<Predicate> Predicate::MakeNumberCompare(uint32_t column, TypeId column_type, CompareOp op,
+                                                        float number) {
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kNumber));
+  predicate->column_ = column;
+  predicate->op_ = op;
+  predicate->number_ = number;
+  predicate->kernel_ = DispatchCompareOp(op, [column_type](auto constant) -> Kernel {
+    if (column_type == kTypeInt) {
+      return &NumberKernel<int32_t, decltype(constant)::value>;
+    }
+    return &NumberKernel<float, decltype(constant)::value>;
+  });
+  return predicate;
+}
+
+std::unique_ptr<Predicate> Predicate::MakeIntCompare(uint32_t column, CompareOp op, int32_t integer) {
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kNumber));
+  predicate->column_ = column;
+  predicate->op_ = op;
+  predicate->integer_ = integer;
+  predicate->kernel_ =
+      DispatchCompareOp(op, [](auto constant) -> Kernel { return &IntKernel<decltype(constant)::value>; });
+  return predicate;
+}
+
+std::unique_ptr<Predicate> Predicate::MakeTextCompare(uint32_t column, CompareOp op, std::string text) {
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kText));
+  predicate->column_ = column;
+  predicate->op_ = op;
+  predicate->text_ = std::move(text);
+  predicate->kernel_ =
+      DispatchCompareOp(op, [](auto constant) -> Kernel { return &TextKernel<decltype(constant)::value>; });
+  return predicate;
+}
+
+template <typename L, typename R, CompareOp op>
+bool Predicate::ColumnsNumberKernel(const Field &left, const Field &right) {
+  auto value = [](const Field &field, auto type) {
+    if constexpr (std::is_same<decltype(type), int32_t>::value) {
+      return field.GetIntData();
+    } else {
+      return field.GetFloatData();
+    }
+  };
+  if constexpr (std::is_same<L, int32_t>::value && std::is_same<R, int32_t>::value) {
+    return ApplyCompare<op, int32_t>(left.GetIntData(), right.GetIntData());
+  } else {
+    return ApplyCompare<op, float>(static_cast<float>(value(left, L())), static_cast<float>(value(right, R())));
+  }
+}
+
+template <CompareOp op>
+bool Predicate::ColumnsTextKernel(const Field &left, const Field &right) {
+  return ApplyCompare<op, int>(
+      CompareChars(left.GetData(), left.GetCharLength(), right.GetData(), right.GetCharLength()), 0);
+}
+
+std::unique_ptr<Predicate> Predicate::MakeColumnCompare(uint32_t left, TypeId left_type, uint32_t right,
+                                                        TypeId right_type, CompareOp op) {
+  if ((left_type == kTypeChar) != (right_type == kTypeChar)) {
+    return MakeFalse();
+  }
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kColumns));
+  predicate->column_ = left;
+  predicate->other_column_ = right;
+  predicate->op_ = op;
+  predicate->columns_kernel_ = DispatchCompareOp(op, [left_type, right_type](auto constant) -> ColumnsKernel {
+    constexpr CompareOp kOp = decltype(constant)::value;
+    if (left_type == kTypeChar) {
+      return &ColumnsTextKernel<kOp>;
+    }
+    if (left_type == kTypeInt) {
+      return right_type == kTypeInt ? &ColumnsNumberKernel<int32_t, int32_t, kOp>
+                                     : &ColumnsNumberKernel<int32_t, float, kOp>;
+    }
+    return right_type == kTypeInt ? &ColumnsNumberKernel<float, int32_t, kOp>
+                                   : &ColumnsNumberKernel<float, float, kOp>;
+  });
+  return predicate;
+}
+
+std::unique_ptr<Predicate> Predicate::MakeNullTest(uint32_t column, bool is_null) {
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kNullTest));
+  predicate->column_ = column;
+  predicate->op_ = is_null ? CompareOp::kIsNull : CompareOp::kNotNull;
+  return predicate;
+}
+
+std::unique_ptr<Predicate> Predicate::MakeFalse() { return std::unique_ptr<Predicate>(new Predicate(Kind::kFalse)); }
+
+std::unique_ptr<Predicate> Predicate::MakeAnd(std::unique_ptr<Predicate> left, std::unique_ptr<Predicate> right) {
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kAnd));
+  predicate->left_ = std::move(left);
+  predicate->right_ = std::move(right);
+  return predicate;
+}
+
+std::unique_ptr<Predicate> Predicate::MakeOr(std::unique_ptr<Predicate> left, std::unique_ptr<Predicate> right) {
+  std::unique_ptr<Predicate> predicate(new Predicate(Kind::kOr));
+  predicate->left_ = std::move(left);
+  predicate->right_ = std::move(right);
+  return predicate;
+}
+
+bool Predicate::Evaluate(const Row &row) const {
+  switch (kind_) {
+    case Kind::kAnd:
+      return left_->Evaluate(row) && right_->Evaluate(row);
+    case Kind::kOr:
+      return left_->Evaluate(row) || right_->Evaluate(row);
+    case Kind::kFalse:
+      return false;
+    default:
+      break;
+  }
+  Field *field = row.GetField(column_);
+  if (kind_ == Kind::kNullTest) {
+    return field->IsNull() == (op_ == CompareOp::kIsNull);
+  }
+  if (field->IsNull()) {
+    return false;
+  }
+  if (kind_ == Kind::kColumns) {
+    Field *other = row.GetField(other_column_);
+    return !other->IsNull() && columns_kernel_(*field, *other);
+  }
+  return kernel_(*this, *field);
+}
@@ -0,0 +1,317 @@
+#include "executor/vector_operators.h"
+#include <algorithm>
+#include <cmath>
+
+/*****************************************************************************
+ * SCAN
+ *****************************************************************************/
+dberr_t VectorScanOperator::Init() {
+  slots_.assign(schema_->GetColumnCount(), -1);
+  batch_.columns.clear();
+  for (uint32_t i = 0; i < column_ids_.size(); i++) {
+    slots_[column_ids_[i]] = static_cast<int>(i);
+    batch_.columns.emplace_back(schema_->GetColumn(column_ids_[i])->GetType());
+  }
+  next_page_id_ = table_heap_->GetFirstPageId();
+  return DB_SUCCESS;
+}
+
+/*
+ * Same layout as Row::SerializeTo: the field count, a null bitmap of one int per
+ * 8 fields where a set bit marks a present field, then the present fields.
+ */
+void VectorScanOperator::DecodeTuple(const RowId &rid, const char *data) {
+  uint32_t field_count = MACH_READ_UINT32(data);
+  const char *null_map = data + sizeof(uint32_t);
+  const char *pos = null_map + sizeof(uint32_t) * ((field_count + 7) / 8);
+  for (uint32_t i = 0; i < field_count; i++) {
+    int slot = slots_[i];
+    bool is_null = ((MACH_READ_FROM(int, null_map + sizeof(int) * (i / 8)) >> (i % 8)) & 1) == 0;
+    if (is_null) {
+      if (slot >= 0) {
+        batch_.columns[slot].AppendNull();
+      }
+      continue;
+    }
+    switch (schema_->GetColumn(i)->GetType()) {
+      case kTypeInt:
+        if (slot >= 0) {
+          batch_.columns[slot].AppendInt(MACH_READ_FROM(int32_t, pos));
+        }
+        pos += sizeof(int32_t);
+        break;
+      case kTypeFloat:
+        if (slot >= 0) {
+          batch_.columns[slot].AppendFloat(MACH_READ_FROM(float, pos));
+        }
+        pos += sizeof(float);
+        break;
+      default: {
+        uint32_t len = MACH_READ_UINT32(pos);
+        if (slot >= 0) {
+          batch_.columns[slot].AppendChar(pos + sizeof(uint32_t), len);
+        }
+        pos += sizeof(uint32_t) + len;
+        break;
+      }
+    }
+  }
+  batch_.row_ids.push_back(rid);
+}
+
+VectorBatch *VectorScanOperator::NextBatch() {
+  batch_.Clear();
+  while (next_page_id_ != INVALID_PAGE_ID && batch_.GetSize() < VECTOR_BATCH_SIZE) {
+    next_page_id_ =
+        table_heap_->ScanPage(next_page_id_, [this](const RowId &rid, const char *data) { DecodeTuple(rid, data); });
+  }
+  if (batch_.GetSize() == 0) {
+    return nullptr;
+  }
+  batch_.SelectAll();
+  return &batch_;
+}
+
+/*****************************************************************************
+ * FILTER
+ *****************************************************************************/
+// match[j] = cmp(i) for each selected row i, false for nulls
+template <typename Cmp>
+static void SelectValues(const ColumnVector &column, const std::vector<uint32_t> &selection,
+                         std::vector<uint8_t> &match, Cmp &&cmp) {
+  for (size_t j = 0; j < selection.size(); j++) {
+    uint32_t i = selection[j];
+    match[j] = !column.IsNull(i) && cmp(i);
+  }
+}
+
+// 值转换为常量的类型C之后比较
+template <typename T, typename C>
+static void FilterNumbers(const T *values, const ColumnVector &column, const std::vector<uint32_t> &selection,
+                          CompareOp op, C number, std::vector<uint8_t> &match) {
+  // 按运算符选出一个特化的比较，循环内没有分支
+  DispatchCompareOp(op, [&](auto constant) {
+    SelectValues(column, selection, match, [=](uint32_t i) {
+      return ApplyCompare<decltype(constant)::value, C>(static_cast<C>(values[i]), number);
+    });
+  });
+}
+
+static void FilterTexts(const ColumnVector &column, const std::vector<uint32_t> &selection, CompareOp op,
+                         const std::string &text, std::vector<uint8_t> &match) {
+  DispatchCompareOp(op, [&](auto constant) {
+    SelectValues(column, selection, match, [&](uint32_t i) {
+      int cmp = CompareChars(column.GetChars(i), column.GetCharLength(i), text.data(), text.size());
+      return ApplyCompare<decltype(constant)::value, int>(cmp, 0);
+    });
+  });
+}
+
+void VectorFilterOperator::Evaluate(const VectorPredicate &predicate, const VectorBatch &batch,
+                                    std::vector<uint8_t> &match) const {
+  const ColumnVector &column = batch.columns[predicate.column];
+  const auto &selection = batch.selection;
+  match.assign(selection.size(), 0);
+  if (predicate.op == CompareOp::kIsNull || predicate.op == CompareOp::kNotNull) {
+    bool want_null = predicate.op == CompareOp::kIsNull;
+    for (size_t j = 0; j < selection.size(); j++) {
+      match[j] = column.IsNull(selection[j]) == want_null;
+    }
+    return;
+  }
+  if (predicate.numeric) {
+    if (column.GetType() == kTypeFloat) {
+      FilterNumbers(column.GetFloats(), column, selection, predicate.op, predicate.number, match);
+    } else if (column.GetType() == kTypeInt && predicate.integral) {
+      FilterNumbers(column.GetInts(), column, selection, predicate.op, predicate.integer, match);
+    } else if (column.GetType() == kTypeInt) {
+      FilterNumbers(column.GetInts(), column, selection, predicate.op, predicate.number, match);
+    }
+    return;
+  }
+  if (column.GetType() != kTypeChar) {
+    return;
+  }
+  FilterTexts(column, selection, predicate.op, predicate.text, match);
+}
+
+VectorBatch *VectorFilterOperator::NextBatch() {
+  VectorBatch *batch;
+  while ((batch = child_->NextBatch()) != nullptr) {
+    Evaluate(predicates_[0], *batch, result_);
+    for (size_t k = 1; k < predicates_.size(); k++) {
+      Evaluate(predicates_[k], *batch, match_);
+      if (and_connectors_[k - 1]) {
+        for (size_t j = 0; j < result_.size(); j++) {
+          result_[j] &= match_[j];
+        }
+      } else {
+        for (size_t j = 0; j < result_.size(); j++) {
+          result_[j] |= match_[j];
+        }
+      }
+    }
+    // 保留满足条件的行
+    auto &selection = batch->selection;
+    size_t count = 0;
+    for (size_t j = 0; j < selection.size(); j++) {
+      selection[count] = selection[j];
+      count += result_[j];
+    }
+    selection.resize(count);
+    if (count > 0) {
+      return batch;
+    }
+  }
+  status_ = child_->GetStatus();
+  return nullptr;
+}
+
+/*****************************************************************************
+ * PROJECTION
+ *****************************************************************************/
+VectorBatch *VectorProjectionOperator::NextBatch() {
+  VectorBatch *input = child_->NextBatch();
+  if (input == nullptr) {
+    status_ = child_->GetStatus();
+    return nullptr;
+  }
+  if (batch_.columns.empty()) {
+    for (auto column : columns_) {
+      batch_.columns.emplace_back(input->columns[column].GetType());
+    }
+  }
+  batch_.Clear();
+  for (uint32_t k = 0; k < columns_.size(); k++) {
+    batch_.columns[k].Gather(input->columns[columns_[k]], input->selection);
+  }
+  for (auto i : input->selection) {
+    batch_.row_ids.push_back(input->row_ids[i]);
+  }
+  batch_.SelectAll();
+  return &batch_;
+}
+
+/*****************************************************************************
+ * AGGREGATE
+ *****************************************************************************/
+dberr_t VectorAggregateOperator::Init() {
+  done_ = false;
+  return child_->Init();
+}
+
+namespace {
+struct AggregateState {
+  int64_t count{0};
+  int64_t integer{0};  // int列的和、最小值、最大值
+  double value{0};     // float列的和、最小值、最大值
+};
+}  // namespace
+
+// call func(values[i]) for the selected values that are not null
+template <typename T, typename Func>
+static void ForEachValue(const T *values, const ColumnVector &column, const std::vector<uint32_t> &selection,
+                         Func &&func) {
+  for (auto i : selection) {
+    if (!column.IsNull(i)) {
+      func(values[i]);
+    }
+  }
+}
+
+// 按列的类型选出一个特化的循环，int按int64累加以保留精确值。和溢出时返回false
+static bool Accumulate(AggregateType type, const ColumnVector &column, const std::vector<uint32_t> &selection,
+                       AggregateState &state) {
+  if (column.GetType() == kTypeInt) {
+    bool overflow = false;
+    ForEachValue(column.GetInts(), column, selection, [&](int64_t v) {
+      if (type == AggregateType::kMin) {
+        state.integer = state.count == 0 ? v : std::min(state.integer, v);
+      } else if (type == AggregateType::kMax) {
+        state.integer = state.count == 0 ? v : std::max(state.integer, v);
+      } else {
+        overflow |= __builtin_add_overflow(state.integer, v, &state.integer);
+      }
+      state.count++;
+    });
+    return !overflow;
+  }
+  ForEachValue(column.GetFloats(), column, selection, [&](double v) {
+    if (type == AggregateType::kMin) {
+      state.value = state.count == 0 ? v : std::min(state.value, v);
+    } else if (type == AggregateType::kMax) {
+      state.value = state.count == 0 ? v : std::max(state.value, v);
+    } else {
+      state.value += v;
+    }
+    state.count++;
+  });
+  return true;
+}
+
+VectorBatch *VectorAggregateOperator::NextBatch() {
+  if (done_) {
+    return nullptr;
+  }
+  done_ = true;
+  size_t n = aggregates_.size();
+  std::vector<AggregateState> states(n);
+  std::vector<TypeId> input_types(n, kTypeInvalid);
+  VectorBatch *input;
+  while ((input = child_->NextBatch()) != nullptr) {
+    for (size_t k = 0; k < n; k++) {
+      AggregateType type = aggregates_[k].first;
+      AggregateState &state = states[k];
+      if (aggregates_[k].second < 0) {
+        state.count += input->selection.size();
+        continue;
+      }
+      const ColumnVector &column = input->columns[aggregates_[k].second];
+      if (type == AggregateType::kCount || column.GetType() == kTypeChar) {
+        for (auto i : input->selection) {
+          state.count += !column.IsNull(i);
+        }
+        continue;
+      }
+      input_types[k] = column.GetType();
+      if (!Accumulate(type, column, input->selection, state)) {
+        status_ = DB_FAILED;
+        return nullptr;
+      }
+    }
+  }
+  status_ = child_->GetStatus();
+  if (status_ != DB_SUCCESS) {
+    return nullptr;
+  }
+  batch_.columns.clear();
+  for (size_t k = 0; k < n; k++) {
+    const AggregateState &state = states[k];
+    AggregateType type = aggregates_[k].first;
+    // 整数列的SUM、MIN、MAX仍是整数，AVG总是浮点数
+    bool is_int = type == AggregateType::kCount || (input_types[k] == kTypeInt && type != AggregateType::kAvg);
+    batch_.columns.emplace_back(is_int ? kTypeInt : kTypeFloat);
+    ColumnVector &column = batch_.columns.back();
+    if (type == AggregateType::kCount) {
+      column.AppendInt(static_cast<int32_t>(state.count));
+    } else if (state.count == 0) {
+      column.AppendNull();
+    } else if (is_int) {
+      if (state.integer < INT32_MIN || state.integer > INT32_MAX) {
+        // 和超出了int的范围
+        status_ = DB_FAILED;
+        return nullptr;
+      }
+      column.AppendInt(static_cast<int32_t>(state.integer));
+    } else if (input_types[k] == kTypeInt) {
+      column.AppendFloat(static_cast<float>(static_cast<double>(state.integer) / state.count));
+    } else if (type == AggregateType::kAvg) {
+      column.AppendFloat(static_cast<float>(state.value / state.count));
+    } else {
+      column.AppendFloat(static_cast<float>(state.value));
+    }
+  }
+  batch_.row_ids.assign(1, INVALID_ROWID);
+  batch_.SelectAll();
+  return &batch_;
+}
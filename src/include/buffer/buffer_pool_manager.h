@@ -20,6 +20,16 @@ class BufferPoolManager {
 
   Page *FetchPage(page_id_t page_id);
 
+  /**
+   * Fetch through a swizzled reference. While ref points to the frame holding page_id the page is pinned
+   * directly, without the page table lookup. Otherwise it is fetched as usual and ref is swizzled to its frame.
+   * A reference to an evicted page is unswizzled lazily: its frame no longer holds page_id.
+   */
+  Page *FetchPage(page_id_t page_id, Page *&ref);
+
+  // when disabled, swizzled fetches go through the page table, used to measure the difference
+  void SetSwizzling(bool enable) { swizzling_ = enable; }
+
   bool UnpinPage(page_id_t page_id, bool is_dirty);
 
   bool FlushPage(page_id_t page_id);
@@ -28,8 +38,14 @@ class BufferPoolManager {
 
   bool DeletePage(page_id_t page_id);
 
+  // Delete a batch of pages and free them in the disk bitmaps at once. Pinned pages are kept, return false then.
+  bool DeletePages(const std::vector<page_id_t> &page_ids);
+
   bool IsPageFree(page_id_t page_id);
 
+  // true if the page is held by a frame, so that fetching it needs no disk read
+  bool IsPageResident(page_id_t page_id);
+
   bool CheckAllUnpinned();
   
   size_t GetFreeSize();
@@ -45,6 +61,16 @@ class BufferPoolManager {
    */
   void DeallocatePage(page_id_t page_id);
 
+  /**
+   * Drop a page about to be deleted from the buffer, return false if it is pinned
+   */
+  bool EvictDeletedPage(page_id_t page_id);
+
+  /**
+   * Reset the book keeping of a frame that is handed to another page
+   */
+  void ResetFrame(Page *page, page_id_t page_id);
+
  private:
   size_t pool_size_;                                      // number of pages in buffer pool
   Page *pages_;                                           // array of pages
@@ -53,6 +79,7 @@ class BufferPoolManager {
   Replacer *replacer_;                                    // to find an unpinned page for replacement
   std::list<frame_id_t> free_list_;                       // to find a free page for replacement
   recursive_mutex latch_;                                 // to protect shared data structure
+  bool swizzling_{true};                                  // whether FetchPage follows swizzled references
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
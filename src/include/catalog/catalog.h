@@ -25,11 +25,11 @@ class CatalogMeta {
   uint32_t GetSerializedSize() const;
 
   inline table_id_t GetNextTableId() const {
-    return table_meta_pages_.size() == 0 ? 0 : table_meta_pages_.rbegin()->first;
+    return table_meta_pages_.size() == 0 ? 0 : table_meta_pages_.rbegin()->first + 1;
   }
 
   inline index_id_t GetNextIndexId() const {
-    return index_meta_pages_.size() == 0 ? 0 : index_meta_pages_.rbegin()->first;
+    return index_meta_pages_.size() == 0 ? 0 : index_meta_pages_.rbegin()->first + 1;
   }
 
   static CatalogMeta *NewInstance(MemHeap *heap) {
@@ -74,7 +74,8 @@ class CatalogManager {
   dberr_t GetTables(std::vector<TableInfo *> &tables) const;
 
   dberr_t CreateIndex(const std::string &table_name, const std::string &index_name,
-                      const std::vector<std::string> &index_keys, Transaction *txn, IndexInfo *&index_info);
+                      const std::vector<std::string> &index_keys, Transaction *txn, IndexInfo *&index_info,
+                      IndexType index_type = kIndexBPlusTree);
 
   dberr_t GetIndex(const std::string &table_name, const std::string &index_name, IndexInfo *&index_info) const;
 
@@ -84,6 +85,12 @@ class CatalogManager {
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
 
+  /**
+   * Gather the statistics of a table and write them to its metadata page, replacing those
+   * of the previous analyze. The row and page counts of the table heap are refreshed too.
+   */
+  dberr_t AnalyzeTable(const std::string &table_name);
+
  private:
   dberr_t FlushCatalogMetaPage() const;
 
@@ -91,6 +98,9 @@ class CatalogManager {
 
   dberr_t LoadIndex(const index_id_t index_id, const page_id_t page_id);
 
+  // insert the keys of every row of the table into a new index
+  void BuildIndex(IndexInfo *index_info, const std::vector<uint32_t> &key_map);
+
   dberr_t GetTable(const table_id_t table_id, TableInfo *&table_info);
 
  private:
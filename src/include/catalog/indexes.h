@@ -4,8 +4,12 @@
 #include <memory>
 
 #include "catalog/table.h"
+#include "index/art_index.h"
 #include "index/b_plus_tree_index.h"
+#include "index/extendible_hash_index.h"
 #include "index/generic_key.h"
+#include "index/lsm_index.h"
+#include "index/prefix_b_plus_tree_index.h"
 #include "page/index_roots_page.h"
 #include "record/schema.h"
 
@@ -14,7 +18,17 @@ class IndexMetadata {
 
  public:
   static IndexMetadata *Create(const index_id_t index_id, const std::string &index_name, const table_id_t table_id,
-                               const std::vector<uint32_t> &key_map, MemHeap *heap);
+                               const std::vector<uint32_t> &key_map, MemHeap *heap,
+                               IndexType index_type = kIndexBPlusTree, uint32_t key_size = 0);
+
+  /**
+   * Pick the narrowest generic key width, a power of two from MIN_KEY_SIZE to MAX_KEY_SIZE,
+   * able to hold every key of the given columns. B+ tree, hash and lsm pages store each key
+   * whole in a slot of this fixed width, so a short CHAR key can leave up to half of its slot
+   * unused; kIndexPrefixBPlusTree and kIndexART keep variable-length keys and ignore the width.
+   * Columns whose keys may exceed MAX_KEY_SIZE can not be indexed. Returns 0 in that case.
+   */
+  static uint32_t GetKeySizeFor(const Schema *schema, const std::vector<uint32_t> &key_map);
 
   uint32_t SerializeTo(char *buf) const;
 
@@ -32,12 +46,27 @@ class IndexMetadata {
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  inline IndexType GetIndexType() const { return index_type_; }
+
+  inline uint32_t GetKeySize() const { return key_size_; }
+
  private:
   IndexMetadata() = delete;
 
   explicit IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id,
-                         const std::vector<uint32_t> &key_map)
-      : index_id_(index_id), index_name_(index_name), table_id_(table_id), key_map_(key_map) {}
+                         const std::vector<uint32_t> &key_map, IndexType index_type, uint32_t key_size)
+      : index_id_(index_id),
+        index_name_(index_name),
+        table_id_(table_id),
+        key_map_(key_map),
+        index_type_(index_type),
+        key_size_(key_size) {}
+
+ public:
+  static constexpr uint32_t MIN_KEY_SIZE = 16;
+  static constexpr uint32_t MAX_KEY_SIZE = 512;
+  /** Key size of indexes created before the size was stored */
+  static constexpr uint32_t LEGACY_KEY_SIZE = 64;
 
  private:
   static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344528;
@@ -45,8 +74,18 @@ class IndexMetadata {
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_; /** The mapping of index key to tuple key */
+  IndexType index_type_;          /** Stored after key_map_, pages written before it existed read as b+ tree */
+  uint32_t key_size_;             /** Stored last, pages written before it existed read as LEGACY_KEY_SIZE */
 };
 
+/** Concrete index classes created by IndexInfo, KeySize is chosen per index by IndexMetadata::GetKeySizeFor. */
+template <size_t KeySize>
+using GenericBPlusTreeIndex = BPlusTreeIndex<GenericKey<KeySize>, RowId, GenericComparator<KeySize>>;
+template <size_t KeySize>
+using GenericHashIndex = ExtendibleHashIndex<GenericKey<KeySize>, RowId, GenericComparator<KeySize>>;
+template <size_t KeySize>
+using GenericLSMIndex = LSMIndex<GenericKey<KeySize>, RowId, GenericComparator<KeySize>>;
+
 /**
  * The IndexInfo class maintains metadata about a index.
  */
@@ -68,7 +107,8 @@ class IndexInfo {
     // Step3: call CreateIndex to create the index
     key_schema_ = Schema::ShallowCopySchema(table_info->GetSchema(), meta_data->GetKeyMapping(), heap_);
     meta_data_ = IndexMetadata::Create(meta_data->index_id_, meta_data->index_name_, meta_data->table_id_,
-                                       meta_data->GetKeyMapping(), heap_);
+                                       meta_data->GetKeyMapping(), heap_, meta_data->index_type_,
+                                       meta_data->key_size_);
     table_info_ = TableInfo::Create(heap_);
     table_info_->Init(table_info->GetTableMeta(), table_info->GetTableHeap());
 
@@ -89,14 +129,84 @@ class IndexInfo {
 
   inline size_t getIndexSize() const { return meta_data_->key_map_.size(); }
 
+  inline IndexType GetIndexType() const { return meta_data_->GetIndexType(); }
+
+  inline uint32_t GetKeySize() const { return meta_data_->GetKeySize(); }
+
+  /**
+   * Call func with the index cast to its concrete b+ tree type, for callers that need
+   * the typed iterators. Must only be used on kIndexBPlusTree indexes.
+   */
+  template <typename Func>
+  void VisitBPlusTreeIndex(Func &&func) {
+    ASSERT(GetIndexType() == kIndexBPlusTree, "Not a b+ tree index.");
+    switch (GetKeySize()) {
+      case 16:
+        func(static_cast<GenericBPlusTreeIndex<16> *>(index_));
+        break;
+      case 32:
+        func(static_cast<GenericBPlusTreeIndex<32> *>(index_));
+        break;
+      case 64:
+        func(static_cast<GenericBPlusTreeIndex<64> *>(index_));
+        break;
+      case 128:
+        func(static_cast<GenericBPlusTreeIndex<128> *>(index_));
+        break;
+      case 256:
+        func(static_cast<GenericBPlusTreeIndex<256> *>(index_));
+        break;
+      default:
+        func(static_cast<GenericBPlusTreeIndex<512> *>(index_));
+        break;
+    }
+  }
+
  private:
   explicit IndexInfo()
       : meta_data_{nullptr}, index_{nullptr}, table_info_{nullptr}, key_schema_{nullptr}, heap_(new SimpleMemHeap()) {}
 
   Index *CreateIndex(BufferPoolManager *buffer_pool_manager) {
-    void *mem = heap_->Allocate(sizeof(BPlusTreeIndex<GenericKey<64>, RowId, GenericComparator<64>>));
-    auto index = new (mem) BPlusTreeIndex<GenericKey<64>, RowId, GenericComparator<64>>(
-        meta_data_->index_id_, key_schema_, buffer_pool_manager);
+    // the radix tree and the prefix b+ tree work on their own binary keys, independent of the generic key size
+    if (meta_data_->index_type_ == kIndexART) {
+      void *mem = heap_->Allocate(sizeof(ARTIndex));
+      return new (mem) ARTIndex(meta_data_->index_id_, key_schema_);
+    }
+    if (meta_data_->index_type_ == kIndexPrefixBPlusTree) {
+      void *mem = heap_->Allocate(sizeof(PrefixBPlusTreeIndex));
+      return new (mem) PrefixBPlusTreeIndex(meta_data_->index_id_, key_schema_, buffer_pool_manager);
+    }
+    switch (meta_data_->key_size_) {
+      case 16:
+        return CreateIndex<16>(buffer_pool_manager);
+      case 32:
+        return CreateIndex<32>(buffer_pool_manager);
+      case 64:
+        return CreateIndex<64>(buffer_pool_manager);
+      case 128:
+        return CreateIndex<128>(buffer_pool_manager);
+      case 256:
+        return CreateIndex<256>(buffer_pool_manager);
+      default:
+        return CreateIndex<512>(buffer_pool_manager);
+    }
+  }
+
+  template <size_t KeySize>
+  Index *CreateIndex(BufferPoolManager *buffer_pool_manager) {
+    if (meta_data_->index_type_ == kIndexHash) {
+      void *mem = heap_->Allocate(sizeof(GenericHashIndex<KeySize>));
+      return new (mem) GenericHashIndex<KeySize>(meta_data_->index_id_, key_schema_, buffer_pool_manager);
+    }
+    if (meta_data_->index_type_ == kIndexLSM) {
+      void *mem = heap_->Allocate(sizeof(GenericLSMIndex<KeySize>));
+      return new (mem) GenericLSMIndex<KeySize>(meta_data_->index_id_, key_schema_, buffer_pool_manager);
+    }
+    void *mem = heap_->Allocate(sizeof(GenericBPlusTreeIndex<KeySize>));
+    auto *index = new (mem) GenericBPlusTreeIndex<KeySize>(meta_data_->index_id_, key_schema_, buffer_pool_manager);
+    // indexes owned by the catalog keep their upper levels resident and buffer inserts into evicted leaves
+    index->EnableNodeCache(INDEX_NODE_CACHE_LEVELS);
+    index->EnableChangeBuffer(INDEX_CHANGE_BUFFER_SIZE);
     return index;
   }
 
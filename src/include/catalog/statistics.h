@@ -0,0 +1,83 @@
+#ifndef MINISQL_STATISTICS_H
+#define MINISQL_STATISTICS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+
+/**
+ * A value kept in column statistics: number for int and float columns, text
+ * for char columns.
+ */
+struct StatisticsValue {
+  double number{0};
+  std::string text;
+};
+
+/**
+ * What analyze learned about one column from a sample of the rows.
+ *
+ * The most common values carry the fraction of rows holding each of them. The
+ * remaining non-null values are described by an equi-depth histogram: bounds
+ * splits them into bounds.size() - 1 buckets holding the same number of rows,
+ * bucket k covering [bounds[k], bounds[k + 1]]. All fractions are of the whole
+ * table, nulls included.
+ */
+struct ColumnStatistics {
+  // fraction of the rows whose value equals value
+  double EstimateEqual(const Field &value) const;
+
+  // fraction of the rows whose value is less than value, or equal to it if inclusive
+  double EstimateLess(const Field &value, bool inclusive) const;
+
+  // fraction of the rows covered by the histogram
+  double GetHistogramFraction() const;
+
+  uint32_t SerializeTo(char *buf) const;
+
+  uint32_t GetSerializedSize() const;
+
+  uint32_t DeserializeFrom(char *buf);
+
+  TypeId type{kTypeInvalid};
+  double null_fraction{0};
+  double distinct_count{0};
+  std::vector<StatisticsValue> mcv_values;
+  std::vector<double> mcv_fractions;
+  std::vector<StatisticsValue> bounds;
+};
+
+/**
+ * Statistics of a table as of its last analyze, stored with its TableMetadata.
+ */
+struct TableStatistics {
+  /**
+   * Read every page of the table heap, keeping a uniform sample of at most sample_size rows
+   * (reservoir sampling), and build the statistics of each column from the sample. The row
+   * and page counts are exact.
+   */
+  static std::unique_ptr<TableStatistics> Build(TableHeap *table_heap, Schema *schema,
+                                                uint32_t sample_size = ANALYZE_SAMPLE_SIZE);
+
+  /**
+   * Drop histogram buckets and most common values, from the largest columns first,
+   * until the statistics serialize into at most size bytes.
+   */
+  void ShrinkTo(uint32_t size);
+
+  uint32_t SerializeTo(char *buf) const;
+
+  uint32_t GetSerializedSize() const;
+
+  static uint32_t DeserializeFrom(char *buf, std::unique_ptr<TableStatistics> &statistics);
+
+  uint64_t row_count{0};
+  uint32_t page_count{0};
+  std::vector<ColumnStatistics> columns;
+};
+
+#endif  // MINISQL_STATISTICS_H
@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include "catalog/statistics.h"
 #include "glog/logging.h"
 #include "record/schema.h"
 #include "storage/table_heap.h"
@@ -28,6 +29,13 @@ public:
 
   inline Schema *GetSchema() const { return schema_; }
 
+  // statistics of the last analyze, nullptr if the table was never analyzed
+  inline TableStatistics *GetStatistics() const { return statistics_.get(); }
+
+  /**
+   * Keep the statistics of an analyze, shrunk so that the metadata still fits in its page.
+   */
+  void SetStatistics(std::unique_ptr<TableStatistics> statistics);
 
 private:
   TableMetadata() = delete;
@@ -36,10 +44,13 @@ private:
 
 private:
   static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
+  // marks the statistics following the schema, metadata written before any analyze has none
+  static constexpr uint32_t TABLE_STATISTICS_MAGIC_NUM = 591873;
   table_id_t table_id_;
   std::string table_name_;
   page_id_t root_page_id_;
   Schema *schema_;
+  std::unique_ptr<TableStatistics> statistics_;
 };
 
 /**
@@ -75,6 +86,8 @@ public:
 
   inline TableMetadata* GetTableMeta() const{return table_meta_;}
 
+  inline TableStatistics *GetStatistics() const { return table_meta_->GetStatistics(); }
+
 private:
   explicit TableInfo() : heap_(new SimpleMemHeap()) {};
 
@@ -15,6 +15,24 @@ static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index
 
 static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
 static constexpr int DEFAULT_BUFFER_POOL_SIZE = 16384;  // default size of buffer pool
+static constexpr int INDEX_NODE_CACHE_LEVELS = 2;       // upper b+ tree levels kept pinned for catalog indexes
+static constexpr int INDEX_NODE_CACHE_PAGES = 64;       // max pages pinned by one index node cache
+static constexpr int INDEX_CHANGE_BUFFER_SIZE = 1024;   // pending b+ tree inserts buffered for non-resident leaves
+static constexpr int LSM_MEMTABLE_CAPACITY = 4096;      // entries buffered by an lsm index before a run is written
+static constexpr int LSM_LEVEL_FANOUT = 4;              // runs of one lsm level merged into a run of the next level
+static constexpr int VECTOR_BATCH_SIZE = 1024;          // rows gathered in a batch by vectorized scans
+static constexpr int JOIN_MEMORY_BUDGET = 16 << 20;     // bytes of build rows a hash join keeps before spilling
+static constexpr int GROUP_MEMORY_BUDGET = 16 << 20;    // bytes of groups a hash aggregate keeps before spilling
+static constexpr int SPILL_PARTITIONS = 16;             // partitions written by an operator spilling to pages
+static constexpr int INDEX_JOIN_BATCH_SIZE = 256;       // outer rows whose keys an index join probes together
+
+static constexpr double SEQ_PAGE_COST = 1.0;     // planner cost of reading a page during a sequential scan
+static constexpr double RANDOM_PAGE_COST = 4.0;  // planner cost of fetching a page out of order
+static constexpr double CPU_TUPLE_COST = 0.01;   // planner cost of handling one row
+
+static constexpr int ANALYZE_SAMPLE_SIZE = 3000;     // rows sampled by analyze to build column statistics
+static constexpr int STATISTICS_MCV_COUNT = 8;       // most common values kept per column
+static constexpr int STATISTICS_BUCKET_COUNT = 16;   // equi-depth histogram buckets kept per column
 
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
 static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;  // max length of varchar
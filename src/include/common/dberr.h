@@ -12,7 +12,10 @@ enum dberr_t {
   DB_KEY_NOT_FOUND,
   DB_COLUMN_NOT_UNIQUE,
   DB_PRIMARY_KEY_COLLISION,
-  DB_UNIQUE_KEY_COLLISION
+  DB_UNIQUE_KEY_COLLISION,
+  DB_KEY_ALREADY_EXIST,
+  DB_INDEX_KEY_TOO_LONG,
+  DB_TYPE_MISMATCH
 };
 
 #endif  // MINISQL_DBERR_H
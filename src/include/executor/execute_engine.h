@@ -3,11 +3,16 @@
 
 #include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include "common/dberr.h"
 #include "common/instance.h"
+#include "executor/operators.h"
+#include "executor/planner.h"
+#include "executor/predicate.h"
+#include "executor/vector_operators.h"
 #include "transaction/transaction.h"
 
 extern "C" {
@@ -68,12 +73,24 @@ class ExecuteEngine {
 
   dberr_t ExecuteSelect(pSyntaxNode ast, ExecuteContext *context);
 
+  /**
+   * Select from several tables, or with columns named by their table or compared with each other.
+   * The tables are joined left-deep in FROM order, by index nested-loop joins when the joined
+   * table has an index on the join columns that is cheaper to probe than the table is to read,
+   * by hash joins otherwise. The conditions of ON and WHERE are inner join conditions, each one
+   * evaluated as early as the tables it reads allow. With GROUP BY or aggregate functions
+   * (COUNT, SUM, AVG, MIN, MAX) the joined rows are grouped by a hash aggregate last.
+   */
+  dberr_t ExecuteJoinSelect(pSyntaxNode ast, DBStorageEngine *storage_engine);
+
   dberr_t ExecuteInsert(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteDelete(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteUpdate(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteAnalyze(pSyntaxNode ast, ExecuteContext *context);
+
   dberr_t ExecuteTrxBegin(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteTrxCommit(pSyntaxNode ast, ExecuteContext *context);
@@ -84,8 +101,46 @@ class ExecuteEngine {
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
-  dberr_t get_columns_by_condition(pSyntaxNode condition_node, vector<RowId> &result, CatalogManager *catalog_manager,
-                                   string &table_name);
+  /**
+   * Build the operator producing the rows of the table selected by a where clause, an index
+   * scan when an index answers the conditions and a filtered sequential scan otherwise. The
+   * conditions are parsed into the given list, which must outlive the operator.
+   */
+  dberr_t BuildScan(pSyntaxNode condition_node, TableInfo *table_info, CatalogManager *catalog_manager,
+                    ConditionList &conditions, std::unique_ptr<Operator> &scan);
+
+  // the operator producing the rows of the table selected by bound conditions
+  dberr_t BuildAccessPath(TableInfo *table_info, CatalogManager *catalog_manager, ConditionList &conditions,
+                          std::unique_ptr<Operator> &scan);
+
+  void ParseConditions(pSyntaxNode condition_node, ConditionList &conditions);
+
+  dberr_t BindConditions(ConditionList &conditions, Schema *schema);
+
+  // the predicate of the bound conditions, leaving out condition i if skip[i]. Skipping is only
+  // sound when every connector is and, nullptr if nothing is left
+  std::unique_ptr<Predicate> CompilePredicate(const ConditionList &conditions, Schema *schema,
+                                              const vector<bool> &skip);
+
+  IndexInfo *GetCoveringIndex(const ConditionList *conditions, const vector<string> &columns,
+                              vector<IndexInfo *> &indexes);
+
+  dberr_t ScanCoveringIndex(IndexInfo *index_info, ConditionList *conditions, const vector<string> &columns,
+                            size_t &count);
+
+  // sequential scan of the table in column batches, keeping the rows satisfying conditions
+  dberr_t BuildVectorScan(TableInfo *table_info, ConditionList *conditions, std::unique_ptr<VectorOperator> &plan);
+
+  // sequential scan of the table in column batches, printing the wanted columns of the rows satisfying conditions
+  dberr_t ScanVectorized(TableInfo *table_info, ConditionList *conditions, const vector<uint32_t> &column_index,
+                         size_t &count);
+
+  // aggregate functions without GROUP BY over a sequential scan of the table in column batches, printing one row
+  dberr_t AggregateVectorized(TableInfo *table_info, ConditionList *conditions, pSyntaxNode column_want_node);
+
+  void PrintField(Field *field);
+
+  void PrintValue(const ColumnVector &column, uint32_t i);
 
  private:
   [[maybe_unused]] std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
@@ -0,0 +1,397 @@
+#ifndef MINISQL_OPERATORS_H
+#define MINISQL_OPERATORS_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/indexes.h"
+#include "catalog/table.h"
+#include "common/dberr.h"
+#include "executor/vector_operators.h"
+#include "record/row.h"
+#include "storage/spill_file.h"
+#include "utils/mem_heap.h"
+
+/**
+ * Physical operator of a query plan, in the iterator (volcano) model.
+ *
+ * Init prepares the operator and its children, then every Next call pulls
+ * one row through the plan. Rows are streamed, a row read from a table page
+ * is handed up the plan without being collected and fetched again.
+ */
+class Operator {
+ public:
+  virtual ~Operator() = default;
+
+  virtual dberr_t Init() = 0;
+
+  /**
+   * @return the next row, or nullptr once the operator is exhausted or failed,
+   * GetStatus tells which. The row stays valid until the next call
+   */
+  virtual const Row *Next() = 0;
+
+  inline dberr_t GetStatus() const { return status_; }
+
+ protected:
+  dberr_t status_{DB_SUCCESS};
+};
+
+/**
+ * Every row of a table heap in page order.
+ */
+class SeqScanOperator : public Operator {
+ public:
+  explicit SeqScanOperator(TableHeap *table_heap) : table_heap_(table_heap) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+ private:
+  TableHeap *table_heap_;
+  std::unique_ptr<TableIterator> iter_;
+  bool started_{false};
+};
+
+/**
+ * Rows of the keys found in an index. Each key is probed once in Init, duplicate
+ * row ids are skipped, and the rows are fetched from the table heap in Next.
+ * Without keys the scan is empty and the index may be null. A range scan reads
+ * the keys with low <= key <= high of an ordered index instead, in key order.
+ */
+class IndexScanOperator : public Operator {
+ public:
+  IndexScanOperator(Index *index, TableHeap *table_heap, std::vector<Row> keys)
+      : index_(index), table_heap_(table_heap), keys_(std::move(keys)) {}
+
+  // a null bound leaves that end of the range open
+  IndexScanOperator(Index *index, TableHeap *table_heap, std::unique_ptr<Row> low, std::unique_ptr<Row> high)
+      : index_(index), table_heap_(table_heap), range_(true), low_(std::move(low)), high_(std::move(high)) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+ private:
+  Index *index_;
+  TableHeap *table_heap_;
+  std::vector<Row> keys_;
+  bool range_{false};
+  std::unique_ptr<Row> low_;
+  std::unique_ptr<Row> high_;
+  std::vector<RowId> rids_;
+  size_t next_{0};
+  std::unique_ptr<Row> row_;
+};
+
+/**
+ * Rows of the child satisfying a predicate.
+ */
+class FilterOperator : public Operator {
+ public:
+  FilterOperator(std::unique_ptr<Operator> child, std::function<bool(const Row &)> predicate)
+      : child_(std::move(child)), predicate_(std::move(predicate)) {}
+
+  dberr_t Init() override { return child_->Init(); }
+
+  const Row *Next() override;
+
+ private:
+  std::unique_ptr<Operator> child_;
+  std::function<bool(const Row &)> predicate_;
+};
+
+/**
+ * Selected fields of the rows of the child, in the given order.
+ */
+class ProjectionOperator : public Operator {
+ public:
+  ProjectionOperator(std::unique_ptr<Operator> child, std::vector<uint32_t> column_index)
+      : child_(std::move(child)), column_index_(std::move(column_index)) {}
+
+  dberr_t Init() override { return child_->Init(); }
+
+  const Row *Next() override;
+
+ private:
+  std::unique_ptr<Operator> child_;
+  std::vector<uint32_t> column_index_;
+  std::unique_ptr<Row> row_;
+};
+
+/**
+ * Inner equi-join of two children, yielding the fields of the left row followed
+ * by those of the right row. The rows of the build side, the left one if
+ * build_left and the right one otherwise, are hashed on their key columns in
+ * Init; the rows of the other side then probe the table as they are pulled.
+ * Keys compare by value, an int equal to a float matching it, and a null key
+ * matches nothing. Without key columns every pair of rows is joined.
+ *
+ * Once the build rows take more than memory_budget bytes, both sides are
+ * partitioned on the hash of their keys into spill files, and the partitions
+ * are joined one at a time (grace hash join). A partition is expected to fit
+ * in memory once split.
+ */
+class HashJoinOperator : public Operator {
+ public:
+  HashJoinOperator(std::unique_ptr<Operator> left, std::unique_ptr<Operator> right, std::vector<uint32_t> left_keys,
+                   std::vector<uint32_t> right_keys, bool build_left, BufferPoolManager *buffer_pool_manager,
+                   size_t memory_budget = JOIN_MEMORY_BUDGET)
+      : left_(std::move(left)),
+        right_(std::move(right)),
+        left_keys_(std::move(left_keys)),
+        right_keys_(std::move(right_keys)),
+        build_left_(build_left),
+        buffer_pool_manager_(buffer_pool_manager),
+        memory_budget_(memory_budget) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+  // whether the build side outgrew the memory budget
+  inline bool IsSpilled() const { return !build_files_.empty(); }
+
+ private:
+  // the key of the row on the given columns, false if one of them is null
+  static bool GetHashKey(const Row &row, const std::vector<uint32_t> &keys, std::string &key);
+
+  void AddBuildRow(const Row &row, std::string key);
+
+  // move the build rows in memory into partitions, from then on rows are written to the partitions
+  bool Spill();
+
+  // the next probe row with a non-null key, from the probe child or the current partition
+  const Row *NextProbeRow(std::string &key);
+
+  // load the build rows of the next partition, false once every partition is joined
+  bool LoadPartition();
+
+  std::unique_ptr<Operator> left_;
+  std::unique_ptr<Operator> right_;
+  std::vector<uint32_t> left_keys_;
+  std::vector<uint32_t> right_keys_;
+  bool build_left_;
+  BufferPoolManager *buffer_pool_manager_;
+  size_t memory_budget_;
+
+  std::deque<Row> build_rows_;
+  std::unordered_multimap<std::string, size_t> table_;
+  size_t memory_{0};
+  std::vector<std::unique_ptr<SpillFile>> build_files_;
+  std::vector<std::unique_ptr<SpillFile>> probe_files_;
+  int partition_{-1};
+
+  const Row *probe_row_{nullptr};
+  std::unique_ptr<Row> spilled_row_;
+  std::unordered_multimap<std::string, size_t>::const_iterator match_;
+  std::unordered_multimap<std::string, size_t>::const_iterator match_end_;
+  std::unique_ptr<Row> row_;
+};
+
+/**
+ * Inner join probing an index of the inner table with the key of each outer
+ * row, yielding the fields of the outer row followed by those of the inner row.
+ * outer_keys[k] is the column of the outer row matched with the k-th column of
+ * the index key. Outer rows are taken batch_size at a time: the keys of a batch
+ * are probed together in key order, so that consecutive keys share leaf pages,
+ * and the matching tuples are fetched in row id order. A key value is converted
+ * to the type of its index column; a null, or a value with no equal of that
+ * type, matches nothing. Inner rows failing inner_filter, if given, are dropped.
+ */
+class IndexJoinOperator : public Operator {
+ public:
+  IndexJoinOperator(std::unique_ptr<Operator> outer, IndexInfo *index_info, TableHeap *inner_heap,
+                    std::vector<uint32_t> outer_keys, std::function<bool(const Row &)> inner_filter = nullptr,
+                    size_t batch_size = INDEX_JOIN_BATCH_SIZE)
+      : outer_(std::move(outer)),
+        index_info_(index_info),
+        inner_heap_(inner_heap),
+        outer_keys_(std::move(outer_keys)),
+        inner_filter_(std::move(inner_filter)),
+        batch_size_(batch_size) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+ private:
+  // probe the keys of the next batch of outer rows, false once the outer rows are exhausted
+  bool NextBatch();
+
+  std::unique_ptr<Operator> outer_;
+  IndexInfo *index_info_;
+  TableHeap *inner_heap_;
+  std::vector<uint32_t> outer_keys_;
+  std::function<bool(const Row &)> inner_filter_;
+  size_t batch_size_;
+
+  std::deque<Row> outer_rows_;
+  std::deque<Row> inner_rows_;
+  std::vector<size_t> match_outer_;  // the outer row of each inner row
+  size_t next_{0};
+  std::unique_ptr<Row> row_;
+};
+
+/**
+ * Group the rows of the child on group_columns and aggregate each group,
+ * yielding the group fields followed by one field per aggregate. An aggregate
+ * reads the given column of the child: COUNT yields an int, counting every row
+ * when the column is negative (COUNT(*)) and the non-null values otherwise.
+ * SUM, AVG, MIN and MAX take numbers, skip nulls and are null for a group
+ * without values. AVG yields a float; SUM, MIN and MAX yield the type of the
+ * column, an int sum out of the range of int failing the operator. Nulls of a group column form a group of their own.
+ * Without group columns there is exactly one group, even over no rows.
+ *
+ * Groups are looked up in an open-addressing table (linear probing) keyed on
+ * their encoded group fields; the keys and the aggregate states live in an
+ * arena. Once the groups take more than memory_budget bytes, the rows of groups
+ * not in memory are written to partitions on the hash of their key. After the
+ * groups in memory are yielded, the partitions are aggregated one at a time,
+ * spilling again on other bits of the hash if they still do not fit.
+ */
+class HashAggregateOperator : public Operator {
+ public:
+  HashAggregateOperator(std::unique_ptr<Operator> child, std::vector<uint32_t> group_columns,
+                        std::vector<std::pair<AggregateType, int>> aggregates, BufferPoolManager *buffer_pool_manager,
+                        size_t memory_budget = GROUP_MEMORY_BUDGET)
+      : child_(std::move(child)),
+        group_columns_(std::move(group_columns)),
+        aggregates_(std::move(aggregates)),
+        buffer_pool_manager_(buffer_pool_manager),
+        memory_budget_(memory_budget) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+  // whether some groups did not fit in the memory budget
+  inline bool IsSpilled() const { return spilled_; }
+
+ private:
+  struct AggregateState {
+    int64_t count;
+    int64_t integer;  // sum, min or max of an int column
+    double value;     // sum, min or max of a float column
+  };
+
+  struct Group {
+    size_t hash;
+    const char *key;
+    uint32_t key_size;
+    AggregateState *states;
+  };
+
+  // the group fields of the row, each as its type, whether it is null and its value
+  void EncodeKey(const Row &row, std::string &key) const;
+
+  // the group of the key, created unless the groups are over budget, nullptr then
+  Group *FindGroup(size_t hash, const std::string &key);
+
+  // add the row to its group, or write it to a partition
+  bool Accumulate(const Row &row);
+
+  void Clear();
+
+  // aggregate the next partition written so far, false once none is left
+  bool NextPartition();
+
+  std::unique_ptr<Operator> child_;
+  std::vector<uint32_t> group_columns_;
+  std::vector<std::pair<AggregateType, int>> aggregates_;
+  std::vector<TypeId> input_types_;  // type of the values each aggregate has seen
+  BufferPoolManager *buffer_pool_manager_;
+  size_t memory_budget_;
+
+  ArenaMemHeap arena_;
+  std::vector<int32_t> slots_;  // index in groups_, -1 for an empty slot
+  std::vector<Group> groups_;
+  int depth_{0};  // how many times the rows being aggregated were partitioned
+  std::vector<std::unique_ptr<SpillFile>> partitions_;
+  std::deque<std::pair<std::unique_ptr<SpillFile>, int>> pending_;
+  bool spilled_{false};
+  size_t next_{0};
+  std::unique_ptr<Row> row_;
+};
+
+/**
+ * Insert one row into a table and all its indexes, the primary key index
+ * first. On a key collision every index entry already inserted and the tuple
+ * are taken back. Next yields the inserted row.
+ */
+class InsertOperator : public Operator {
+ public:
+  InsertOperator(TableInfo *table_info, std::vector<IndexInfo *> indexes, std::vector<Field> values)
+      : table_info_(table_info), indexes_(std::move(indexes)), values_(std::move(values)) {}
+
+  dberr_t Init() override { return DB_SUCCESS; }
+
+  const Row *Next() override;
+
+ private:
+  TableInfo *table_info_;
+  std::vector<IndexInfo *> indexes_;
+  std::vector<Field> values_;
+  std::unique_ptr<Row> row_;
+};
+
+/**
+ * Delete the rows of the child from the table and the given indexes, yielding
+ * each deleted row. The child is drained in Init before anything is deleted,
+ * so that a scan below never walks over the rows being removed.
+ */
+class DeleteOperator : public Operator {
+ public:
+  DeleteOperator(std::unique_ptr<Operator> child, TableInfo *table_info, std::vector<IndexInfo *> indexes)
+      : child_(std::move(child)), table_info_(table_info), indexes_(std::move(indexes)) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+ private:
+  std::unique_ptr<Operator> child_;
+  TableInfo *table_info_;
+  std::vector<IndexInfo *> indexes_;
+  std::vector<Row> rows_;
+  size_t next_{0};
+};
+
+/**
+ * Overwrite fields of the rows of the child, yielding each updated row. Like
+ * DeleteOperator the child is drained first, so that a tuple moved by the
+ * update is not seen twice. Indexes whose key has an assigned column get the
+ * old key removed and the new one inserted, primary key index first. On a key
+ * collision the entries of that row are restored and its tuple is left as it
+ * was; rows updated before it stay updated.
+ */
+class UpdateOperator : public Operator {
+ public:
+  UpdateOperator(std::unique_ptr<Operator> child, TableInfo *table_info, std::vector<IndexInfo *> indexes,
+                 std::vector<std::pair<uint32_t, Field>> assignments)
+      : child_(std::move(child)),
+        table_info_(table_info),
+        indexes_(std::move(indexes)),
+        assignments_(std::move(assignments)) {}
+
+  dberr_t Init() override;
+
+  const Row *Next() override;
+
+ private:
+  std::unique_ptr<Operator> child_;
+  TableInfo *table_info_;
+  std::vector<IndexInfo *> indexes_;
+  std::vector<std::pair<uint32_t, Field>> assignments_;
+  std::vector<std::vector<uint32_t>> key_maps_;  // only of the indexes whose key is assigned
+  std::vector<Row> rows_;
+  size_t next_{0};
+  std::unique_ptr<Row> row_;
+};
+
+#endif  // MINISQL_OPERATORS_H
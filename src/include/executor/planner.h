@@ -0,0 +1,91 @@
+#ifndef MINISQL_PLANNER_H
+#define MINISQL_PLANNER_H
+
+#include <vector>
+
+#include "catalog/indexes.h"
+#include "catalog/table.h"
+#include "executor/predicate.h"
+
+/**
+ * How the rows of a table are read for a where clause. An index path makes one
+ * probe per key: an equality probe builds its key from the constants of
+ * conditions key_conditions[k], one per key column, an in-list probes the
+ * constant of each condition in key_conditions. A range path scans an ordered
+ * single-column index from the constant of condition low_condition up to the
+ * one of high_condition, both inclusive, -1 leaving that end open. The
+ * conditions not used for the keys are left to a residual filter, a range
+ * leaves all of them since its bounds also let strict ones through.
+ */
+struct AccessPath {
+  IndexInfo *index{nullptr};  // nullptr for a sequential scan
+  std::vector<uint32_t> key_conditions;
+  bool in_list{false};
+  bool range{false};
+  int low_condition{-1};
+  int high_condition{-1};
+  bool empty{false};  // the conditions can never hold, nothing needs to be read
+  double rows{0};     // estimated rows satisfying the conditions
+  double cost{0};
+};
+
+/**
+ * Cost based choice of the access path of a bound where clause.
+ *
+ * The selectivity of each condition comes from the statistics of the column
+ * once the table was analyzed: most common values, an equi-depth histogram
+ * and the null fraction. Otherwise an equality on a column with distinct
+ * values (unique, or the key of an index) matches one row, and other
+ * comparisons use fixed default fractions. Conditions are taken as
+ * independent. A sequential scan costs its pages, an index scan the pages
+ * read to find each key plus a random fetch per match. A range on the key of
+ * an ordered index is costed as one probe fetching the rows within its
+ * tightest lower and upper bounds. The cheapest index
+ * wins if it beats the scan. Without row counts (a table loaded from disk
+ * and never analyzed) an index answering the conditions is always preferred.
+ */
+class Planner {
+ public:
+  Planner(TableInfo *table_info, std::vector<IndexInfo *> indexes);
+
+  // fraction of the rows satisfying condition i
+  double EstimateSelectivity(const ConditionList &conditions, uint32_t i) const;
+
+  // fraction of the rows satisfying the whole clause
+  double EstimateSelectivity(const ConditionList &conditions) const;
+
+  double GetSeqScanCost() const;
+
+  double GetIndexScanCost(IndexInfo *index_info, double probes, double matches) const;
+
+  AccessPath ChooseAccessPath(const ConditionList &conditions) const;
+
+  /**
+   * Choose the index probed once per outer row by an index nested-loop join of this table on
+   * key_columns, or nullptr when reading the table in inner_cost for a hash join is cheaper.
+   * The index key must be made of the join columns exactly; key_order[k] is then the position
+   * in key_columns of the k-th column of the key. outer_rows is negative when unknown, in which
+   * case an index is only chosen if the size of this table is unknown too.
+   */
+  IndexInfo *ChooseJoinIndex(const std::vector<uint32_t> &key_columns, double outer_rows, double inner_cost,
+                             std::vector<uint32_t> &key_order) const;
+
+  inline bool HasRowCount() const { return counts_known_; }
+
+  inline uint64_t GetRowCount() const { return row_count_; }
+
+ private:
+  // whether no two rows share a value of the column
+  bool IsDistinct(uint32_t column) const;
+
+  // position in the table of each column of the index key
+  std::vector<uint32_t> GetKeyColumns(IndexInfo *index_info) const;
+
+  TableInfo *table_info_;
+  std::vector<IndexInfo *> indexes_;
+  uint64_t row_count_{0};
+  uint32_t page_count_{0};
+  bool counts_known_{false};
+};
+
+#endif  // MINISQL_PLANNER_H
@@ -0,0 +1,120 @@
+#ifndef MINISQL_PREDICATE_H
+#define MINISQL_PREDICATE_H
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "record/compare_kernels.h"
+#include "record/row.h"
+
+extern "C" {
+#include "parser/syntax_tree.h"
+};
+
+/**
+ * @return the operator spelled op in a where clause, "is" and "not" being the null tests
+ */
+CompareOp ParseCompareOp(const char *op);
+
+/**
+ * WHERE clause bound to a schema: column ordinals are resolved, operators are
+ * enums and constants are converted to the type of their column once per
+ * query. Evaluate then does no string work and no allocation per row.
+ *
+ * Comparisons behave like the Type comparisons: floats are equal up to 1e-3,
+ * chars compare like CompareStrings, and a comparison involving null is false.
+ * Each comparison calls a kernel instantiated for its column type and operator,
+ * picked when the predicate is made.
+ */
+class Predicate {
+ public:
+  // column op number, for a column of type column_type, float or int
+  static std::unique_ptr<Predicate> MakeNumberCompare(uint32_t column, TypeId column_type, CompareOp op, float number);
+
+  // column op integer, for an int column, compared without going through float
+  static std::unique_ptr<Predicate> MakeIntCompare(uint32_t column, CompareOp op, int32_t integer);
+
+  // column op text, for a char column
+  static std::unique_ptr<Predicate> MakeTextCompare(uint32_t column, CompareOp op, std::string text);
+
+  // left op right, comparing two columns of the row. Int columns compare as ints, other numbers
+  // as floats, and chars with chars; any other pair never matches
+  static std::unique_ptr<Predicate> MakeColumnCompare(uint32_t left, TypeId left_type, uint32_t right,
+                                                      TypeId right_type, CompareOp op);
+
+  // column is null, or column is not null
+  static std::unique_ptr<Predicate> MakeNullTest(uint32_t column, bool is_null);
+
+  // a comparison that can never hold, e.g. with a null constant or of mismatched types
+  static std::unique_ptr<Predicate> MakeFalse();
+
+  static std::unique_ptr<Predicate> MakeAnd(std::unique_ptr<Predicate> left, std::unique_ptr<Predicate> right);
+
+  static std::unique_ptr<Predicate> MakeOr(std::unique_ptr<Predicate> left, std::unique_ptr<Predicate> right);
+
+  bool Evaluate(const Row &row) const;
+
+ private:
+  enum class Kind : uint8_t { kNumber, kText, kColumns, kNullTest, kFalse, kAnd, kOr };
+
+  // whether the field, which is not null, satisfies the comparison
+  using Kernel = bool (*)(const Predicate &, const Field &);
+
+  // whether two fields, neither null, satisfy the comparison
+  using ColumnsKernel = bool (*)(const Field &, const Field &);
+
+  explicit Predicate(Kind kind) : kind_(kind) {}
+
+  template <typename T, CompareOp op>
+  static bool NumberKernel(const Predicate &predicate, const Field &field);
+
+  template <CompareOp op>
+  static bool IntKernel(const Predicate &predicate, const Field &field);
+
+  template <CompareOp op>
+  static bool TextKernel(const Predicate &predicate, const Field &field);
+
+  template <typename L, typename R, CompareOp op>
+  static bool ColumnsNumberKernel(const Field &left, const Field &right);
+
+  template <CompareOp op>
+  static bool ColumnsTextKernel(const Field &left, const Field &right);
+
+  Kind kind_;
+  Kernel kernel_{nullptr};
+  ColumnsKernel columns_kernel_{nullptr};
+  uint32_t column_{0};
+  uint32_t other_column_{0};
+  CompareOp op_{CompareOp::kEqual};
+  int32_t integer_{0};
+  float number_{0};
+  std::string text_;
+  std::unique_ptr<Predicate> left_;
+  std::unique_ptr<Predicate> right_;
+};
+
+/**
+ * WHERE clause flattened from the left-deep syntax tree. compare[i] and pairs[i]
+ * describe the i-th condition from the top, connector[i] joins it with the
+ * conditions below. BindConditions resolves column_index against one schema,
+ * converts the constants to the column types into to_be_compared (null when
+ * a constant can not be converted) and compiles the conditions into
+ * predicate, which is evaluated for every row.
+ *
+ * In the conditions of a join, where the right side of a comparison may be a
+ * column too, compared_column[i] is the position of that column, or -1 when
+ * condition i compares with a constant. It is left empty otherwise.
+ */
+struct ConditionList {
+  std::vector<char *> compare;
+  std::vector<char *> connector;
+  std::vector<std::tuple<std::string, char *, SyntaxNodeType>> pairs;
+  std::vector<Field> to_be_compared;
+  std::vector<uint32_t> column_index;
+  std::vector<int> compared_column;
+  std::unique_ptr<Predicate> predicate;
+};
+
+#endif  // MINISQL_PREDICATE_H
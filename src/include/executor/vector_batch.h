@@ -0,0 +1,147 @@
+#ifndef MINISQL_VECTOR_BATCH_H
+#define MINISQL_VECTOR_BATCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/rowid.h"
+#include "record/types.h"
+
+/**
+ * Values of one column of a batch, stored as a typed array. Only the array of
+ * the column type is used, null values keep a zero placeholder so that value
+ * i of every column belongs to row i of the batch. Chars are kept back to
+ * back in one buffer and addressed by offsets.
+ */
+class ColumnVector {
+ public:
+  explicit ColumnVector(TypeId type) : type_(type) {}
+
+  inline TypeId GetType() const { return type_; }
+
+  inline uint32_t GetSize() const { return size_; }
+
+  void Clear() {
+    size_ = 0;
+    nulls_.clear();
+    ints_.clear();
+    floats_.clear();
+    offsets_.assign(1, 0);
+    chars_.clear();
+  }
+
+  void Reserve(uint32_t capacity) {
+    nulls_.reserve((capacity + 63) / 64);
+    if (type_ == kTypeInt) {
+      ints_.reserve(capacity);
+    } else if (type_ == kTypeFloat) {
+      floats_.reserve(capacity);
+    } else {
+      offsets_.reserve(capacity + 1);
+    }
+  }
+
+  void AppendInt(int32_t value) {
+    ints_.push_back(value);
+    AppendNullBit(false);
+  }
+
+  void AppendFloat(float value) {
+    floats_.push_back(value);
+    AppendNullBit(false);
+  }
+
+  void AppendChar(const char *data, uint32_t len) {
+    chars_.append(data, len);
+    offsets_.push_back(chars_.size());
+    AppendNullBit(false);
+  }
+
+  void AppendNull() {
+    if (type_ == kTypeInt) {
+      ints_.push_back(0);
+    } else if (type_ == kTypeFloat) {
+      floats_.push_back(0);
+    } else {
+      offsets_.push_back(chars_.size());
+    }
+    AppendNullBit(true);
+  }
+
+  // append the selected values of other, which has the same type
+  void Gather(const ColumnVector &other, const std::vector<uint32_t> &selection) {
+    for (auto i : selection) {
+      if (other.IsNull(i)) {
+        AppendNull();
+      } else if (type_ == kTypeInt) {
+        AppendInt(other.ints_[i]);
+      } else if (type_ == kTypeFloat) {
+        AppendFloat(other.floats_[i]);
+      } else {
+        AppendChar(other.GetChars(i), other.GetCharLength(i));
+      }
+    }
+  }
+
+  inline bool IsNull(uint32_t i) const { return (nulls_[i >> 6] >> (i & 63)) & 1; }
+
+  inline const int32_t *GetInts() const { return ints_.data(); }
+
+  inline const float *GetFloats() const { return floats_.data(); }
+
+  inline const char *GetChars(uint32_t i) const { return chars_.data() + offsets_[i]; }
+
+  inline uint32_t GetCharLength(uint32_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+ private:
+  void AppendNullBit(bool is_null) {
+    if ((size_ & 63) == 0) {
+      nulls_.push_back(0);
+    }
+    if (is_null) {
+      nulls_[size_ >> 6] |= uint64_t{1} << (size_ & 63);
+    }
+    size_++;
+  }
+
+  TypeId type_;
+  uint32_t size_{0};
+  // bit i is set if value i is null
+  std::vector<uint64_t> nulls_;
+  std::vector<int32_t> ints_;
+  std::vector<float> floats_;
+  std::vector<uint32_t> offsets_{0};
+  std::string chars_;
+};
+
+/**
+ * A batch of rows in column layout, passed between vectorized operators. The
+ * selection vector lists the rows still alive in ascending order, a filter
+ * narrows it instead of moving any values.
+ */
+struct VectorBatch {
+  void Clear() {
+    for (auto &column : columns) {
+      column.Clear();
+    }
+    row_ids.clear();
+    selection.clear();
+  }
+
+  // mark every row of the batch alive
+  void SelectAll() {
+    selection.resize(row_ids.size());
+    for (uint32_t i = 0; i < selection.size(); i++) {
+      selection[i] = i;
+    }
+  }
+
+  inline uint32_t GetSize() const { return static_cast<uint32_t>(row_ids.size()); }
+
+  std::vector<ColumnVector> columns;
+  std::vector<RowId> row_ids;
+  std::vector<uint32_t> selection;
+};
+
+#endif  // MINISQL_VECTOR_BATCH_H
@@ -0,0 +1,151 @@
+#ifndef MINISQL_VECTOR_OPERATORS_H
+#define MINISQL_VECTOR_OPERATORS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/dberr.h"
+#include "executor/predicate.h"
+#include "executor/vector_batch.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+
+/**
+ * Vectorized counterpart of Operator. NextBatch hands up about
+ * VECTOR_BATCH_SIZE rows at once, so that filters, projections and
+ * aggregates run as loops over primitive arrays instead of calling through
+ * Row and Field for every value.
+ */
+class VectorOperator {
+ public:
+  virtual ~VectorOperator() = default;
+
+  virtual dberr_t Init() = 0;
+
+  /**
+   * @return the next batch with at least one selected row, or nullptr once the operator
+   * is exhausted. The batch stays valid until the next call
+   */
+  virtual VectorBatch *NextBatch() = 0;
+
+  inline dberr_t GetStatus() const { return status_; }
+
+ protected:
+  dberr_t status_{DB_SUCCESS};
+};
+
+/**
+ * Decode whole pages of a table heap into column batches. Column i of a batch
+ * holds table column column_ids[i], the other columns are skipped. A batch is
+ * emitted once it holds VECTOR_BATCH_SIZE rows or more, pages are never split
+ * between batches.
+ */
+class VectorScanOperator : public VectorOperator {
+ public:
+  VectorScanOperator(TableHeap *table_heap, Schema *schema, std::vector<uint32_t> column_ids)
+      : table_heap_(table_heap), schema_(schema), column_ids_(std::move(column_ids)) {}
+
+  dberr_t Init() override;
+
+  VectorBatch *NextBatch() override;
+
+ private:
+  void DecodeTuple(const RowId &rid, const char *data);
+
+  TableHeap *table_heap_;
+  Schema *schema_;
+  std::vector<uint32_t> column_ids_;
+  // batch column of each table column, -1 if skipped
+  std::vector<int> slots_;
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  VectorBatch batch_;
+};
+
+/**
+ * Comparison of a batch column with a constant. Numbers compare like TypeFloat,
+ * with equality up to 1e-3, text compares like TypeChar. A comparison with a
+ * null value is false. An int column is compared with integer instead of
+ * number when integral is set, i.e. when the constant is a whole int32.
+ */
+struct VectorPredicate {
+  uint32_t column;
+  CompareOp op;
+  bool numeric;
+  float number;
+  std::string text;
+  bool integral{false};
+  int32_t integer{0};
+};
+
+/**
+ * Narrow the selection of the batches of the child to the rows satisfying the
+ * predicates. They are folded in order, predicate i joined to the result of
+ * the ones before it by and_connectors[i - 1], and otherwise by or.
+ */
+class VectorFilterOperator : public VectorOperator {
+ public:
+  VectorFilterOperator(std::unique_ptr<VectorOperator> child, std::vector<VectorPredicate> predicates,
+                       std::vector<bool> and_connectors)
+      : child_(std::move(child)), predicates_(std::move(predicates)), and_connectors_(std::move(and_connectors)) {}
+
+  dberr_t Init() override { return child_->Init(); }
+
+  VectorBatch *NextBatch() override;
+
+ private:
+  // match[j] = whether selected row j satisfies the predicate
+  void Evaluate(const VectorPredicate &predicate, const VectorBatch &batch, std::vector<uint8_t> &match) const;
+
+  std::unique_ptr<VectorOperator> child_;
+  std::vector<VectorPredicate> predicates_;
+  std::vector<bool> and_connectors_;
+  std::vector<uint8_t> result_;
+  std::vector<uint8_t> match_;
+};
+
+/**
+ * Gather the selected rows of the given columns into a dense batch.
+ */
+class VectorProjectionOperator : public VectorOperator {
+ public:
+  VectorProjectionOperator(std::unique_ptr<VectorOperator> child, std::vector<uint32_t> columns)
+      : child_(std::move(child)), columns_(std::move(columns)) {}
+
+  dberr_t Init() override { return child_->Init(); }
+
+  VectorBatch *NextBatch() override;
+
+ private:
+  std::unique_ptr<VectorOperator> child_;
+  std::vector<uint32_t> columns_;
+  VectorBatch batch_;
+};
+
+enum class AggregateType : uint8_t { kCount, kSum, kMin, kMax, kAvg };
+
+/**
+ * Aggregate the selected rows of the child into a single row, with the same
+ * results as HashAggregateOperator without group columns. COUNT yields an int,
+ * counting every row when the column is negative (COUNT(*)) and the non-null
+ * values otherwise. SUM, AVG, MIN and MAX take numbers, skip nulls and are
+ * null without values. AVG yields a float; SUM, MIN and MAX yield the type of
+ * the column, an int sum out of the range of int failing the operator.
+ */
+class VectorAggregateOperator : public VectorOperator {
+ public:
+  VectorAggregateOperator(std::unique_ptr<VectorOperator> child, std::vector<std::pair<AggregateType, int>> aggregates)
+      : child_(std::move(child)), aggregates_(std::move(aggregates)) {}
+
+  dberr_t Init() override;
+
+  VectorBatch *NextBatch() override;
+
+ private:
+  std::unique_ptr<VectorOperator> child_;
+  std::vector<std::pair<AggregateType, int>> aggregates_;
+  bool done_{false};
+  VectorBatch batch_;
+};
+
+#endif  // MINISQL_VECTOR_OPERATORS_H
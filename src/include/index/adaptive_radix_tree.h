@@ -0,0 +1,135 @@
+#ifndef MINISQL_ADAPTIVE_RADIX_TREE_H
+#define MINISQL_ADAPTIVE_RADIX_TREE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/rowid.h"
+
+/**
+ * In-memory adaptive radix tree over binary comparable keys.
+ *
+ * (1) We only support unique key, and no key may be a prefix of another one,
+ *     callers encode keys with a terminator to guarantee that
+ * (2) Inner nodes hold 4, 16, 48 or 256 children and grow or shrink with the
+ *     number of children they have
+ * (3) Paths without branches are compressed into the prefix of the node
+ *     below, so a lookup compares each key byte at most once
+ * (4) Children are kept in byte order, an in-order walk yields sorted keys
+ */
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree() = default;
+
+  ~AdaptiveRadixTree() { Clear(); }
+
+  AdaptiveRadixTree(const AdaptiveRadixTree &) = delete;
+
+  AdaptiveRadixTree &operator=(const AdaptiveRadixTree &) = delete;
+
+  // return false if the key exists
+  bool Insert(const std::string &key, RowId value);
+
+  bool Lookup(const std::string &key, RowId &value) const;
+
+  // return false if the key does not exist
+  bool Remove(const std::string &key);
+
+  // values of the keys with low <= key <= high in key order, a null bound is open
+  void Range(const std::string *low, const std::string *high, std::vector<RowId> &result) const;
+
+  // values of the keys starting with prefix in key order
+  void PrefixScan(const std::string &prefix, std::vector<RowId> &result) const;
+
+  void Clear();
+
+  size_t Size() const { return size_; }
+
+  // number of inner nodes of each kind, in the order 4, 16, 48, 256
+  std::vector<size_t> GetNodeCounts() const;
+
+ private:
+  enum NodeType : uint8_t { kLeaf, kNode4, kNode16, kNode48, kNode256 };
+
+  struct Node {
+    explicit Node(NodeType node_type) : type(node_type) {}
+    NodeType type;
+    uint16_t child_count{0};
+    // compressed path between the parent slot and this node
+    std::string prefix;
+  };
+
+  struct Leaf : Node {
+    Leaf(const std::string &leaf_key, RowId leaf_value) : Node(kLeaf), key(leaf_key), value(leaf_value) {}
+    std::string key;
+    RowId value;
+  };
+
+  // sorted keys, children[i] belongs to keys[i]
+  struct Node4 : Node {
+    Node4() : Node(kNode4) {}
+    uint8_t keys[4]{};
+    Node *children[4]{};
+  };
+
+  struct Node16 : Node {
+    Node16() : Node(kNode16) {}
+    uint8_t keys[16]{};
+    Node *children[16]{};
+  };
+
+  // child_index[byte] is the slot of the child plus one, 0 if there is none
+  struct Node48 : Node {
+    Node48() : Node(kNode48) {}
+    uint8_t child_index[256]{};
+    Node *children[48]{};
+  };
+
+  struct Node256 : Node {
+    Node256() : Node(kNode256) {}
+    Node *children[256]{};
+  };
+
+  static Node **FindChild(Node *node, uint8_t byte);
+
+  static bool IsFull(const Node *node);
+
+  // add a child to a node with room for it
+  static void AddChild(Node *node, uint8_t byte, Node *child);
+
+  static void RemoveChild(Node *node, uint8_t byte);
+
+  // replace node by the next larger kind, node is freed
+  static Node *Grow(Node *node);
+
+  // replace node by the next smaller kind once it is sparse enough, node is freed then
+  static Node *Shrink(Node *node);
+
+  // call func(byte, child) for every child in byte order, stop once it returns false
+  template <typename Func>
+  static bool ForEachChild(const Node *node, Func &&func);
+
+  // free node but none of its children
+  static void DeleteNode(Node *node);
+
+  // free node and everything below it
+  static void FreeNode(Node *node);
+
+  static void CollectAll(const Node *node, std::vector<RowId> &result);
+
+  bool InsertAt(Node *&node, const std::string &key, size_t depth, RowId value);
+
+  bool RemoveAt(Node *&node, const std::string &key, size_t depth);
+
+  // return false once a key past high is reached
+  bool RangeAt(const Node *node, std::string &path, const std::string *low, const std::string *high,
+               std::vector<RowId> &result) const;
+
+  void CountNodes(const Node *node, std::vector<size_t> &counts) const;
+
+  Node *root_{nullptr};
+  size_t size_{0};
+};
+
+#endif  // MINISQL_ADAPTIVE_RADIX_TREE_H
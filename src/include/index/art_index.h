@@ -0,0 +1,50 @@
+#ifndef MINISQL_ART_INDEX_H
+#define MINISQL_ART_INDEX_H
+
+#include "index/adaptive_radix_tree.h"
+#include "index/index.h"
+
+/**
+ * Index kept only in memory for hot tables. Nothing is written to disk, the
+ * catalog rebuilds it from the table heap whenever the index is loaded.
+ */
+class ARTIndex : public Index {
+public:
+  ARTIndex(index_id_t index_id, IndexSchema *key_schema);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) override;
+
+  dberr_t ScanRange(const Row *low, const Row *high, std::vector<RowId> &result, Transaction *txn) override;
+
+  // row ids of the keys whose leading fields equal the fields of prefix, in key order
+  dberr_t ScanPrefix(const Row &prefix, std::vector<RowId> &result, Transaction *txn);
+
+  // the tree lives in memory, a probe reads no page
+  uint32_t GetLookupPages() override { return 0; }
+
+  dberr_t Destroy() override;
+
+  size_t GetSize() const { return container_.Size(); }
+
+  std::vector<size_t> GetNodeCounts() const { return container_.GetNodeCounts(); }
+
+  /**
+   * Encode the fields of key so that comparing the encodings byte by byte orders
+   * them like the fields. Each field is a null tag followed by its value: ints
+   * big-endian with the sign bit flipped, floats with the sign bit flipped or all
+   * bits flipped if negative (-0.0 as 0.0), and chars with 0x00 escaped as 0x00 0xFF and a
+   * trailing 0x00 0x00, so that no encoding is a prefix of another one.
+   */
+  static std::string EncodeKey(const Row &key, uint32_t field_count);
+
+protected:
+  AdaptiveRadixTree container_;
+};
+
+#endif //MINISQL_ART_INDEX_H
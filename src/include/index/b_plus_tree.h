@@ -1,8 +1,10 @@
 #ifndef MINISQL_B_PLUS_TREE_H
 #define MINISQL_B_PLUS_TREE_H
 
+#include <map>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "index/index_iterator.h"
@@ -13,6 +15,19 @@
 
 #define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
 
+/**
+ * Shape of a b+ tree gathered by walking every page. A fill factor is the
+ * number of entries divided by the capacity of the pages on that level.
+ */
+struct BPlusTreeStatistics {
+  int height{0};
+  size_t leaf_pages{0};
+  size_t internal_pages{0};
+  size_t entries{0};
+  double leaf_fill_factor{0};
+  double internal_fill_factor{0};
+};
+
 /**
  * Main class providing the API for the Interactive B+ Tree.
  *
@@ -22,6 +37,9 @@
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ * (5) With the change buffer enabled, an insert whose leaf is not in the
+ *     buffer pool can be parked in memory under the leaf page id, and is
+ *     merged into the leaf the next time a descent reaches it
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTree {
@@ -38,12 +56,20 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   bool Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
 
+  // Insert in a single descent unless the key exists, the value of an existing key is written to existing.
+  bool InsertIfAbsent(const KeyType &key, const ValueType &value, ValueType *existing = nullptr,
+                      Transaction *transaction = nullptr);
+
   // Remove a key and its value from this B+ tree.
   void Remove(const KeyType &key, Transaction *transaction = nullptr);
 
   // return the value associated with a given key
   bool GetValue(const KeyType &key, std::vector<ValueType> &result, Transaction *transaction = nullptr);
 
+  // look up keys sorted in ascending order, found[i] tells whether values[i] holds the value of keys[i]
+  void GetValues(const std::vector<KeyType> &keys, std::vector<ValueType> &values, std::vector<bool> &found,
+                 Transaction *transaction = nullptr);
+
   INDEXITERATOR_TYPE Begin();
 
   INDEXITERATOR_TYPE Begin(const KeyType &key);
@@ -56,9 +82,32 @@ class BPlusTree {
   // used to check whether all pages are unpinned
   bool Check();
 
-  // destroy the b plus tree
+  // destroy the b plus tree, deleting every page level by level
   void Destroy();
 
+  // number of levels, leaves included, counted along the left most path once after each root change
+  int GetHeight();
+
+  // walk the tree level by level and report page counts and fill factors
+  BPlusTreeStatistics GetStatistics();
+
+  // keep the internal pages of the top levels pinned, so that a descent only fetches the leaf
+  void EnableNodeCache(int levels, size_t max_pages = INDEX_NODE_CACHE_PAGES);
+
+  // buffer up to capacity inserts into non-resident leaves, 0 disables the buffer
+  void EnableChangeBuffer(size_t capacity = INDEX_CHANGE_BUFFER_SIZE);
+
+  /**
+   * Park a new key in the change buffer if its leaf is not resident, without reading the leaf.
+   * The caller must know that the key is not in the tree. Return false if the key was not buffered.
+   */
+  bool BufferInsert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // merge every buffered insert into its leaf, leaves are visited in page id order
+  void MergeChangeBuffer();
+
+  size_t GetBufferedCount() const { return buffered_count_; }
+
   void PrintTree(std::ofstream &out) {
     if (IsEmpty()) {
       return;
@@ -73,13 +122,15 @@ class BPlusTree {
  private:
   void StartNewTree(const KeyType &key, const ValueType &value);
 
-  bool InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+  bool InsertIntoLeaf(const KeyType &key, const ValueType &value, ValueType *existing = nullptr,
+                      Transaction *transaction = nullptr);
 
   void InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
-                        Transaction *transaction = nullptr);
+                        Transaction *transaction = nullptr, bool right_edge = false);
 
+  // right_edge splits keep RIGHT_EDGE_FILL_PERCENT of the entries in node instead of half
   template <typename N>
-  N *Split(N *node);
+  N *Split(N *node, bool right_edge = false);
 
   template <typename N>
   bool CoalesceOrRedistribute(N *node, Transaction *transaction = nullptr);
@@ -93,8 +144,20 @@ class BPlusTree {
 
   bool AdjustRoot(BPlusTreePage *node);
 
+  // pin the cached levels, called by the first descent after the cache was released
+  void LoadNodeCache();
+
+  // unpin every cached page, must be called before internal pages are added, deleted or replaced
+  void ReleaseNodeCache();
+
   void UpdateRootPageId(int insert_record = 0);
 
+  // page id of the leaf holding key, found by reading internal pages only
+  page_id_t FindLeafPageId(const KeyType &key);
+
+  // insert the buffered entries of the leaf again through the normal path, return false if there are none
+  bool MergeChanges(page_id_t leaf_page_id);
+
   /* Debug Routines for FREE!! */
   void ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstream &out) const;
 
@@ -107,6 +170,25 @@ class BPlusTree {
   KeyComparator comparator_;
   int leaf_max_size_;
   int internal_max_size_;
+  // right most leaf seen by the last insert, appends past its last key skip the descent
+  page_id_t rightmost_leaf_id_{INVALID_PAGE_ID};
+  // swizzled references to the frames of the root and the right most leaf
+  Page *root_frame_{nullptr};
+  Page *rightmost_leaf_frame_{nullptr};
+  // pinned internal pages of the top node_cache_levels_ levels, 0 levels means no cache
+  int node_cache_levels_{0};
+  size_t node_cache_capacity_{0};
+  bool node_cache_loaded_{false};
+  std::unordered_map<page_id_t, Page *> node_cache_;
+  // number of levels including the leaves, 0 if not known since the root last changed
+  int height_{0};
+  // inserts waiting for their leaf, a leaf with pending entries is never split, merged or redistributed
+  size_t change_buffer_capacity_{0};
+  size_t buffered_count_{0};
+  std::map<page_id_t, std::vector<MappingType>> change_buffer_;
+
+  // share of entries left behind when a page on the right edge splits on an append
+  static constexpr int RIGHT_EDGE_FILL_PERCENT = 90;
 };
 
 #endif  // MINISQL_B_PLUS_TREE_H
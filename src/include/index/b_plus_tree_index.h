@@ -1,7 +1,10 @@
 #ifndef MINISQL_B_PLUS_TREE_INDEX_H
 #define MINISQL_B_PLUS_TREE_INDEX_H
 
+#include <algorithm>
+
 #include "index/b_plus_tree.h"
+#include "index/bloom_filter.h"
 #include "index/index.h"
 
 #define BPLUSTREE_INDEX_TYPE BPlusTreeIndex<KeyType, ValueType, KeyComparator>
@@ -13,10 +16,23 @@ public:
 
   dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) override;
 
+  dberr_t InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) override;
+
   dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) override;
 
   dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) override;
 
+  // sort the probes and look them up in one left to right pass over the leaves
+  dberr_t ScanKeys(const std::vector<Row> &keys, std::vector<RowId> &result, Transaction *txn) override;
+
+  dberr_t ScanRange(const Row *low, const Row *high, std::vector<RowId> &result, Transaction *txn) override;
+
+  // one page per level of the tree
+  uint32_t GetLookupPages() override { return std::max(container_.GetHeight(), 1); }
+
+  // merge the inserts waiting in the change buffer
+  dberr_t Flush() override;
+
   dberr_t Destroy() override;
 
   INDEXITERATOR_TYPE GetBeginIterator();
@@ -25,11 +41,40 @@ public:
 
   INDEXITERATOR_TYPE GetEndIterator();
 
+  // page counts and fill factors of the underlying tree
+  BPlusTreeStatistics GetStatistics();
+
+  // pin the top levels of the tree, see BPlusTree::EnableNodeCache
+  void EnableNodeCache(int levels, size_t max_pages = INDEX_NODE_CACHE_PAGES);
+
+  // buffer new keys whose leaf is not resident, see BPlusTree::BufferInsert
+  void EnableChangeBuffer(size_t capacity = INDEX_CHANGE_BUFFER_SIZE);
+
+  size_t GetBufferedCount() const { return container_.GetBufferedCount(); }
+
+  // true if key may be in the index, false means ScanKey can skip the tree descent;
+  // the filter is built from the leaves on the first call
+  bool MayContain(const KeyType &key);
+
 protected:
+  // rebuild the bloom filter from the leaves, sized for twice the current keys
+  void RebuildFilter();
+
+  // add the canonical bytes of the key to the filter, see GenericComparator::Canonicalize
+  void AddToFilter(const KeyType &key);
+
+
   // comparator for key
   KeyComparator comparator_;
   // container
   BPLUSTREE_TYPE container_;
+  // bloom filter over all keys, built by the first probe so that loading the catalog reads no leaves
+  BloomFilter filter_;
+  bool filter_built_{false};
+  // a key with a null column is stored, it matches any probe so the filter cannot rule one out
+  bool has_null_key_{false};
+  // entries removed since the last rebuild, their bits are still set in filter_
+  size_t removed_count_{0};
 };
 
 #endif //MINISQL_B_PLUS_TREE_INDEX_H
@@ -0,0 +1,43 @@
+#ifndef MINISQL_BLOOM_FILTER_H
+#define MINISQL_BLOOM_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * In-memory Bloom filter over raw key bytes.
+ *
+ * A negative answer from MayContain is exact, a positive answer may be false
+ * with a probability of about 1% while no more than GetCapacity() keys were
+ * added. The filter can not remove keys, owners rebuild it from the index
+ * when too many keys were removed or the capacity is exceeded.
+ */
+class BloomFilter {
+ public:
+  explicit BloomFilter(size_t capacity = DEFAULT_CAPACITY);
+
+  // drop all keys and resize for capacity keys
+  void Reset(size_t capacity);
+
+  void Add(const char *data, size_t size);
+
+  bool MayContain(const char *data, size_t size) const;
+
+  size_t GetKeyCount() const { return key_count_; }
+
+  size_t GetCapacity() const { return capacity_; }
+
+  static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+ private:
+  static constexpr uint32_t BITS_PER_KEY = 10;
+  static constexpr uint32_t NUM_HASHES = 7;
+
+  std::vector<uint64_t> bits_;
+  uint64_t num_bits_{0};
+  size_t key_count_{0};
+  size_t capacity_{0};
+};
+
+#endif  // MINISQL_BLOOM_FILTER_H
@@ -0,0 +1,78 @@
+#ifndef MINISQL_EXTENDIBLE_HASH_TABLE_H
+#define MINISQL_EXTENDIBLE_HASH_TABLE_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "page/hash_table_bucket_page.h"
+#include "page/hash_table_directory_page.h"
+#include "transaction/transaction.h"
+
+#define EXTENDIBLE_HASH_TABLE_TYPE ExtendibleHashTable<KeyType, ValueType, KeyComparator>
+
+/**
+ * Disk based extendible hash table.
+ *
+ * (1) We only support unique key
+ * (2) support insert & remove & point lookup, no range scan
+ * (3) Buckets split when full and merge with their split image when empty,
+ *     the directory grows and shrinks accordingly. Once the directory is at
+ *     its max depth, a full bucket links overflow pages instead of splitting
+ * (4) The directory page id is kept in the index roots page like the root
+ *     page id of a b+ tree
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class ExtendibleHashTable {
+  using BucketPage = HASH_TABLE_BUCKET_TYPE;
+
+ public:
+  explicit ExtendibleHashTable(index_id_t index_id, BufferPoolManager *buffer_pool_manager,
+                               const KeyComparator &comparator);
+
+  // Returns true if this hash table has no directory yet.
+  bool IsEmpty() const;
+
+  // Insert a key-value pair, return false on duplicate key.
+  bool Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // Remove a key and its value from this hash table.
+  void Remove(const KeyType &key, Transaction *transaction = nullptr);
+
+  // return the value associated with a given key
+  bool GetValue(const KeyType &key, std::vector<ValueType> &result, Transaction *transaction = nullptr);
+
+  // used to check whether all pages are unpinned
+  bool Check();
+
+  // release every page of the hash table
+  void Destroy();
+
+  uint32_t GetGlobalDepth();
+
+ private:
+  uint32_t Hash(const KeyType &key) const;
+
+  HashTableDirectoryPage *FetchDirectoryPage();
+
+  BucketPage *FetchBucketPage(page_id_t bucket_page_id);
+
+  void StartNewTable();
+
+  bool SplitInsert(const KeyType &key, const ValueType &value);
+
+  bool OverflowInsert(BucketPage *bucket, const KeyType &key, const ValueType &value);
+
+  bool OverflowRemove(BucketPage *bucket, const KeyType &key);
+
+  void Merge(const KeyType &key);
+
+  void UpdateDirectoryPageId();
+
+  // member variable
+  index_id_t index_id_;
+  page_id_t directory_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+};
+
+#endif  // MINISQL_EXTENDIBLE_HASH_TABLE_H
@@ -3,6 +3,7 @@
 
 #include <cstring>
 
+#include "record/compare_kernels.h"
 #include "record/row.h"
 #include "record/field.h"
 
@@ -18,6 +19,9 @@ public:
     key.SerializeTo(data, schema);
   }
 
+  // whether the serialized key fits into KeySize bytes
+  inline static bool Fits(const Row &key, Schema *schema) { return key.GetSerializedSize(schema) <= KeySize; }
+
   inline void DeserializeToKey(Row &key, Schema *schema) const {
     uint32_t ofs = key.DeserializeFrom(const_cast<char *>(data), schema);
     ASSERT(ofs <= KeySize, "Index key size exceed max key size.");
@@ -48,41 +52,104 @@ public:
 
 /**
  * Function object returns true if lhs < rhs, used for trees
+ *
+ * Keys are compared in their serialized form (Row::SerializeTo: field count,
+ * null bitmap, then the fields that are not null) without building rows. The
+ * column types are read from the key schema once, when the comparator is made.
+ * A null column compares equal to anything, as with the Field comparisons.
  */
 template<size_t KeySize>
 class GenericComparator {
 public:
   inline int operator()(const GenericKey<KeySize> &lhs,
                         const GenericKey<KeySize> &rhs) const {
-    int column_count = key_schema_->GetColumnCount();
-    Row lhs_key(INVALID_ROWID);
-    Row rhs_key(INVALID_ROWID);
-    lhs.DeserializeToKey(lhs_key, key_schema_);
-    rhs.DeserializeToKey(rhs_key, key_schema_);
-
-    for (int i = 0; i < column_count; i++) {
-      Field *lhs_value = lhs_key.GetField(i);
-      Field *rhs_value = rhs_key.GetField(i);
-
-      if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue)
-        return -1;
-
-      if (lhs_value->CompareGreaterThan(*rhs_value) == CmpBool::kTrue)
-        return 1;
+    uint32_t column_count = static_cast<uint32_t>(types_.size());
+    const char *lhs_nulls = lhs.data + sizeof(uint32_t);
+    const char *rhs_nulls = rhs.data + sizeof(uint32_t);
+    const char *lhs_pos = lhs_nulls + sizeof(int) * ((column_count + 7) / 8);
+    const char *rhs_pos = rhs_nulls + sizeof(int) * ((column_count + 7) / 8);
+
+    for (uint32_t i = 0; i < column_count; i++) {
+      bool lhs_present = (MACH_READ_FROM(int, lhs_nulls + sizeof(int) * (i / 8)) >> (i % 8)) & 1;
+      bool rhs_present = (MACH_READ_FROM(int, rhs_nulls + sizeof(int) * (i / 8)) >> (i % 8)) & 1;
+      int cmp = 0;
+      switch (types_[i]) {
+        case kTypeInt:
+          if (lhs_present && rhs_present) {
+            cmp = CompareNumbers(MACH_READ_INT32(lhs_pos), MACH_READ_INT32(rhs_pos));
+          }
+          lhs_pos += lhs_present ? sizeof(int32_t) : 0;
+          rhs_pos += rhs_present ? sizeof(int32_t) : 0;
+          break;
+        case kTypeFloat:
+          if (lhs_present && rhs_present) {
+            cmp = CompareNumbers(MACH_READ_FROM(float, lhs_pos), MACH_READ_FROM(float, rhs_pos));
+          }
+          lhs_pos += lhs_present ? sizeof(float) : 0;
+          rhs_pos += rhs_present ? sizeof(float) : 0;
+          break;
+        default: {
+          uint32_t lhs_len = lhs_present ? MACH_READ_UINT32(lhs_pos) : 0;
+          uint32_t rhs_len = rhs_present ? MACH_READ_UINT32(rhs_pos) : 0;
+          if (lhs_present && rhs_present) {
+            cmp = CompareChars(lhs_pos + sizeof(uint32_t), lhs_len, rhs_pos + sizeof(uint32_t), rhs_len);
+          }
+          lhs_pos += lhs_present ? sizeof(uint32_t) + lhs_len : 0;
+          rhs_pos += rhs_present ? sizeof(uint32_t) + rhs_len : 0;
+          break;
+        }
+      }
+      if (cmp != 0) {
+        return cmp;
+      }
     }
     // equals
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) {
-    this->key_schema_ = other.key_schema_;
+  /**
+   * Rewrite the key so that keys comparing equal have the same bytes, which
+   * is what hashing a key needs: a float -0.0 becomes 0.0. Returns false when
+   * a column is null, as a null compares equal to every value and no bytes
+   * stand for all of them.
+   */
+  inline bool Canonicalize(GenericKey<KeySize> &key) const {
+    uint32_t column_count = static_cast<uint32_t>(types_.size());
+    const char *nulls = key.data + sizeof(uint32_t);
+    char *pos = key.data + sizeof(uint32_t) + sizeof(int) * ((column_count + 7) / 8);
+    for (uint32_t i = 0; i < column_count; i++) {
+      if (((MACH_READ_FROM(int, nulls + sizeof(int) * (i / 8)) >> (i % 8)) & 1) == 0) {
+        return false;
+      }
+      switch (types_[i]) {
+        case kTypeInt:
+          pos += sizeof(int32_t);
+          break;
+        case kTypeFloat:
+          if (MACH_READ_FROM(float, pos) == 0) {
+            MACH_WRITE_TO(float, pos, 0.0f);
+          }
+          pos += sizeof(float);
+          break;
+        default:
+          pos += sizeof(uint32_t) + MACH_READ_UINT32(pos);
+          break;
+      }
+    }
+    return true;
   }
 
+  GenericComparator(const GenericComparator &other) = default;
+
   // constructor
-  GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  GenericComparator(Schema *key_schema) : types_(key_schema->GetColumnCount()) {
+    for (uint32_t i = 0; i < types_.size(); i++) {
+      types_[i] = key_schema->GetColumn(i)->GetType();
+    }
+  }
 
 private:
-  Schema *key_schema_;
+  std::vector<TypeId> types_;
 };
 
 #endif  // MINISQL_GENERIC_KEY_H
@@ -7,6 +7,11 @@
 #include "record/row.h"
 #include "transaction/transaction.h"
 
+/**
+ * Access method backing an index, persisted with the index metadata.
+ */
+enum IndexType : uint32_t { kIndexBPlusTree = 0, kIndexHash, kIndexLSM, kIndexART, kIndexPrefixBPlusTree };
+
 class Index {
 public:
   explicit Index(index_id_t index_id, IndexSchema *key_schema)
@@ -16,10 +21,41 @@ public:
 
   virtual dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) = 0;
 
+  // insert unless the key exists, return DB_KEY_ALREADY_EXIST in that case
+  virtual dberr_t InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) = 0;
+
   virtual dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) = 0;
 
   virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) = 0;
 
+  // probe a batch of keys, result[i] is the row id of keys[i] or INVALID_ROWID if absent
+  virtual dberr_t ScanKeys(const std::vector<Row> &keys, std::vector<RowId> &result, Transaction *txn) {
+    result.assign(keys.size(), INVALID_ROWID);
+    std::vector<RowId> found;
+    for (size_t i = 0; i < keys.size(); i++) {
+      found.clear();
+      dberr_t res = ScanKey(keys[i], found, txn);
+      if (res != DB_SUCCESS) {
+        return res;
+      }
+      if (!found.empty()) {
+        result[i] = found[0];
+      }
+    }
+    return DB_SUCCESS;
+  }
+
+  // row ids of the keys with low <= key <= high in key order, a null bound is open. Unordered indexes fail
+  virtual dberr_t ScanRange(const Row *low, const Row *high, std::vector<RowId> &result, Transaction *txn) {
+    return DB_FAILED;
+  }
+
+  // pages read to find the entries of one key, used by the planner to cost a probe
+  virtual uint32_t GetLookupPages() { return 1; }
+
+  // persist entries buffered in memory, called when the catalog shuts down
+  virtual dberr_t Flush() { return DB_SUCCESS; }
+
   virtual dberr_t Destroy() = 0;
 
 protected:
@@ -9,8 +9,13 @@ INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
  public:
   // you may define your own constructor based on your member variables
+  // the iterator takes over the pin of Leafpage and keeps its current leaf pinned
   explicit IndexIterator(B_PLUS_TREE_LEAF_PAGE_TYPE *Leafpage, int index, BufferPoolManager *buffer_pool_manager_);
 
+  IndexIterator(const IndexIterator &other);
+
+  IndexIterator &operator=(const IndexIterator &other) = delete;
+
   ~IndexIterator();
 
   /** Return the key/value pair this iterator is currently pointing at. */
@@ -0,0 +1,37 @@
+#ifndef MINISQL_LSM_INDEX_H
+#define MINISQL_LSM_INDEX_H
+
+#include "index/index.h"
+#include "index/lsm_tree.h"
+
+#define LSM_INDEX_TYPE LSMIndex<KeyType, ValueType, KeyComparator>
+
+INDEX_TEMPLATE_ARGUMENTS
+class LSMIndex : public Index {
+public:
+  LSMIndex(index_id_t index_id, IndexSchema *key_schema, BufferPoolManager *buffer_pool_manager);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) override;
+
+  dberr_t ScanRange(const Row *low, const Row *high, std::vector<RowId> &result, Transaction *txn) override;
+
+  dberr_t Flush() override;
+
+  dberr_t Destroy() override;
+
+  size_t GetRunCount() const { return container_.GetRunCount(); }
+
+protected:
+  // comparator for key
+  KeyComparator comparator_;
+  // container
+  LSM_TREE_TYPE container_;
+};
+
+#endif //MINISQL_LSM_INDEX_H
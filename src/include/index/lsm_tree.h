@@ -0,0 +1,124 @@
+#ifndef MINISQL_LSM_TREE_H
+#define MINISQL_LSM_TREE_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/rowid.h"
+#include "index/bloom_filter.h"
+#include "index/skip_list.h"
+#include "page/lsm_manifest_page.h"
+#include "page/lsm_run_page.h"
+#include "transaction/transaction.h"
+
+#define LSM_TREE_TYPE LSMTree<KeyType, ValueType, KeyComparator>
+
+/**
+ * Log structured merge tree.
+ *
+ * (1) We only support unique key, a newer entry of a key shadows all older ones
+ * (2) Inserts and removes go to the memtable, a removed key is recorded as an
+ *     entry holding INVALID_ROWID (a tombstone)
+ * (3) A full memtable is written out sequentially as an immutable sorted run
+ *     on level 0. Once a level holds level_fanout runs they are merged into one
+ *     run of the next level, so every key is rewritten O(log n) times
+ * (4) Each run keeps a bloom filter and the first key of each of its pages in
+ *     memory, a point lookup reads at most one page of every run it can not skip
+ * (5) The manifest page listing the runs is kept in the index roots page like
+ *     the root page id of a b+ tree, the memtable is lost unless Flush is called
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class LSMTree {
+  using RunPage = LSM_RUN_PAGE_TYPE;
+  using RunMeta = LSMManifestPage::RunMeta;
+
+ public:
+  explicit LSMTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
+                   size_t memtable_capacity = LSM_MEMTABLE_CAPACITY, size_t level_fanout = LSM_LEVEL_FANOUT);
+
+  // Returns true if this tree holds neither runs nor memtable entries.
+  bool IsEmpty() const;
+
+  // Insert or overwrite a key-value pair without reading any run.
+  void Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // Insert a key-value pair, return false if the key is present.
+  bool InsertIfAbsent(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // Remove a key by writing a tombstone for it.
+  void Remove(const KeyType &key, Transaction *transaction = nullptr);
+
+  // return the value associated with a given key
+  bool GetValue(const KeyType &key, std::vector<ValueType> &result, Transaction *transaction = nullptr);
+
+  // live entries with low <= key <= high in key order, a null bound is open
+  void GetRange(const KeyType *low, const KeyType *high, std::vector<MappingType> &result,
+                Transaction *transaction = nullptr);
+
+  // write the memtable out as a run
+  void Flush();
+
+  // used to check whether all pages are unpinned
+  bool Check();
+
+  // release every page of the tree
+  void Destroy();
+
+  size_t GetRunCount() const { return runs_.size(); }
+
+  size_t GetMemtableSize() const { return memtable_.Size(); }
+
+ private:
+  struct Run {
+    RunMeta meta;
+    std::vector<page_id_t> page_ids;
+    // first key of every page
+    std::vector<KeyType> fences;
+    BloomFilter filter;
+    // a key with a null column matches any probe, the filter cannot rule one out
+    bool has_null_key{false};
+  };
+
+  bool IsTombstone(const ValueType &value) const { return value == INVALID_ROWID; }
+
+  // newest entry of key in the memtable or the runs, tombstones included
+  bool Find(const KeyType &key, ValueType &value);
+
+  bool LookupRun(const Run &run, const KeyType &key, ValueType &value);
+
+  // entries of run with low <= key <= high, a null bound is open
+  void ReadRun(const Run &run, const KeyType *low, const KeyType *high, std::vector<MappingType> &result);
+
+  // merge two sorted entry lists, newer wins on equal keys
+  void MergeSorted(const std::vector<MappingType> &newer, const std::vector<MappingType> &older,
+                   std::vector<MappingType> &result) const;
+
+  // write sorted entries as a run, return false if there is nothing to write
+  bool WriteRun(const std::vector<MappingType> &entries, uint32_t level, Run &run);
+
+  // add the canonical bytes of the key to the filter of the run
+  void AddToFilter(Run &run, const KeyType &key);
+
+  // walk the page chain of a run to rebuild its page ids, fences and filter
+  void LoadRun(const RunMeta &meta, Run &run);
+
+  void FreeRuns(const std::vector<Run> &runs);
+
+  // merge full levels into the next level until no level is full
+  void Compact();
+
+  void UpdateManifest();
+
+  // member variable
+  index_id_t index_id_;
+  page_id_t manifest_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+  SKIP_LIST_TYPE memtable_;
+  // oldest first, so levels descend from front to back
+  std::vector<Run> runs_;
+  size_t memtable_capacity_;
+  size_t level_fanout_;
+};
+
+#endif  // MINISQL_LSM_TREE_H
@@ -0,0 +1,88 @@
+#ifndef MINISQL_PREFIX_B_PLUS_TREE_H
+#define MINISQL_PREFIX_B_PLUS_TREE_H
+
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "index/b_plus_tree.h"
+#include "page/prefix_b_plus_tree_page.h"
+
+/**
+ * B+ tree over variable length binary comparable keys, stored in slotted
+ * PrefixBPlusTreePage pages.
+ *
+ * (1) We only support unique key
+ * (2) Every page stores the prefix shared by its keys once, so keys with long
+ *     common prefixes (URLs, tenant-prefixed ids) take only their distinct
+ *     bytes in a slot
+ * (3) A leaf split promotes the shortest key that separates the last key of
+ *     the left page from the first one of the right page, not a whole key, and
+ *     picks the split point near the middle with the shortest such separator
+ * (4) A change rewrites the whole page from its decoded entries, and pages are
+ *     split on bytes rather than entry counts. They are not merged on removal:
+ *     an emptied leaf stays in the chain until the tree is destroyed
+ * (5) The root page id is kept in the index roots page
+ */
+class PrefixBPlusTree {
+ public:
+  PrefixBPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager);
+
+  bool IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
+
+  page_id_t GetRootPageId() const { return root_page_id_; }
+
+  // return false if the key exists. The key must not be longer than MAX_KEY_SIZE
+  bool Insert(const std::string &key, RowId value);
+
+  // return false if the key does not exist
+  bool Remove(const std::string &key);
+
+  bool GetValue(const std::string &key, RowId &value);
+
+  // values of the keys with low <= key <= high in key order, a null bound is open
+  void Range(const std::string *low, const std::string *high, std::vector<RowId> &result);
+
+  void Destroy();
+
+  // fill factors are the bytes in use over the bytes of the pages
+  BPlusTreeStatistics GetStatistics();
+
+  /**
+   * Longest key accepted. Any page then holds at least three entries, and a
+   * page overflowing by one entry can always be split into two that fit.
+   */
+  static constexpr uint32_t MAX_KEY_SIZE = PAGE_SIZE / 4;
+
+  // shortest key s with left < s <= right, for left < right
+  static std::string ShortestSeparator(const std::string &left, const std::string &right);
+
+ private:
+  enum class InsertResult { kDone, kDuplicate, kSplit };
+
+  /**
+   * Insert into the subtree rooted at page_id. On kSplit the subtree root was
+   * split, and separator and new_page_id are to be added to its parent.
+   */
+  InsertResult InsertInto(page_id_t page_id, const std::string &key, RowId value, std::string &separator,
+                          page_id_t &new_page_id);
+
+  // move the upper part of entries, which do not fit page, to a new right sibling
+  void Split(PrefixBPlusTreePage *page, std::vector<PrefixBPlusTreeEntry> &entries, std::string &separator,
+             page_id_t &new_page_id);
+
+  // leaf that would hold key, the leftmost leaf if key is null
+  page_id_t FindLeaf(const std::string *key);
+
+  void UpdateRootPageId(bool insert_record);
+
+  PrefixBPlusTreePage *FetchTreePage(page_id_t page_id) {
+    return reinterpret_cast<PrefixBPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  }
+
+  index_id_t index_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  page_id_t root_page_id_{INVALID_PAGE_ID};
+};
+
+#endif  // MINISQL_PREFIX_B_PLUS_TREE_H
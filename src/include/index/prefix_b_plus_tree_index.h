@@ -0,0 +1,34 @@
+#ifndef MINISQL_PREFIX_B_PLUS_TREE_INDEX_H
+#define MINISQL_PREFIX_B_PLUS_TREE_INDEX_H
+
+#include "index/index.h"
+#include "index/prefix_b_plus_tree.h"
+
+/**
+ * Disk-based index storing its keys in ARTIndex::EncodeKey form in a prefix
+ * compressed b+ tree. Keys take their encoded length instead of a fixed
+ * generic key slot, which suits CHAR keys sharing long prefixes.
+ */
+class PrefixBPlusTreeIndex : public Index {
+public:
+  PrefixBPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, BufferPoolManager *buffer_pool_manager);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) override;
+
+  dberr_t ScanRange(const Row *low, const Row *high, std::vector<RowId> &result, Transaction *txn) override;
+
+  dberr_t Destroy() override;
+
+  BPlusTreeStatistics GetStatistics() { return container_.GetStatistics(); }
+
+protected:
+  PrefixBPlusTree container_;
+};
+
+#endif //MINISQL_PREFIX_B_PLUS_TREE_INDEX_H
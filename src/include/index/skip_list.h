@@ -0,0 +1,64 @@
+#ifndef MINISQL_SKIP_LIST_H
+#define MINISQL_SKIP_LIST_H
+
+#include <random>
+#include <vector>
+
+#include "page/b_plus_tree_page.h"
+
+#define SKIP_LIST_TYPE SkipList<KeyType, ValueType, KeyComparator>
+
+/**
+ * In-memory ordered map used as the memtable of the lsm tree.
+ *
+ * (1) We only support unique key, Put overwrites the value of a present key
+ * (2) Every node gets a random height, so inserts need no rebalancing and the
+ *     bottom level is a sorted list for in-order scans
+ * (3) No removal, the lsm tree records removes as tombstone values
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class SkipList {
+ public:
+  explicit SkipList(const KeyComparator &comparator);
+
+  ~SkipList();
+
+  SkipList(const SkipList &) = delete;
+
+  SkipList &operator=(const SkipList &) = delete;
+
+  // insert the key, or overwrite its value if it is present
+  void Put(const KeyType &key, const ValueType &value);
+
+  bool Get(const KeyType &key, ValueType &value) const;
+
+  // entries with low <= key <= high in key order, a null bound is open
+  void Range(const KeyType *low, const KeyType *high, std::vector<MappingType> &result) const;
+
+  void Clear();
+
+  size_t Size() const { return size_; }
+
+  bool IsEmpty() const { return size_ == 0; }
+
+ private:
+  static constexpr int MAX_HEIGHT = 12;
+
+  struct Node {
+    MappingType item;
+    std::vector<Node *> next;
+  };
+
+  int RandomHeight();
+
+  // first node with key >= key, prev[i] receives the last node before it on level i if not null
+  Node *FindGreaterOrEqual(const KeyType &key, Node **prev) const;
+
+  KeyComparator comparator_;
+  Node head_;
+  int height_{1};
+  size_t size_{0};
+  std::mt19937 rng_;
+};
+
+#endif  // MINISQL_SKIP_LIST_H
@@ -14,12 +14,18 @@
  * K(i) <= K < K(i+1).
  * NOTE: since the number of keys does not equal to number of child pointers,
  * the first key always remains invalid. That is to say, any search/lookup
- * should ignore the first key.
+ * should ignore the first key. A separator is the full first key of the right
+ * child when it split, not a truncated one: every slot has the key size of the
+ * index, so a shorter separator would not raise the fanout. Indexes created
+ * "using prefix" truncate separators in PrefixBPlusTreePage instead.
  *
- * Internal page format (keys are stored in increasing order):
- *  --------------------------------------------------------------------------
- * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
- *  --------------------------------------------------------------------------
+ * Internal page format (keys are stored in increasing order). Keys and child
+ * pointers live in two separate arrays, so a search only touches the cache
+ * lines holding keys:
+ *  ----------------------------------------------------------------------------------
+ * | HEADER | KEY(0) | KEY(1) | ... | KEY(n) | ... | PAGE_ID(0) | ... | PAGE_ID(n) | ... |
+ *  ----------------------------------------------------------------------------------
+ * The child pointer array starts after SLOT_COUNT keys.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeInternalPage : public BPlusTreePage {
@@ -37,6 +43,8 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   ValueType Lookup(const KeyType &key, const KeyComparator &comparator) const;
 
+  int LookupIndex(const KeyType &key, const KeyComparator &comparator) const;
+
   void PopulateNewRoot(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
 
   int InsertNodeAfter(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
@@ -50,6 +58,9 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   void MoveHalfTo(BPlusTreeInternalPage *recipient, BufferPoolManager *buffer_pool_manager);
 
+  // move the entries from index start to the end into recipient, which adopts the moved children
+  void MoveTailTo(BPlusTreeInternalPage *recipient, int start, BufferPoolManager *buffer_pool_manager);
+
   void MoveFirstToEndOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
                         BufferPoolManager *buffer_pool_manager);
 
@@ -57,13 +68,25 @@ class BPlusTreeInternalPage : public BPlusTreePage {
                          BufferPoolManager *buffer_pool_manager);
 
  private:
-  void CopyNFrom(MappingType *items, int size, BufferPoolManager *buffer_pool_manager);
+  // number of key and child slots that fit in a page
+  static constexpr int SLOT_COUNT =
+      (PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / static_cast<int>(sizeof(KeyType) + sizeof(ValueType));
+
+  inline ValueType *Children() {
+    return reinterpret_cast<ValueType *>(reinterpret_cast<char *>(keys_) + sizeof(KeyType) * SLOT_COUNT);
+  }
+
+  inline const ValueType *Children() const {
+    return reinterpret_cast<const ValueType *>(reinterpret_cast<const char *>(keys_) + sizeof(KeyType) * SLOT_COUNT);
+  }
+
+  void CopyNFrom(const KeyType *keys, const ValueType *children, int size, BufferPoolManager *buffer_pool_manager);
 
   void CopyLastFrom(const MappingType &pair, BufferPoolManager *buffer_pool_manager);
 
   void CopyFirstFrom(const MappingType &pair, BufferPoolManager *buffer_pool_manager);
 
-  MappingType array_[0];
+  KeyType keys_[0];
 };
 
 #endif  // MINISQL_B_PLUS_TREE_INTERNAL_PAGE_H
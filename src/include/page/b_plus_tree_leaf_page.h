@@ -8,6 +8,10 @@
  * see include/common/rid.h for detailed implementation) together within leaf
  * page. Only support unique key.
 
+ * Keys are stored whole in fixed-width slots, the width being the key size
+ * of the index. Pages keep no common prefix, so keys sharing a long prefix
+ * still repeat it in every slot; PrefixBPlusTreePage stores it once.
+ *
  * Leaf page format (keys are stored in order):
  *  ----------------------------------------------------------------------
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
@@ -58,6 +62,9 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   // Split and Merge utility methods
   void MoveHalfTo(BPlusTreeLeafPage *recipient);
 
+  // move the entries from index start to the end into recipient
+  void MoveTailTo(BPlusTreeLeafPage *recipient, int start);
+
   void MoveAllTo(BPlusTreeLeafPage *recipient);
 
   void MoveFirstToEndOf(BPlusTreeLeafPage *recipient, BufferPoolManager *buffer_pool_manager);
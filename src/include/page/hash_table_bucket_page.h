@@ -0,0 +1,73 @@
+#ifndef MINISQL_HASH_TABLE_BUCKET_PAGE_H
+#define MINISQL_HASH_TABLE_BUCKET_PAGE_H
+
+/**
+ * hash_table_bucket_page.h
+ *
+ * Store indexed key and record id together within a bucket of the extendible
+ * hash index. Entries are not ordered, only support unique key. A bucket that
+ * can not split any more, because the directory is at its max depth, links
+ * overflow pages of the same format through NextPageId.
+ *
+ * Bucket page format:
+ *  ----------------------------------------------------------------------
+ * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
+ *  ----------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 12 bytes in total):
+ *  ---------------------------------------------
+ * | PageId (4) | CurrentSize (4) | NextPageId (4)
+ *  ---------------------------------------------
+ */
+#include <utility>
+
+#include "page/b_plus_tree_page.h"
+
+#define HASH_TABLE_BUCKET_TYPE HashTableBucketPage<KeyType, ValueType, KeyComparator>
+#define BUCKET_PAGE_HEADER_SIZE 12
+#define BUCKET_ARRAY_SIZE ((PAGE_SIZE - BUCKET_PAGE_HEADER_SIZE) / sizeof(MappingType))
+
+INDEX_TEMPLATE_ARGUMENTS
+class HashTableBucketPage {
+ public:
+  // must call initialize method after "create" a new bucket page
+  void Init(page_id_t page_id);
+
+  page_id_t GetPageId() const { return page_id_; }
+
+  // next page of the overflow chain, INVALID_PAGE_ID at the end of the chain
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  int GetSize() const { return size_; }
+
+  bool IsFull() const { return size_ >= static_cast<int>(BUCKET_ARRAY_SIZE); }
+
+  bool IsEmpty() const { return size_ == 0; }
+
+  KeyType KeyAt(int index) const { return array_[index].first; }
+
+  ValueType ValueAt(int index) const { return array_[index].second; }
+
+  bool Lookup(const KeyType &key, ValueType &value, const KeyComparator &comparator) const;
+
+  // return false if the key exists or the bucket is full
+  bool Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator);
+
+  // return false if the key does not exist
+  bool Remove(const KeyType &key, const KeyComparator &comparator);
+
+  // remove the entry at index by moving the last entry into its place
+  void RemoveAt(int index);
+
+ private:
+  int KeyIndex(const KeyType &key, const KeyComparator &comparator) const;
+
+  page_id_t page_id_;
+  int size_;
+  page_id_t next_page_id_;
+  MappingType array_[0];
+};
+
+#endif  // MINISQL_HASH_TABLE_BUCKET_PAGE_H
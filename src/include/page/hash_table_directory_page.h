@@ -0,0 +1,67 @@
+#ifndef MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
+#define MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+#define DIRECTORY_PAGE_HEADER_SIZE 8
+#define DIRECTORY_MAX_DEPTH 9
+#define DIRECTORY_ARRAY_SIZE (1 << DIRECTORY_MAX_DEPTH)
+
+/**
+ * Directory page of the extendible hash index. The lowest global_depth bits of the
+ * hash of a key select a directory slot, and each slot points to a bucket page.
+ * Several slots share a bucket when the local depth of the bucket is smaller than
+ * the global depth.
+ *
+ * Directory page format (size in byte):
+ *  ---------------------------------------------------------------------------------
+ * | PageId (4) | GlobalDepth (4) | LocalDepth (1) * 512 | BucketPageId (4) * 512 |
+ *  ---------------------------------------------------------------------------------
+ */
+class HashTableDirectoryPage {
+ public:
+  // must call initialize method after "create" a new directory page
+  void Init(page_id_t page_id);
+
+  page_id_t GetPageId() const { return page_id_; }
+
+  uint32_t GetGlobalDepth() const { return global_depth_; }
+
+  // mask with the lowest global_depth bits set
+  uint32_t GetGlobalDepthMask() const { return (1U << global_depth_) - 1; }
+
+  // number of directory slots currently in use
+  uint32_t Size() const { return 1U << global_depth_; }
+
+  // double the directory, the new upper half mirrors the lower half
+  bool IncrGlobalDepth();
+
+  void DecrGlobalDepth();
+
+  // true if every bucket has a local depth smaller than the global depth
+  bool CanShrink() const;
+
+  page_id_t GetBucketPageId(uint32_t bucket_idx) const { return bucket_page_ids_[bucket_idx]; }
+
+  void SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id) { bucket_page_ids_[bucket_idx] = bucket_page_id; }
+
+  uint32_t GetLocalDepth(uint32_t bucket_idx) const { return local_depths_[bucket_idx]; }
+
+  void SetLocalDepth(uint32_t bucket_idx, uint8_t local_depth) { local_depths_[bucket_idx] = local_depth; }
+
+  uint32_t GetLocalDepthMask(uint32_t bucket_idx) const { return (1U << local_depths_[bucket_idx]) - 1; }
+
+  // the slot that was split from bucket_idx when its local depth was last increased
+  uint32_t GetSplitImageIndex(uint32_t bucket_idx) const;
+
+ private:
+  page_id_t page_id_;
+  uint32_t global_depth_;
+  uint8_t local_depths_[DIRECTORY_ARRAY_SIZE];
+  page_id_t bucket_page_ids_[DIRECTORY_ARRAY_SIZE];
+};
+
+#endif  // MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
@@ -0,0 +1,57 @@
+#ifndef MINISQL_LSM_MANIFEST_PAGE_H
+#define MINISQL_LSM_MANIFEST_PAGE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * Root page of an lsm index, its page id is kept in the index roots page. It
+ * lists the sorted runs of the index from the oldest to the newest.
+ *
+ * Manifest page format (size in byte):
+ *  ----------------------------------------------------------------------
+ * | RunCount (4) | RUN(1) | RUN(2) | ... | RUN(n)
+ *  ----------------------------------------------------------------------
+ *
+ *  Run format (size in byte, 16 bytes in total):
+ *  ---------------------------------------------------------------
+ * | FirstPageId (4) | PageCount (4) | EntryCount (4) | Level (4)
+ *  ---------------------------------------------------------------
+ */
+class LSMManifestPage {
+ public:
+  struct RunMeta {
+    page_id_t first_page_id;
+    uint32_t page_count;
+    uint32_t entry_count;
+    uint32_t level;
+  };
+
+  // must call initialize method after "create" a new manifest page
+  void Init() { run_count_ = 0; }
+
+  uint32_t GetRunCount() const { return run_count_; }
+
+  const RunMeta &GetRun(uint32_t index) const { return runs_[index]; }
+
+  // replace the run list, return false if it does not fit
+  bool SetRuns(const std::vector<RunMeta> &runs) {
+    if (runs.size() > MAX_RUN_COUNT) {
+      return false;
+    }
+    run_count_ = runs.size();
+    std::copy(runs.begin(), runs.end(), runs_);
+    return true;
+  }
+
+  static constexpr uint32_t MAX_RUN_COUNT = (PAGE_SIZE - sizeof(uint32_t)) / sizeof(RunMeta);
+
+ private:
+  uint32_t run_count_;
+  RunMeta runs_[0];
+};
+
+#endif  // MINISQL_LSM_MANIFEST_PAGE_H
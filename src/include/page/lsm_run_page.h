@@ -0,0 +1,60 @@
+#ifndef MINISQL_LSM_RUN_PAGE_H
+#define MINISQL_LSM_RUN_PAGE_H
+
+/**
+ * lsm_run_page.h
+ *
+ * Page of an immutable sorted run of the lsm index. A run is written once, in
+ * key order, into consecutively allocated pages chained by next page id.
+ *
+ * Run page format:
+ *  ----------------------------------------------------------------------
+ * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
+ *  ----------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 8 bytes in total):
+ *  ---------------------------------
+ * | NextPageId (4) | CurrentSize (4)
+ *  ---------------------------------
+ */
+#include <utility>
+
+#include "page/b_plus_tree_page.h"
+
+#define LSM_RUN_PAGE_TYPE LSMRunPage<KeyType, ValueType, KeyComparator>
+#define LSM_RUN_PAGE_HEADER_SIZE 8
+#define LSM_RUN_ARRAY_SIZE ((PAGE_SIZE - LSM_RUN_PAGE_HEADER_SIZE) / sizeof(MappingType))
+
+INDEX_TEMPLATE_ARGUMENTS
+class LSMRunPage {
+ public:
+  // must call initialize method after "create" a new run page
+  void Init();
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  int GetSize() const { return size_; }
+
+  bool IsFull() const { return size_ >= static_cast<int>(LSM_RUN_ARRAY_SIZE); }
+
+  const KeyType &KeyAt(int index) const { return array_[index].first; }
+
+  const MappingType &GetItem(int index) const { return array_[index]; }
+
+  // entries must be appended in ascending key order
+  void Append(const MappingType &item);
+
+  // index of the first entry with a key >= key, GetSize() if there is none
+  int KeyIndex(const KeyType &key, const KeyComparator &comparator) const;
+
+  bool Lookup(const KeyType &key, ValueType &value, const KeyComparator &comparator) const;
+
+ private:
+  page_id_t next_page_id_;
+  int size_;
+  MappingType array_[0];
+};
+
+#endif  // MINISQL_LSM_RUN_PAGE_H
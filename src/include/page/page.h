@@ -4,6 +4,7 @@
 #include <cstring>
 #include <iostream>
 #include <shared_mutex>
+#include <vector>
 
 #include "common/config.h"
 #include "common/rwlatch.h"
@@ -56,6 +57,18 @@ public:
   /** Sets the page LSN. */
   inline void SetLSN(lsn_t lsn) { memcpy(GetData() + OFFSET_LSN, &lsn, sizeof(lsn_t)); }
 
+  /**
+   * In memory reference slot of this frame, e.g. child i of an internal page or the next page of a leaf.
+   * Pass it to BufferPoolManager::FetchPage to swizzle the reference. Slots are never written to disk and
+   * are cleared when the frame is handed to another page.
+   */
+  inline Page *&SwizzleSlot(size_t slot) {
+    if (slot >= swizzled_.size()) {
+      swizzled_.resize(slot + 1, nullptr);
+    }
+    return swizzled_[slot];
+  }
+
 protected:
   static_assert(sizeof(page_id_t) == 4);
   static_assert(sizeof(lsn_t) == 4);
@@ -78,6 +91,8 @@ private:
   bool is_dirty_ = false;
   /** Page latch. */
   ReaderWriterLatch rwlatch_;
+  /** Frames of the pages this page refers to, see SwizzleSlot. */
+  std::vector<Page *> swizzled_;
 };
 
 #endif  // MINISQL_PAGE_H
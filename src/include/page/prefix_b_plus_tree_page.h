@@ -0,0 +1,139 @@
+#ifndef MINISQL_PREFIX_B_PLUS_TREE_PAGE_H
+#define MINISQL_PREFIX_B_PLUS_TREE_PAGE_H
+
+/**
+ * prefix_b_plus_tree_page.h
+ *
+ * Slotted page of the prefix compressed b+ tree, holding variable length
+ * binary comparable keys in ascending order. The bytes shared by all the keys
+ * of the page are stored once as the page prefix, every slot keeps only the
+ * rest of its key. A leaf maps each key to a row id, an internal page maps
+ * each separator to the child holding the keys from it up to the next one.
+ * The separator of slot 0 of an internal page is empty and never compared, so
+ * it is left out of the prefix.
+ *
+ * Page format (size in byte):
+ *  ----------------------------------------------------------------------------
+ * | HEADER | PREFIX | SLOT(1) | ... | SLOT(n) | free space | ENTRY(n) ... ENTRY(1)
+ *  ----------------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 12 bytes in total):
+ *  --------------------------------------------------------------------------
+ * | IsLeaf (2) | Size (2) | PrefixLength (2) | DataBegin (2) | NextPageId (4)
+ *  --------------------------------------------------------------------------
+ *
+ *  Slot format (size in byte, 4 bytes in total):
+ *  -----------------------------
+ * | Offset (2) | SuffixLength (2)
+ *  -----------------------------
+ *
+ *  An entry is the suffix of the key followed by a row id (8) in a leaf or a
+ *  child page id (4) in an internal page. Entries are packed from the end of
+ *  the page, DataBegin is the offset of the lowest one.
+ */
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/rowid.h"
+
+#define PREFIX_B_PLUS_TREE_PAGE_HEADER_SIZE 12
+#define PREFIX_B_PLUS_TREE_SLOT_SIZE 4
+
+/** Key with its row id in a leaf, or with its child page id in an internal page */
+struct PrefixBPlusTreeEntry {
+  std::string key;
+  int64_t value;
+};
+
+class PrefixBPlusTreePage {
+ public:
+  // must call initialize method after "create" a new page
+  void Init(bool is_leaf);
+
+  bool IsLeafPage() const { return is_leaf_ != 0; }
+
+  int GetSize() const { return size_; }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  uint32_t GetPrefixLength() const { return prefix_length_; }
+
+  // bytes of the page in use
+  uint32_t GetUsedSize() const {
+    return PREFIX_B_PLUS_TREE_PAGE_HEADER_SIZE + prefix_length_ + size_ * PREFIX_B_PLUS_TREE_SLOT_SIZE +
+           (PAGE_SIZE - data_begin_);
+  }
+
+  // the whole key of slot index, prefix included
+  std::string KeyAt(int index) const;
+
+  RowId RowIdAt(int index) const;
+
+  page_id_t ChildAt(int index) const;
+
+  /**
+   * Index of the first key >= key in a leaf, GetSize() if there is none. The
+   * page prefix is compared once, the binary search compares only suffixes.
+   */
+  int LowerBound(const std::string &key) const;
+
+  // index of the child of an internal page that holds key
+  int ChildIndex(const std::string &key) const;
+
+  // compare the key of slot index with key, like memcmp over the shorter length and then by length
+  int CompareAt(int index, const std::string &key) const;
+
+  void ReadEntries(std::vector<PrefixBPlusTreeEntry> &entries) const;
+
+  /**
+   * Rewrite the page with the given entries in ascending key order, keeping its
+   * kind and next page id. Returns false, leaving the page unchanged, if they do
+   * not fit.
+   */
+  bool WriteEntries(const std::vector<PrefixBPlusTreeEntry> &entries);
+
+  /**
+   * Bytes a page holding entries[begin, end) takes, with the prefix of those
+   * entries factored out.
+   */
+  static uint32_t GetPageSize(const std::vector<PrefixBPlusTreeEntry> &entries, int begin, int end, bool is_leaf);
+
+  static uint32_t CommonPrefixLength(const std::string &a, const std::string &b);
+
+ private:
+  const char *Prefix() const { return data_; }
+
+  // field 0 or 1 of slot index, the slots follow the prefix and may be unaligned
+  uint16_t SlotField(int index, int field) const {
+    uint16_t value;
+    memcpy(&value, data_ + prefix_length_ + index * PREFIX_B_PLUS_TREE_SLOT_SIZE + field * sizeof(uint16_t),
+           sizeof(value));
+    return value;
+  }
+
+  const char *SuffixAt(int index) const { return reinterpret_cast<const char *>(this) + SlotField(index, 0); }
+
+  uint32_t SuffixLengthAt(int index) const { return SlotField(index, 1); }
+
+  const char *ValueAt(int index) const { return SuffixAt(index) + SuffixLengthAt(index); }
+
+  /**
+   * First index in [first, size) whose key is > key if upper, >= key otherwise.
+   * The keys of those slots all start with the page prefix.
+   */
+  int Search(const std::string &key, int first, bool upper) const;
+
+  uint16_t is_leaf_;
+  uint16_t size_;
+  uint16_t prefix_length_;
+  uint16_t data_begin_;
+  page_id_t next_page_id_;
+  char data_[0];
+};
+
+#endif  // MINISQL_PREFIX_B_PLUS_TREE_PAGE_H
@@ -61,6 +61,20 @@ public:
 
   bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
 
+  /**
+   * Call func(slot_num, data) for every live tuple, data points to the serialized row in the page.
+   * Lets scans decode tuples in place instead of going through a Row per tuple.
+   */
+  template <typename Func>
+  void ForEachTuple(Func &&func) {
+    uint32_t tuple_count = GetTupleCount();
+    for (uint32_t i = 0; i < tuple_count; i++) {
+      if (!IsDeleted(GetTupleSize(i))) {
+        func(i, GetData() + GetTupleOffsetAtSlot(i));
+      }
+    }
+  }
+
 private:
   uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
@@ -17,6 +17,7 @@
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
 %token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
 %token <syntax_node> IDENTIFIER STRING NUMBER EQ NE LE GE
+%token <syntax_node> ANALYZE JOIN GROUP BY
 
 %type <syntax_node> start sql
 %type <syntax_node> sql_create_database sql_drop_database sql_show_databases sql_use_database
@@ -25,9 +26,10 @@
 %type <syntax_node> sql_create_index sql_drop_index sql_show_indexes
 %type <syntax_node> sql_trx_begin sql_trx_commit sql_trx_rollback
 %type <syntax_node> sql_select select_columns column_values column_value operator
+%type <syntax_node> table_refs table_list select_column_list select_column column_ref group_by group_columns
 %type <syntax_node> connector where_conditions where_condition
 %type <syntax_node> sql_insert sql_delete sql_update update_values update_value
-%type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_quit sql_exec_file sql_analyze
 
 %%
 
@@ -58,6 +60,7 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_analyze { $$ = $1; }
   ;
 
 sql_create_database:
@@ -196,18 +199,79 @@ sql_show_indexes:
   ;
 
 sql_select:
-  SELECT select_columns FROM IDENTIFIER {
+  SELECT select_columns FROM table_refs group_by {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
+    if ($5 != NULL) {
+      SyntaxNodeAddChildren($$, $5);
+    }
   }
-  | SELECT select_columns FROM IDENTIFIER WHERE where_conditions {
+  | SELECT select_columns FROM table_refs WHERE where_conditions group_by {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
     pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
     SyntaxNodeAddChildren(condition_node, $6);
     SyntaxNodeAddChildren($$, condition_node);
+    if ($7 != NULL) {
+      SyntaxNodeAddChildren($$, $7);
+    }
+  }
+  ;
+
+group_by:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | GROUP BY group_columns {
+    $$ = CreateSyntaxNode(kNodeGroupBy, NULL);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  ;
+
+group_columns:
+  column_ref ',' group_columns {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | column_ref {
+    $$ = $1;
+  }
+  ;
+
+table_refs:
+  IDENTIFIER {
+    $$ = $1;
+  }
+  | table_list {
+    $$ = CreateSyntaxNode(kNodeTableList, NULL);
+    SyntaxNodeAddChildren($$, $1);
+  }
+  ;
+
+table_list:
+  IDENTIFIER ',' IDENTIFIER {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | IDENTIFIER JOIN IDENTIFIER ON where_conditions {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+    pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
+    SyntaxNodeAddChildren(condition_node, $5);
+    SyntaxNodeAddSibling($$, condition_node);
+  }
+  | table_list ',' IDENTIFIER {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | table_list JOIN IDENTIFIER ON where_conditions {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+    pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
+    SyntaxNodeAddChildren(condition_node, $5);
+    SyntaxNodeAddSibling($$, condition_node);
   }
   ;
 
@@ -215,12 +279,48 @@ select_columns:
   '*' {
     $$ = CreateSyntaxNode(kNodeAllColumns, NULL);
   }
-  | column_list {
+  | select_column_list {
     $$ = CreateSyntaxNode(kNodeColumnList, "select columns");
     SyntaxNodeAddChildren($$, $1);
   }
   ;
 
+select_column_list:
+  select_column ',' select_column_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | select_column {
+    $$ = $1;
+  }
+  ;
+
+select_column:
+  column_ref {
+    $$ = $1;
+  }
+  | IDENTIFIER '(' '*' ')' {
+    $$ = CreateSyntaxNode(kNodeAggregate, $1->val_);
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeAllColumns, NULL));
+  }
+  | IDENTIFIER '(' column_ref ')' {
+    $$ = CreateSyntaxNode(kNodeAggregate, $1->val_);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  ;
+
+column_ref:
+  IDENTIFIER {
+    $$ = $1;
+  }
+  | IDENTIFIER '.' IDENTIFIER {
+    char *name = (char *)malloc(strlen($1->val_) + strlen($3->val_) + 2);
+    sprintf(name, "%s.%s", $1->val_, $3->val_);
+    $$ = CreateSyntaxNode(kNodeIdentifier, name);
+    free(name);
+  }
+  ;
+
 where_conditions:
   where_conditions connector where_condition  {
     $$ = $2;
@@ -242,7 +342,12 @@ connector:
   ;
 
 where_condition:
-  IDENTIFIER operator column_value {
+  column_ref operator column_value {
+    $$ = $2;
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | column_ref operator column_ref {
     $$ = $2;
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -380,6 +485,13 @@ sql_trx_rollback:
   }
   ;
 
+sql_analyze:
+  ANALYZE IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeAnalyze, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  ;
+
 sql_quit:
   QUIT {
     $$ = CreateSyntaxNode(kNodeQuit, NULL);
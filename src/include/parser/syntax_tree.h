@@ -43,7 +43,11 @@ typedef enum {
   kNodeIndexType, /** type of index */
   kNodeTrxBegin, /** begin transaction command */
   kNodeTrxCommit, /** commit transaction command */
-  kNodeTrxRollback /** rollback transaction command */
+  kNodeTrxRollback, /** rollback transaction command */
+  kNodeAnalyze, /** analyze table command */
+  kNodeTableList, /** tables of a select joining several tables, with the conditions of their joins */
+  kNodeAggregate, /** aggregate function of a select column, named by val_ */
+  kNodeGroupBy    /** group by columns of a select */
 } SyntaxNodeType;
 
 /**
@@ -86,20 +86,11 @@ class Field {
   inline void SetIsNull(bool is_null) { is_null_ = is_null; };
   inline uint32_t GetLength() const { return Type::GetInstance(type_id_)->GetLength(*this); }
 
-  inline const char *GetData() const {
-    auto temp = Type::GetInstance(type_id_);
-    if (temp->GetTypeId() == kTypeFloat) {
-      return (dynamic_cast<TypeFloat *>(temp))->GetData(*this);
-    } else if (temp->GetTypeId() == kTypeChar) {
-      if (this->is_null_) {
-        return nullptr;
-      } else {
-        return (dynamic_cast<TypeChar *>(temp))->GetData(*this);
-      }
-    }
-    return nullptr;
-  }
-  inline float GetFloatData() { return value_.float_; }
+  inline const char *GetData() const { return type_id_ == kTypeChar && !is_null_ ? value_.chars_ : nullptr; }
+  inline float GetFloatData() const { return value_.float_; }
+  // direct accessors for comparison loops, the caller knows the type and that the field is not null
+  inline int32_t GetIntData() const { return value_.integer_; }
+  inline uint32_t GetCharLength() const { return len_; }
   inline uint32_t SerializeTo(char *buf) const { return Type::GetInstance(type_id_)->SerializeTo(*this, buf); }
 
   inline static uint32_t DeserializeFrom(char *buf, const TypeId type_id, Field **field, bool is_null, MemHeap *heap) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 #include "common/config.h"
 #include "common/macros.h"
 #include "page/bitmap_page.h"
@@ -26,6 +27,7 @@ class DiskManager {
   explicit DiskManager(const std::string &db_file);
   ~DiskManager() {
     if (!closed) {
+      WritePhysicalPage(META_PAGE_ID, meta_data_);
       for (auto it : bitmap_cache_) {
         WritePhysicalPage(it.first, reinterpret_cast<char *>(it.second));
         delete it.second;
@@ -57,6 +59,11 @@ class DiskManager {
    */
   void DeAllocatePage(page_id_t logical_page_id);
 
+  /**
+   * Free a batch of pages, updating each extent's bitmap and usage count once
+   */
+  void DeAllocatePages(std::vector<page_id_t> logical_page_ids);
+
   /**
    * Return whether specific logical_page_id is free
    */
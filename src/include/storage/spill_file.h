@@ -0,0 +1,49 @@
+#ifndef MINISQL_SPILL_FILE_H
+#define MINISQL_SPILL_FILE_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "record/row.h"
+
+/**
+ * Temporary storage of an operator whose state outgrows its memory budget.
+ * Bytes are appended to pages taken from the buffer pool, then read back in
+ * the order they were written. The pages are deleted with the file.
+ */
+class SpillFile {
+ public:
+  explicit SpillFile(BufferPoolManager *buffer_pool_manager) : buffer_pool_manager_(buffer_pool_manager) {}
+
+  ~SpillFile();
+
+  /**
+   * @return false if no page could be allocated
+   */
+  bool Append(const char *data, uint32_t size);
+
+  /**
+   * Append the fields of a row, which are read back by ReadRow.
+   */
+  bool AppendRow(const Row &row);
+
+  // read from the beginning again
+  inline void Rewind() { read_pos_ = 0; }
+
+  /**
+   * @return false once less than size bytes are left
+   */
+  bool Read(char *data, uint32_t size);
+
+  bool ReadRow(std::vector<Field> &fields);
+
+  inline uint64_t GetSize() const { return size_; }
+
+ private:
+  BufferPoolManager *buffer_pool_manager_;
+  std::vector<page_id_t> pages_;
+  uint64_t size_{0};
+  uint64_t read_pos_{0};
+};
+
+#endif  // MINISQL_SPILL_FILE_H
@@ -87,11 +87,44 @@ class TableHeap {
    */
   TableIterator End();
 
+  /**
+   * Call func(rid, data) for every live tuple of a page of this table while the page is pinned,
+   * data points to the serialized row.
+   * @return the id of the next page, INVALID_PAGE_ID after the last one
+   */
+  template <typename Func>
+  page_id_t ScanPage(page_id_t page_id, Func &&func) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    ASSERT(page != nullptr, "Can not fetch table page.");
+    page->ForEachTuple([&](uint32_t slot_num, const char *data) { func(RowId(page_id, slot_num), data); });
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    return next_page_id;
+  }
+
   /**
    * @return the id of the first page of this table
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * Tuple and page counts kept up to date by inserts and deletes, read by the planner. They
+   * are exact for a heap created by this process, for a loaded heap they stay unknown until
+   * SetCounts is called.
+   * @return false if the counts are unknown
+   */
+  inline bool GetCounts(uint64_t &tuple_count, uint32_t &page_count) const {
+    tuple_count = tuple_count_;
+    page_count = page_count_;
+    return counts_known_;
+  }
+
+  inline void SetCounts(uint64_t tuple_count, uint32_t page_count) {
+    tuple_count_ = tuple_count;
+    page_count_ = page_count;
+    counts_known_ = true;
+  }
+
  private:
   /**
    * create table heap and initialize first page
@@ -110,6 +143,7 @@ class TableHeap {
     first_page->Init(first_page_id_, PAGE_SIZE, log_manager, txn);
     buffer_pool_manager->UnpinPage(first_page_id_, true);
     schema_ = schema;
+    counts_known_ = true;
   };
 
   /**
@@ -128,6 +162,9 @@ class TableHeap {
   page_id_t first_page_id_;
   page_id_t last_page_id;
   uint32_t total_page{0};
+  uint64_t tuple_count_{0};
+  uint32_t page_count_{1};
+  bool counts_known_{false};
   Schema *schema_;
   [[maybe_unused]] LogManager *log_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
@@ -2,6 +2,7 @@
 #define MINISQL_TABLE_ITERATOR_H
 
 #include "common/rowid.h"
+#include "page/page.h"
 #include "record/row.h"
 #include "transaction/transaction.h"
 
@@ -19,7 +20,7 @@ class TableIterator {
   explicit TableIterator(const TableIterator &other);
 
   explicit TableIterator(const TableIterator &&other)
-      : row_(other.row_), owner_heap_(other.owner_heap_), rid{other.rid} {}
+      : row_(other.row_), owner_heap_(other.owner_heap_), rid{other.rid}, frame_(other.frame_) {}
   virtual ~TableIterator();
   inline bool operator==(const TableIterator &itr) const { return rid == itr.rid; }
 
@@ -29,6 +30,7 @@ class TableIterator {
     row_ = itr.row_;
     owner_heap_ = itr.owner_heap_;
     rid = itr.rid;
+    frame_ = itr.frame_;
     return *this;
   }
 
@@ -45,6 +47,8 @@ class TableIterator {
   Row *row_{nullptr};
   TableHeap *owner_heap_{nullptr};
   RowId rid{INVALID_PAGE_ID, 0};
+  // swizzled reference to the frame of the current page
+  Page *frame_{nullptr};
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
@@ -1,9 +1,11 @@
 #ifndef MINISQL_MEM_HEAP_H
 #define MINISQL_MEM_HEAP_H
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <unordered_set>
+#include <vector>
 #include "common/macros.h"
 
 class MemHeap {
@@ -54,4 +56,60 @@ private:
   std::unordered_set<void *> allocated_;
 };
 
+/**
+ * Bump allocator handing out memory from blocks of block_size bytes, or a block
+ * of their own for larger sizes. Free does nothing, everything is released at
+ * once by Clear or with the heap.
+ */
+class ArenaMemHeap : public MemHeap {
+public:
+  explicit ArenaMemHeap(size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+  ~ArenaMemHeap() { Clear(); }
+
+  void *Allocate(size_t size) {
+    size = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    if (size > block_size_) {
+      return NewBlock(size);
+    }
+    if (current_ == nullptr || used_ + size > block_size_) {
+      current_ = static_cast<char *>(NewBlock(block_size_));
+      used_ = 0;
+    }
+    void *buf = current_ + used_;
+    used_ += size;
+    return buf;
+  }
+
+  void Free(void *ptr) {}
+
+  void Clear() {
+    for (auto it: blocks_) {
+      free(it);
+    }
+    blocks_.clear();
+    current_ = nullptr;
+    used_ = 0;
+    allocated_size_ = 0;
+  }
+
+  // bytes taken by the blocks
+  inline size_t GetAllocatedSize() const { return allocated_size_; }
+
+private:
+  void *NewBlock(size_t size) {
+    void *buf = malloc(size);
+    ASSERT(buf != nullptr, "Out of memory exception");
+    blocks_.push_back(buf);
+    allocated_size_ += size;
+    return buf;
+  }
+
+  size_t block_size_;
+  std::vector<void *> blocks_;
+  char *current_{nullptr};
+  size_t used_{0};
+  size_t allocated_size_{0};
+};
+
 #endif //MINISQL_MEM_HEAP_H
@@ -0,0 +1,540 @@
+#include "index/adaptive_radix_tree.h"
+#include <algorithm>
+
+/*****************************************************************************
+ * NODE HELPERS
+ *****************************************************************************/
+AdaptiveRadixTree::Node **AdaptiveRadixTree::FindChild(Node *node, uint8_t byte) {
+  switch (node->type) {
+    case kNode4: {
+      auto *n = static_cast<Node4 *>(node);
+      for (int i = 0; i < n->child_count; i++) {
+        if (n->keys[i] == byte) return &n->children[i];
+      }
+      return nullptr;
+    }
+    case kNode16: {
+      auto *n = static_cast<Node16 *>(node);
+      auto *end = n->keys + n->child_count;
+      auto *it = std::lower_bound(n->keys, end, byte);
+      return it != end && *it == byte ? &n->children[it - n->keys] : nullptr;
+    }
+    case kNode48: {
+      auto *n = static_cast<Node48 *>(node);
+      return n->child_index[byte] != 0 ? &n->children[n->child_index[byte] - 1] : nullptr;
+    }
+    case kNode256: {
+      auto *n = static_cast<Node256 *>(node);
+      return n->children[byte] != nullptr ? &n->children[byte] : nullptr;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+bool AdaptiveRadixTree::IsFull(const Node *node) {
+  switch (node->type) {
+    case kNode4:
+      return node->child_count == 4;
+    case kNode16:
+      return node->child_count == 16;
+    case kNode48:
+      return node->child_count == 48;
+    default:
+      return false;
+  }
+}
+
+void AdaptiveRadixTree::AddChild(Node *node, uint8_t byte, Node *child) {
+  switch (node->type) {
+    case kNode4:
+    case kNode16: {
+      // Node4 and Node16 share the layout of their sorted arrays
+      uint8_t *keys = node->type == kNode4 ? static_cast<Node4 *>(node)->keys : static_cast<Node16 *>(node)->keys;
+      Node **children =
+          node->type == kNode4 ? static_cast<Node4 *>(node)->children : static_cast<Node16 *>(node)->children;
+      int pos = std::lower_bound(keys, keys + node->child_count, byte) - keys;
+      std::copy_backward(keys + pos, keys + node->child_count, keys + node->child_count + 1);
+      std::copy_backward(children + pos, children + node->child_count, children + node->child_count + 1);
+      keys[pos] = byte;
+      children[pos] = child;
+      break;
+    }
+    case kNode48: {
+      auto *n = static_cast<Node48 *>(node);
+      int slot = 0;
+      while (n->children[slot] != nullptr) {
+        slot++;
+      }
+      n->children[slot] = child;
+      n->child_index[byte] = slot + 1;
+      break;
+    }
+    case kNode256:
+      static_cast<Node256 *>(node)->children[byte] = child;
+      break;
+    default:
+      return;
+  }
+  node->child_count++;
+}
+
+void AdaptiveRadixTree::RemoveChild(Node *node, uint8_t byte) {
+  switch (node->type) {
+    case kNode4:
+    case kNode16: {
+      uint8_t *keys = node->type == kNode4 ? static_cast<Node4 *>(node)->keys : static_cast<Node16 *>(node)->keys;
+      Node **children =
+          node->type == kNode4 ? static_cast<Node4 *>(node)->children : static_cast<Node16 *>(node)->children;
+      int pos = std::find(keys, keys + node->child_count, byte) - keys;
+      std::copy(keys + pos + 1, keys + node->child_count, keys + pos);
+      std::copy(children + pos + 1, children + node->child_count, children + pos);
+      break;
+    }
+    case kNode48: {
+      auto *n = static_cast<Node48 *>(node);
+      n->children[n->child_index[byte] - 1] = nullptr;
+      n->child_index[byte] = 0;
+      break;
+    }
+    case kNode256:
+      static_cast<Node256 *>(node)->children[byte] = nullptr;
+      break;
+    default:
+      return;
+  }
+  node->child_count--;
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Grow(Node *node) {
+  Node *grown = nullptr;
+  switch (node->type) {
+    case kNode4: {
+      auto *n = static_cast<Node4 *>(node);
+      auto *g = new Node16();
+      std::copy(n->keys, n->keys + n->child_count, g->keys);
+      std::copy(n->children, n->children + n->child_count, g->children);
+      grown = g;
+      break;
+    }
+    case kNode16: {
+      auto *n = static_cast<Node16 *>(node);
+      auto *g = new Node48();
+      for (int i = 0; i < n->child_count; i++) {
+        g->children[i] = n->children[i];
+        g->child_index[n->keys[i]] = i + 1;
+      }
+      grown = g;
+      break;
+    }
+    case kNode48: {
+      auto *n = static_cast<Node48 *>(node);
+      auto *g = new Node256();
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->child_index[byte] != 0) {
+          g->children[byte] = n->children[n->child_index[byte] - 1];
+        }
+      }
+      grown = g;
+      break;
+    }
+    default:
+      return node;
+  }
+  grown->child_count = node->child_count;
+  grown->prefix = std::move(node->prefix);
+  DeleteNode(node);
+  return grown;
+}
+
+/*
+ * A node shrinks only well below the capacity of the smaller kind, so that a
+ * key inserted and removed at the boundary does not resize it every time.
+ */
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Shrink(Node *node) {
+  Node *shrunk = nullptr;
+  switch (node->type) {
+    case kNode4: {
+      if (node->child_count != 1) {
+        return node;
+      }
+      // a single child takes over the path of the node
+      auto *n = static_cast<Node4 *>(node);
+      Node *child = n->children[0];
+      if (child->type != kLeaf) {
+        child->prefix = n->prefix + static_cast<char>(n->keys[0]) + child->prefix;
+      }
+      DeleteNode(node);
+      return child;
+    }
+    case kNode16: {
+      if (node->child_count > 3) {
+        return node;
+      }
+      auto *n = static_cast<Node16 *>(node);
+      auto *s = new Node4();
+      std::copy(n->keys, n->keys + n->child_count, s->keys);
+      std::copy(n->children, n->children + n->child_count, s->children);
+      shrunk = s;
+      break;
+    }
+    case kNode48: {
+      if (node->child_count > 12) {
+        return node;
+      }
+      auto *n = static_cast<Node48 *>(node);
+      auto *s = new Node16();
+      int count = 0;
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->child_index[byte] != 0) {
+          s->keys[count] = byte;
+          s->children[count++] = n->children[n->child_index[byte] - 1];
+        }
+      }
+      shrunk = s;
+      break;
+    }
+    case kNode256: {
+      if (node->child_count > 37) {
+        return node;
+      }
+      auto *n = static_cast<Node256 *>(node);
+      auto *s = new Node48();
+      int count = 0;
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->children[byte] != nullptr) {
+          s->children[count] = n->children[byte];
+          s->child_index[byte] = ++count;
+        }
+      }
+      shrunk = s;
+      break;
+    }
+    default:
+      return node;
+  }
+  shrunk->child_count = node->child_count;
+  shrunk->prefix = std::move(node->prefix);
+  DeleteNode(node);
+  return shrunk;
+}
+
+template <typename Func>
+bool AdaptiveRadixTree::ForEachChild(const Node *node, Func &&func) {
+  switch (node->type) {
+    case kNode4: {
+      auto *n = static_cast<const Node4 *>(node);
+      for (int i = 0; i < n->child_count; i++) {
+        if (!func(n->keys[i], n->children[i])) return false;
+      }
+      return true;
+    }
+    case kNode16: {
+      auto *n = static_cast<const Node16 *>(node);
+      for (int i = 0; i < n->child_count; i++) {
+        if (!func(n->keys[i], n->children[i])) return false;
+      }
+      return true;
+    }
+    case kNode48: {
+      auto *n = static_cast<const Node48 *>(node);
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->child_index[byte] != 0 && !func(static_cast<uint8_t>(byte), n->children[n->child_index[byte] - 1])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case kNode256: {
+      auto *n = static_cast<const Node256 *>(node);
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->children[byte] != nullptr && !func(static_cast<uint8_t>(byte), n->children[byte])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return true;
+  }
+}
+
+void AdaptiveRadixTree::DeleteNode(Node *node) {
+  switch (node->type) {
+    case kLeaf:
+      delete static_cast<Leaf *>(node);
+      break;
+    case kNode4:
+      delete static_cast<Node4 *>(node);
+      break;
+    case kNode16:
+      delete static_cast<Node16 *>(node);
+      break;
+    case kNode48:
+      delete static_cast<Node48 *>(node);
+      break;
+    case kNode256:
+      delete static_cast<Node256 *>(node);
+      break;
+  }
+}
+
+void AdaptiveRadixTree::FreeNode(Node *node) {
+  if (node == nullptr) {
+    return;
+  }
+  ForEachChild(node, [](uint8_t, const Node *child) {
+    FreeNode(const_cast<Node *>(child));
+    return true;
+  });
+  DeleteNode(node);
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+bool AdaptiveRadixTree::Lookup(const std::string &key, RowId &value) const {
+  Node *node = root_;
+  size_t depth = 0;
+  while (node != nullptr) {
+    if (node->type == kLeaf) {
+      auto *leaf = static_cast<Leaf *>(node);
+      if (leaf->key != key) {
+        return false;
+      }
+      value = leaf->value;
+      return true;
+    }
+    if (key.compare(depth, node->prefix.size(), node->prefix) != 0) {
+      return false;
+    }
+    depth += node->prefix.size();
+    if (depth >= key.size()) {
+      return false;
+    }
+    Node **child = FindChild(node, static_cast<uint8_t>(key[depth++]));
+    node = child == nullptr ? nullptr : *child;
+  }
+  return false;
+}
+
+void AdaptiveRadixTree::CollectAll(const Node *node, std::vector<RowId> &result) {
+  if (node->type == kLeaf) {
+    result.push_back(static_cast<const Leaf *>(node)->value);
+    return;
+  }
+  ForEachChild(node, [&](uint8_t, const Node *child) {
+    CollectAll(child, result);
+    return true;
+  });
+}
+
+void AdaptiveRadixTree::Range(const std::string *low, const std::string *high, std::vector<RowId> &result) const {
+  if (root_ == nullptr) {
+    return;
+  }
+  std::string path;
+  RangeAt(root_, path, low, high, result);
+}
+
+/*
+ * Every key below an inner node starts with path, so a subtree is skipped as a
+ * whole once path sorts before the same number of bytes of low, and the walk
+ * stops once it sorts after those of high.
+ */
+bool AdaptiveRadixTree::RangeAt(const Node *node, std::string &path, const std::string *low,
+                                const std::string *high, std::vector<RowId> &result) const {
+  if (node->type == kLeaf) {
+    auto *leaf = static_cast<const Leaf *>(node);
+    if (low != nullptr && leaf->key < *low) {
+      return true;
+    }
+    if (high != nullptr && leaf->key > *high) {
+      return false;
+    }
+    result.push_back(leaf->value);
+    return true;
+  }
+  size_t path_size = path.size();
+  path += node->prefix;
+  bool more = true;
+  if (low != nullptr && path.compare(0, path.size(), *low, 0, path.size()) < 0) {
+    more = true;
+  } else if (high != nullptr && path.compare(0, path.size(), *high, 0, path.size()) > 0) {
+    more = false;
+  } else {
+    more = ForEachChild(node, [&](uint8_t byte, const Node *child) {
+      path.push_back(static_cast<char>(byte));
+      bool next = RangeAt(child, path, low, high, result);
+      path.pop_back();
+      return next;
+    });
+  }
+  path.resize(path_size);
+  return more;
+}
+
+void AdaptiveRadixTree::PrefixScan(const std::string &prefix, std::vector<RowId> &result) const {
+  Node *node = root_;
+  size_t depth = 0;
+  while (node != nullptr) {
+    if (node->type == kLeaf) {
+      if (static_cast<Leaf *>(node)->key.compare(0, prefix.size(), prefix) == 0) {
+        result.push_back(static_cast<Leaf *>(node)->value);
+      }
+      return;
+    }
+    size_t n = std::min(node->prefix.size(), prefix.size() - depth);
+    if (node->prefix.compare(0, n, prefix, depth, n) != 0) {
+      return;
+    }
+    depth += node->prefix.size();
+    if (depth >= prefix.size()) {
+      // the whole subtree matches
+      CollectAll(node, result);
+      return;
+    }
+    Node **child = FindChild(node, static_cast<uint8_t>(prefix[depth++]));
+    node = child == nullptr ? nullptr : *child;
+  }
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+bool AdaptiveRadixTree::Insert(const std::string &key, RowId value) { return InsertAt(root_, key, 0, value); }
+
+bool AdaptiveRadixTree::InsertAt(Node *&node, const std::string &key, size_t depth, RowId value) {
+  if (node == nullptr) {
+    node = new Leaf(key, value);
+    size_++;
+    return true;
+  }
+  if (node->type == kLeaf) {
+    auto *leaf = static_cast<Leaf *>(node);
+    if (leaf->key == key) {
+      return false;
+    }
+    // split the leaf into a node over the common part of both keys
+    size_t end = depth;
+    while (end < key.size() && end < leaf->key.size() && key[end] == leaf->key[end]) {
+      end++;
+    }
+    if (end == key.size() || end == leaf->key.size()) {
+      return false;
+    }
+    auto *inner = new Node4();
+    inner->prefix = key.substr(depth, end - depth);
+    AddChild(inner, static_cast<uint8_t>(leaf->key[end]), leaf);
+    AddChild(inner, static_cast<uint8_t>(key[end]), new Leaf(key, value));
+    node = inner;
+    size_++;
+    return true;
+  }
+  size_t mismatch = 0;
+  while (mismatch < node->prefix.size() && depth + mismatch < key.size() &&
+         node->prefix[mismatch] == key[depth + mismatch]) {
+    mismatch++;
+  }
+  if (mismatch < node->prefix.size()) {
+    if (depth + mismatch == key.size()) {
+      return false;
+    }
+    // the key leaves the compressed path, split the path at the first differing byte
+    auto *inner = new Node4();
+    inner->prefix = node->prefix.substr(0, mismatch);
+    auto old_byte = static_cast<uint8_t>(node->prefix[mismatch]);
+    node->prefix.erase(0, mismatch + 1);
+    AddChild(inner, old_byte, node);
+    AddChild(inner, static_cast<uint8_t>(key[depth + mismatch]), new Leaf(key, value));
+    node = inner;
+    size_++;
+    return true;
+  }
+  depth += node->prefix.size();
+  if (depth >= key.size()) {
+    return false;
+  }
+  auto byte = static_cast<uint8_t>(key[depth]);
+  Node **child = FindChild(node, byte);
+  if (child != nullptr) {
+    return InsertAt(*child, key, depth + 1, value);
+  }
+  if (IsFull(node)) {
+    node = Grow(node);
+  }
+  AddChild(node, byte, new Leaf(key, value));
+  size_++;
+  return true;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+bool AdaptiveRadixTree::Remove(const std::string &key) { return RemoveAt(root_, key, 0); }
+
+bool AdaptiveRadixTree::RemoveAt(Node *&node, const std::string &key, size_t depth) {
+  if (node == nullptr) {
+    return false;
+  }
+  if (node->type == kLeaf) {
+    if (static_cast<Leaf *>(node)->key != key) {
+      return false;
+    }
+    DeleteNode(node);
+    node = nullptr;
+    size_--;
+    return true;
+  }
+  if (key.compare(depth, node->prefix.size(), node->prefix) != 0) {
+    return false;
+  }
+  depth += node->prefix.size();
+  if (depth >= key.size()) {
+    return false;
+  }
+  auto byte = static_cast<uint8_t>(key[depth]);
+  Node **child = FindChild(node, byte);
+  if (child == nullptr) {
+    return false;
+  }
+  if ((*child)->type != kLeaf) {
+    return RemoveAt(*child, key, depth + 1);
+  }
+  if (static_cast<Leaf *>(*child)->key != key) {
+    return false;
+  }
+  DeleteNode(*child);
+  RemoveChild(node, byte);
+  node = Shrink(node);
+  size_--;
+  return true;
+}
+
+void AdaptiveRadixTree::Clear() {
+  FreeNode(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+/*****************************************************************************
+ * UTILITIES AND DEBUG
+ *****************************************************************************/
+std::vector<size_t> AdaptiveRadixTree::GetNodeCounts() const {
+  std::vector<size_t> counts(4, 0);
+  if (root_ != nullptr) {
+    CountNodes(root_, counts);
+  }
+  return counts;
+}
+
+void AdaptiveRadixTree::CountNodes(const Node *node, std::vector<size_t> &counts) const {
+  if (node->type == kLeaf) {
+    return;
+  }
+  counts[node->type - kNode4]++;
+  ForEachChild(node, [&](uint8_t, const Node *child) {
+    CountNodes(child, counts);
+    return true;
+  });
+}
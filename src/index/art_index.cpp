@@ -0,0 +1,108 @@
+#include "index/art_index.h"
+#include <cstring>
+
+ARTIndex::ARTIndex(index_id_t index_id, IndexSchema *key_schema) : Index(index_id, key_schema) {}
+
+static void AppendBigEndian(std::string &buf, uint32_t bits) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    buf.push_back(static_cast<char>((bits >> shift) & 0xFF));
+  }
+}
+
+std::string ARTIndex::EncodeKey(const Row &key, uint32_t field_count) {
+  std::string buf;
+  for (uint32_t i = 0; i < field_count; i++) {
+    const Field *field = key.GetField(i);
+    if (field->IsNull()) {
+      buf.push_back('\x00');
+      continue;
+    }
+    buf.push_back('\x01');
+    switch (field->GetType()) {
+      case TypeId::kTypeInt:
+      case TypeId::kTypeFloat: {
+        uint32_t bits;
+        char raw[sizeof(uint32_t)];
+        field->SerializeTo(raw);
+        memcpy(&bits, raw, sizeof(uint32_t));
+        if (field->GetType() == TypeId::kTypeInt) {
+          bits ^= 0x80000000u;
+        } else {
+          // -0.0与0.0相等，编码相同
+          if (bits == 0x80000000u) {
+            bits = 0;
+          }
+          bits = (bits & 0x80000000u) ? ~bits : bits ^ 0x80000000u;
+        }
+        AppendBigEndian(buf, bits);
+        break;
+      }
+      case TypeId::kTypeChar: {
+        const char *data = field->GetData();
+        for (uint32_t j = 0; j < field->GetLength(); j++) {
+          buf.push_back(data[j]);
+          if (data[j] == '\x00') {
+            buf.push_back('\xFF');
+          }
+        }
+        buf.push_back('\x00');
+        buf.push_back('\x00');
+        break;
+      }
+      default:
+        ASSERT(false, "Unsupported key type.");
+    }
+  }
+  return buf;
+}
+
+dberr_t ARTIndex::InsertEntry(const Row &key, RowId row_id, Transaction *txn) {
+  ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  return container_.Insert(EncodeKey(key, key_schema_->GetColumnCount()), row_id) ? DB_SUCCESS : DB_FAILED;
+}
+
+dberr_t ARTIndex::InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) {
+  ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  return container_.Insert(EncodeKey(key, key_schema_->GetColumnCount()), row_id) ? DB_SUCCESS : DB_KEY_ALREADY_EXIST;
+}
+
+dberr_t ARTIndex::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
+  return container_.Remove(EncodeKey(key, key_schema_->GetColumnCount())) ? DB_SUCCESS : DB_KEY_NOT_FOUND;
+}
+
+dberr_t ARTIndex::ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) {
+  RowId row_id;
+  if (container_.Lookup(EncodeKey(key, key_schema_->GetColumnCount()), row_id)) {
+    result.push_back(row_id);
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t ARTIndex::ScanRange(const Row *low, const Row *high, std::vector<RowId> &result, Transaction *txn) {
+  std::string low_key, high_key;
+  if (low != nullptr) {
+    low_key = EncodeKey(*low, key_schema_->GetColumnCount());
+  }
+  if (high != nullptr) {
+    high_key = EncodeKey(*high, key_schema_->GetColumnCount());
+  }
+  container_.Range(low == nullptr ? nullptr : &low_key, high == nullptr ? nullptr : &high_key, result);
+  return DB_SUCCESS;
+}
+
+/*
+ * The encoding of a field never is a prefix of the encoding of another one,
+ * so the encoded leading fields select exactly the keys that start with them.
+ */
+dberr_t ARTIndex::ScanPrefix(const Row &prefix, std::vector<RowId> &result, Transaction *txn) {
+  if (prefix.GetFieldCount() > key_schema_->GetColumnCount()) {
+    return DB_FAILED;
+  }
+  container_.PrefixScan(EncodeKey(prefix, prefix.GetFieldCount()), result);
+  return DB_SUCCESS;
+}
+
+dberr_t ARTIndex::Destroy() {
+  container_.Clear();
+  return DB_SUCCESS;
+}
@@ -1,4 +1,5 @@
 #include "index/b_plus_tree.h"
+#include <algorithm>
 #include <string>
 #include "glog/logging.h"
 #include "index/basic_comparator.h"
@@ -22,18 +23,81 @@ BPLUSTREE_TYPE::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_ma
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Destroy() {
+  ReleaseNodeCache();
+  change_buffer_.clear();
+  buffered_count_ = 0;
   if (IsEmpty()) return;
-  Page *page = FindLeafPage(KeyType{}, true);
-  LeafPage *leaf = reinterpret_cast<LeafPage *>(page->GetData());
-  while (leaf->GetNextPageId() != INVALID_PAGE_ID) {
-    page_id_t next_id = leaf->GetNextPageId();
-    Page *next = buffer_pool_manager_->FetchPage(next_id);
-    Remove(leaf->KeyAt(0));
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
-    leaf = reinterpret_cast<LeafPage *>(next);
+  // collect the pages level by level, all leaves are on the last level so they are never read
+  std::vector<page_id_t> pages;
+  std::vector<page_id_t> level{root_page_id_};
+  while (!level.empty()) {
+    pages.insert(pages.end(), level.begin(), level.end());
+    Page *page = buffer_pool_manager_->FetchPage(level[0]);
+    bool is_leaf = reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage();
+    buffer_pool_manager_->UnpinPage(level[0], false);
+    if (is_leaf) {
+      break;
+    }
+    std::vector<page_id_t> next_level;
+    for (auto page_id : level) {
+      auto *internal = reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+      for (int i = 0; i < internal->GetSize(); i++) {
+        next_level.push_back(internal->ValueAt(i));
+      }
+      buffer_pool_manager_->UnpinPage(page_id, false);
+    }
+    level.swap(next_level);
+  }
+  buffer_pool_manager_->DeletePages(pages);
+  root_page_id_ = INVALID_PAGE_ID;
+  rightmost_leaf_id_ = INVALID_PAGE_ID;
+  height_ = 0;
+  // drop the record so that a reused index id starts from an empty tree
+  Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  reinterpret_cast<IndexRootsPage *>(root_page->GetData())->Delete(index_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
+
+/*
+ * Same level order walk as Destroy, but the leaves are read as well to count
+ * their entries.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+BPlusTreeStatistics BPLUSTREE_TYPE::GetStatistics() {
+  BPlusTreeStatistics stats;
+  MergeChangeBuffer();
+  if (IsEmpty()) return stats;
+  size_t internal_entries = 0;
+  size_t internal_capacity = 0;
+  size_t leaf_capacity = 0;
+  std::vector<page_id_t> level{root_page_id_};
+  while (!level.empty()) {
+    stats.height++;
+    std::vector<page_id_t> next_level;
+    for (auto page_id : level) {
+      auto *node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+      if (node->IsLeafPage()) {
+        stats.leaf_pages++;
+        stats.entries += node->GetSize();
+        leaf_capacity += node->GetMaxSize();
+      } else {
+        auto *internal = reinterpret_cast<InternalPage *>(node);
+        stats.internal_pages++;
+        internal_entries += internal->GetSize();
+        internal_capacity += internal->GetMaxSize();
+        for (int i = 0; i < internal->GetSize(); i++) {
+          next_level.push_back(internal->ValueAt(i));
+        }
+      }
+      buffer_pool_manager_->UnpinPage(page_id, false);
+    }
+    level.swap(next_level);
+  }
+  stats.leaf_fill_factor = static_cast<double>(stats.entries) / leaf_capacity;
+  if (internal_capacity != 0) {
+    stats.internal_fill_factor = static_cast<double>(internal_entries) / internal_capacity;
   }
-  Remove(leaf->KeyAt(0));
-  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+  return stats;
 }
 
 /*
@@ -65,11 +129,55 @@ bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> &result
   bool myresult = mypage->Lookup(key, v, comparator_);
   if (myresult) {
     result.push_back(v);
-    buffer_pool_manager_->UnpinPage(mypage->GetPageId(), false);
   }
+  buffer_pool_manager_->UnpinPage(mypage->GetPageId(), false);
   return myresult;
 }
 
+/*
+ * Batched point query over sorted keys. Probes that fall into the current
+ * leaf reuse it, a probe past its last key tries the right sibling, and only
+ * a probe beyond that sibling descends from the root again.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::GetValues(const std::vector<KeyType> &keys, std::vector<ValueType> &values,
+                               std::vector<bool> &found, Transaction *transaction) {
+  values.resize(keys.size());
+  found.assign(keys.size(), false);
+  // hops to the right sibling skip FindLeafPage, so no leaf may have pending entries
+  MergeChangeBuffer();
+  if (IsEmpty()) return;
+  LeafPage *leaf = nullptr;
+  for (size_t i = 0; i < keys.size(); i++) {
+    const KeyType &key = keys[i];
+    if (leaf != nullptr && comparator_(key, leaf->KeyAt(leaf->GetSize() - 1)) > 0) {
+      page_id_t next_id = leaf->GetNextPageId();
+      if (next_id == INVALID_PAGE_ID) {
+        // past the right most key, nothing left to find
+        continue;
+      }
+      Page *next_page = buffer_pool_manager_->FetchPage(next_id, reinterpret_cast<Page *>(leaf)->SwizzleSlot(0));
+      buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+      leaf = reinterpret_cast<LeafPage *>(next_page->GetData());
+      if (comparator_(key, leaf->KeyAt(leaf->GetSize() - 1)) > 0) {
+        buffer_pool_manager_->UnpinPage(next_id, false);
+        leaf = nullptr;
+      }
+    }
+    if (leaf == nullptr) {
+      leaf = reinterpret_cast<LeafPage *>(FindLeafPage(key, false)->GetData());
+    }
+    ValueType v;
+    if (leaf->Lookup(key, v, comparator_)) {
+      values[i] = v;
+      found[i] = true;
+    }
+  }
+  if (leaf != nullptr) {
+    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+  }
+}
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
@@ -82,12 +190,22 @@ bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> &result
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  return InsertIfAbsent(key, value, nullptr, transaction);
+}
+
+/*
+ * Same as Insert, but hand back the value already stored under key so that
+ * callers enforcing uniqueness need no separate GetValue descent.
+ * @return: true if inserted, false if key exists
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::InsertIfAbsent(const KeyType &key, const ValueType &value, ValueType *existing,
+                                    Transaction *transaction) {
   if (IsEmpty()) {
     StartNewTree(key, value);
     return true;
   }
-  bool myresult = InsertIntoLeaf(key, value, transaction);
-  return myresult;
+  return InsertIntoLeaf(key, value, existing, transaction);
 }
 /*
  * Insert constant key & value pair into an empty tree
@@ -120,20 +238,43 @@ void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
  * keys return false, otherwise return true.
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction) {
-  Page *page = FindLeafPage(key, false);
-  ValueType v;
+bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value, ValueType *existing,
+                                    Transaction *transaction) {
+  Page *page = nullptr;
+  // a key past the largest one belongs to the right most leaf, use the cached one instead of descending
+  if (rightmost_leaf_id_ != INVALID_PAGE_ID && change_buffer_.count(rightmost_leaf_id_) == 0) {
+    page = buffer_pool_manager_->FetchPage(rightmost_leaf_id_, rightmost_leaf_frame_);
+    LeafPage *hint = reinterpret_cast<LeafPage *>(page->GetData());
+    if (hint->GetNextPageId() != INVALID_PAGE_ID || hint->GetSize() == 0 ||
+        comparator_(key, hint->KeyAt(hint->GetSize() - 1)) <= 0) {
+      buffer_pool_manager_->UnpinPage(rightmost_leaf_id_, false);
+      page = nullptr;
+    }
+  }
+  if (page == nullptr) {
+    page = FindLeafPage(key, false);
+  }
   B_PLUS_TREE_LEAF_PAGE_TYPE *leafPage = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(page->GetData());
-  bool myresult = leafPage->Lookup(key, v, comparator_);
-  if (myresult == true) {
+  int index = leafPage->KeyIndex(key, comparator_);
+  if (index < leafPage->GetSize() && comparator_(leafPage->KeyAt(index), key) == 0) {
+    if (existing != nullptr) {
+      *existing = leafPage->GetItem(index).second;
+    }
     buffer_pool_manager_->UnpinPage(leafPage->GetPageId(), false);
     return false;
   } else {
+    bool right_edge = leafPage->GetNextPageId() == INVALID_PAGE_ID && index == leafPage->GetSize();
+    if (leafPage->GetNextPageId() == INVALID_PAGE_ID) {
+      rightmost_leaf_id_ = leafPage->GetPageId();
+    }
     leafPage->Insert(key, value, comparator_);
     if (leafPage->GetSize() > leafPage->GetMaxSize()) {
-      B_PLUS_TREE_LEAF_PAGE_TYPE *newleafpage = Split(leafPage);
+      B_PLUS_TREE_LEAF_PAGE_TYPE *newleafpage = Split(leafPage, right_edge);
+      if (newleafpage->GetNextPageId() == INVALID_PAGE_ID) {
+        rightmost_leaf_id_ = newleafpage->GetPageId();
+      }
       buffer_pool_manager_->UnpinPage(newleafpage->GetPageId(), true);
-      InsertIntoParent(leafPage, newleafpage->KeyAt(0), newleafpage, transaction);
+      InsertIntoParent(leafPage, newleafpage->KeyAt(0), newleafpage, transaction, right_edge);
     }
     buffer_pool_manager_->UnpinPage(leafPage->GetPageId(), true);
     return true;
@@ -145,11 +286,14 @@ bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value,
  * Using template N to represent either internal page or leaf page.
  * User needs to first ask for new page from buffer pool manager(NOTICE: throw
  * an "out of memory" exception if returned value is nullptr), then move half
- * of key & value pairs from input page to newly created page
+ * of key & value pairs from input page to newly created page.
+ * A right_edge split comes from appending past the largest key, where the
+ * left page is never written again, so it keeps RIGHT_EDGE_FILL_PERCENT of the
+ * entries and ascending inserts leave nearly full leaves behind.
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
-N *BPLUSTREE_TYPE::Split(N *node) {
+N *BPLUSTREE_TYPE::Split(N *node, bool right_edge) {
   page_id_t newpage;
   Page *page = buffer_pool_manager_->NewPage(newpage);
   if (page == nullptr) {
@@ -160,15 +304,30 @@ N *BPLUSTREE_TYPE::Split(N *node) {
     LeafPage *Leafnode = reinterpret_cast<LeafPage *>(node);
     LeafPage *Leafnode_page = reinterpret_cast<LeafPage *>(page);
     Leafnode_page->Init(newpage, Leafnode->GetParentPageId(), Leafnode->GetMaxSize());
-    Leafnode->MoveHalfTo(Leafnode_page);
+    if (right_edge) {
+      int keep = Leafnode->GetSize() * RIGHT_EDGE_FILL_PERCENT / 100;
+      keep = std::min(std::max(keep, Leafnode->GetMinSize()), Leafnode->GetSize() - 1);
+      Leafnode->MoveTailTo(Leafnode_page, keep);
+    } else {
+      Leafnode->MoveHalfTo(Leafnode_page);
+    }
     Leafnode_page->SetNextPageId(Leafnode->GetNextPageId());
     Leafnode->SetNextPageId(Leafnode_page->GetPageId());
     newnode = reinterpret_cast<N *>(Leafnode_page);
   } else {
+    // the new internal page would be missing from its cached level
+    ReleaseNodeCache();
     InternalPage *internalnode = reinterpret_cast<InternalPage *>(node);
     InternalPage *new_internalnode = reinterpret_cast<InternalPage *>(page);
     new_internalnode->Init(newpage, internalnode->GetParentPageId(), internalnode->GetMaxSize());
-    internalnode->MoveHalfTo(new_internalnode, buffer_pool_manager_);
+    if (right_edge) {
+      // the new page needs two children, one separator key to push up and one to keep
+      int keep = internalnode->GetSize() * RIGHT_EDGE_FILL_PERCENT / 100;
+      keep = std::min(std::max(keep, internalnode->GetMinSize()), internalnode->GetSize() - 2);
+      internalnode->MoveTailTo(new_internalnode, keep, buffer_pool_manager_);
+    } else {
+      internalnode->MoveHalfTo(new_internalnode, buffer_pool_manager_);
+    }
     newnode = reinterpret_cast<N *>(new_internalnode);
   }
   return newnode;
@@ -182,11 +341,14 @@ N *BPLUSTREE_TYPE::Split(N *node) {
  * User needs to first find the parent page of old_node, parent node must be
  * adjusted to take info of new_node into account. Remember to deal with split
  * recursively if necessary.
+ * right_edge tells that old_node is the right most page of its level and
+ * new_node holds the appended key, so the parent is on the right edge as well.
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
-                                      Transaction *transaction) {
+                                      Transaction *transaction, bool right_edge) {
   if (old_node->IsRootPage()) {
+    ReleaseNodeCache();
     Page *page = buffer_pool_manager_->NewPage(root_page_id_);
     if (page == nullptr) {
       throw std::string("out of memory");
@@ -205,9 +367,10 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
     new_node->SetParentPageId(old_node->GetParentPageId());
     newpre_page->InsertNodeAfter(old_node->GetPageId(), key, new_node->GetPageId());
     if (newpre_page->GetSize() > newpre_page->GetMaxSize()) {
-      InternalPage *t_newpre_page = Split(newpre_page);
+      right_edge = right_edge && newpre_page->ValueAt(newpre_page->GetSize() - 1) == new_node->GetPageId();
+      InternalPage *t_newpre_page = Split(newpre_page, right_edge);
       buffer_pool_manager_->UnpinPage(t_newpre_page->GetPageId(), true);
-      InsertIntoParent(newpre_page, t_newpre_page->KeyAt(0), t_newpre_page, transaction);
+      InsertIntoParent(newpre_page, t_newpre_page->KeyAt(0), t_newpre_page, transaction, right_edge);
     }
     buffer_pool_manager_->UnpinPage(old, true);
   }
@@ -228,8 +391,21 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
   if (IsEmpty()) return;
   Page *page = FindLeafPage(key, false);
   LeafPage *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  if (leaf->GetSize() <= leaf->GetMinSize() && !change_buffer_.empty()) {
+    // the siblings a merge or redistribution touches must not have pending entries
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    MergeChangeBuffer();
+    page = FindLeafPage(key, false);
+    leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  }
   leaf->RemoveAndDeleteRecord(key, comparator_);
+  if (leaf->GetSize() < leaf->GetMinSize()) {
+    // a merge may free the cached right most leaf and delete cached internal pages
+    rightmost_leaf_id_ = INVALID_PAGE_ID;
+    ReleaseNodeCache();
+  }
   CoalesceOrRedistribute(leaf, transaction);
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
 }
 
 /*
@@ -438,9 +614,12 @@ bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() {  // KeyType P;
+  // the iterator hops between leaves without FindLeafPage, merge every pending entry first
+  MergeChangeBuffer();
+  if (IsEmpty()) return INDEXITERATOR_TYPE(nullptr, 0, buffer_pool_manager_);
   Page *page = FindLeafPage(KeyType{}, true);
   LeafPage *page_leaf = reinterpret_cast<LeafPage *>(page->GetData());
-  buffer_pool_manager_->UnpinPage(page_leaf->GetPageId(), false);
+  // the leaf stays pinned until the iterator leaves it
   return INDEXITERATOR_TYPE(page_leaf, 0, buffer_pool_manager_);
 }
 
@@ -450,10 +629,11 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() {  // KeyType P;
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) {
-  Page *page = FindLeafPage(KeyType{}, false);
+  MergeChangeBuffer();
+  if (IsEmpty()) return INDEXITERATOR_TYPE(nullptr, 0, buffer_pool_manager_);
+  Page *page = FindLeafPage(key, false);
   LeafPage *page_leaf = reinterpret_cast<LeafPage *>(page->GetData());
   int index = page_leaf->KeyIndex(key, comparator_);
-  buffer_pool_manager_->UnpinPage(page_leaf->GetPageId(), false);
   return INDEXITERATOR_TYPE(page_leaf, index, buffer_pool_manager_);
 }
 
@@ -464,6 +644,8 @@ INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType
  */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() {
+  MergeChangeBuffer();
+  if (IsEmpty()) return INDEXITERATOR_TYPE(nullptr, 0, buffer_pool_manager_);
   Page *page = FindLeafPage(KeyType{}, true);
   LeafPage *page_leaf = reinterpret_cast<LeafPage *>(page->GetData());
   while (page_leaf->GetNextPageId() != -1) {
@@ -474,7 +656,8 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() {
     page_leaf = Next_leaf;
   }
 
-  return INDEXITERATOR_TYPE(page_leaf, page_leaf->GetSize() - 1, buffer_pool_manager_);  //?
+  // one past the last entry of the right most leaf
+  return INDEXITERATOR_TYPE(page_leaf, page_leaf->GetSize(), buffer_pool_manager_);
 }
 
 /*****************************************************************************
@@ -487,20 +670,185 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() {
  */
 INDEX_TEMPLATE_ARGUMENTS
 Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
-  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);  // now root page is pin
+  if (node_cache_levels_ > 0 && !node_cache_loaded_) {
+    LoadNodeCache();
+  }
+  // cached pages are already pinned, they are neither fetched nor unpinned here, the others are fetched
+  // through swizzled references so that resident children skip the page table
+  auto fetch = [&](page_id_t page_id, Page *&ref) -> Page * {
+    auto cached = node_cache_.find(page_id);
+    return cached != node_cache_.end() ? cached->second : buffer_pool_manager_->FetchPage(page_id, ref);
+  };
+  Page *page = fetch(root_page_id_, root_frame_);  // now root page is pin
   BPlusTreePage *node = reinterpret_cast<BPlusTreePage *>(page);
   while (!node->IsLeafPage()) {
     InternalPage *internal_node = reinterpret_cast<InternalPage *>(node);
-    page_id_t next_page_id = leftMost ? internal_node->ValueAt(0) : internal_node->Lookup(key, comparator_);
-    Page *next_page = buffer_pool_manager_->FetchPage(next_page_id);  // next_level_page pinned
+    int index = leftMost ? 0 : internal_node->LookupIndex(key, comparator_);
+    Page *next_page = fetch(internal_node->ValueAt(index), page->SwizzleSlot(index));  // next_level_page pinned
     BPlusTreePage *next_node = reinterpret_cast<BPlusTreePage *>(next_page);
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);  // curr_node unpinned
+    if (node_cache_.count(node->GetPageId()) == 0) {
+      buffer_pool_manager_->UnpinPage(node->GetPageId(), false);  // curr_node unpinned
+    }
     page = next_page;
     node = next_node;
   }
+  // apply the buffered inserts of the leaf, they may split it so descend again afterwards
+  if (!change_buffer_.empty() && change_buffer_.count(page->GetPageId()) != 0) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    MergeChanges(page->GetPageId());
+    return FindLeafPage(key, leftMost);
+  }
   return page;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+int BPLUSTREE_TYPE::GetHeight() {
+  if (height_ == 0 && !IsEmpty()) {
+    page_id_t page_id = root_page_id_;
+    for (height_ = 1;; height_++) {
+      auto *node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+      page_id_t child_id = node->IsLeafPage() ? INVALID_PAGE_ID : reinterpret_cast<InternalPage *>(node)->ValueAt(0);
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      if (child_id == INVALID_PAGE_ID) {
+        break;
+      }
+      page_id = child_id;
+    }
+  }
+  return height_;
+}
+
+/*
+ * Descend like FindLeafPage, but stop at the last internal level and hand
+ * back the child id, so that the leaf itself is never fetched.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t BPLUSTREE_TYPE::FindLeafPageId(const KeyType &key) {
+  if (GetHeight() == 1) {
+    return root_page_id_;
+  }
+  if (node_cache_levels_ > 0 && !node_cache_loaded_) {
+    LoadNodeCache();
+  }
+  auto fetch = [&](page_id_t page_id, Page *&ref) -> Page * {
+    auto cached = node_cache_.find(page_id);
+    return cached != node_cache_.end() ? cached->second : buffer_pool_manager_->FetchPage(page_id, ref);
+  };
+  auto release = [&](Page *page) {
+    if (node_cache_.count(page->GetPageId()) == 0) {
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    }
+  };
+  Page *page = fetch(root_page_id_, root_frame_);
+  for (int level = 1;; level++) {
+    auto *internal = reinterpret_cast<InternalPage *>(page->GetData());
+    int index = internal->LookupIndex(key, comparator_);
+    page_id_t child_id = internal->ValueAt(index);
+    if (level + 1 == height_) {
+      release(page);
+      return child_id;
+    }
+    Page *child = fetch(child_id, page->SwizzleSlot(index));
+    release(page);
+    page = child;
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::EnableChangeBuffer(size_t capacity) {
+  if (capacity < change_buffer_capacity_) {
+    MergeChangeBuffer();
+  }
+  change_buffer_capacity_ = capacity;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::BufferInsert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  if (change_buffer_capacity_ == 0 || IsEmpty()) {
+    return false;
+  }
+  page_id_t leaf_page_id = FindLeafPageId(key);
+  if (buffer_pool_manager_->IsPageResident(leaf_page_id)) {
+    return false;
+  }
+  change_buffer_[leaf_page_id].emplace_back(key, value);
+  if (++buffered_count_ >= change_buffer_capacity_) {
+    MergeChangeBuffer();
+  }
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::MergeChanges(page_id_t leaf_page_id) {
+  auto pending = change_buffer_.find(leaf_page_id);
+  if (pending == change_buffer_.end()) {
+    return false;
+  }
+  std::vector<MappingType> entries = std::move(pending->second);
+  change_buffer_.erase(pending);
+  buffered_count_ -= entries.size();
+  // the leaf is read once by the first insert and stays resident for the rest
+  for (auto &entry : entries) {
+    InsertIntoLeaf(entry.first, entry.second);
+  }
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::MergeChangeBuffer() {
+  while (!change_buffer_.empty()) {
+    MergeChanges(change_buffer_.begin()->first);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::EnableNodeCache(int levels, size_t max_pages) {
+  ReleaseNodeCache();
+  node_cache_levels_ = levels;
+  node_cache_capacity_ = max_pages;
+}
+
+/*
+ * Pin the internal pages level by level from the root. A level is cached as
+ * a whole or not at all, so a descent leaves the cache at a fixed depth, and
+ * leaves are never cached.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::LoadNodeCache() {
+  node_cache_loaded_ = true;
+  if (IsEmpty()) return;
+  std::vector<page_id_t> level{root_page_id_};
+  for (int depth = 0; depth < node_cache_levels_ && node_cache_.size() + level.size() <= node_cache_capacity_;
+       depth++) {
+    std::vector<page_id_t> next_level;
+    for (auto page_id : level) {
+      Page *page = buffer_pool_manager_->FetchPage(page_id);
+      auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+      if (node->IsLeafPage()) {
+        // all leaves are on the same level, nothing below the previous level is cached
+        buffer_pool_manager_->UnpinPage(page_id, false);
+        return;
+      }
+      auto *internal = reinterpret_cast<InternalPage *>(node);
+      for (int i = 0; i < internal->GetSize(); i++) {
+        next_level.push_back(internal->ValueAt(i));
+      }
+      node_cache_.emplace(page_id, page);
+    }
+    level.swap(next_level);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ReleaseNodeCache() {
+  // writers mark the pages dirty through their own fetch, the cache pin is released clean
+  for (auto &cached : node_cache_) {
+    buffer_pool_manager_->UnpinPage(cached.first, false);
+  }
+  node_cache_.clear();
+  node_cache_loaded_ = false;
+}
+
 /*
  * Update/Insert root page id in header page(where page_id = 0, header_page is
  * defined under include/page/header_page.h)
@@ -511,12 +859,15 @@ Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
+  height_ = 0;
   Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
-  IndexRootsPage *root = reinterpret_cast<IndexRootsPage *>(root_page);
-  if (insert_record)
+  IndexRootsPage *root = reinterpret_cast<IndexRootsPage *>(root_page->GetData());
+  // a tree emptied by removes keeps its record, a destroyed one has none
+  if (insert_record) {
+    if (!root->Insert(index_id_, root_page_id_)) root->Update(index_id_, root_page_id_);
+  } else if (!root->Update(index_id_, root_page_id_)) {
     root->Insert(index_id_, root_page_id_);
-  else
-    root->Update(index_id_, root_page_id_);
+  }
   buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
 }
 
@@ -640,6 +991,8 @@ void BPLUSTREE_TYPE::ToString(BPlusTreePage *page, BufferPoolManager *bpm) const
 
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::Check() {
+  // the node cache holds its pins on purpose, it is loaded again by the next descent
+  ReleaseNodeCache();
   bool all_unpinned = buffer_pool_manager_->CheckAllUnpinned();
   if (!all_unpinned) {
     LOG(ERROR) << "problem in page unpin" << endl;
@@ -658,3 +1011,9 @@ template class BPlusTree<GenericKey<16>, RowId, GenericComparator<16>>;
 template class BPlusTree<GenericKey<32>, RowId, GenericComparator<32>>;
 
 template class BPlusTree<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class BPlusTree<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class BPlusTree<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class BPlusTree<GenericKey<512>, RowId, GenericComparator<512>>;
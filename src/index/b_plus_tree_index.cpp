@@ -1,4 +1,6 @@
 #include "index/b_plus_tree_index.h"
+#include <algorithm>
+#include <numeric>
 #include "index/generic_key.h"
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -8,43 +10,180 @@ BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schem
 
 INDEX_TEMPLATE_ARGUMENTS
 dberr_t BPLUSTREE_INDEX_TYPE::InsertEntry(const Row &key, RowId row_id, Transaction *txn) {
+  dberr_t result = InsertIfAbsent(key, row_id, txn);
+  return result == DB_KEY_ALREADY_EXIST ? DB_FAILED : result;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t BPLUSTREE_INDEX_TYPE::InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) {
   ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
   KeyType index_key;
   index_key.SerializeFromKey(key, key_schema_);
 
-  bool status = container_.Insert(index_key, row_id, txn);
-
-  if (!status) {
-    return DB_FAILED;
+  // a key the filter has never seen is unique, so its leaf need not be read for the check
+  bool buffered = !MayContain(index_key) && container_.BufferInsert(index_key, row_id, txn);
+  if (!buffered && !container_.InsertIfAbsent(index_key, row_id, nullptr, txn)) {
+    return DB_KEY_ALREADY_EXIST;
+  }
+  AddToFilter(index_key);
+  if (filter_.GetKeyCount() > filter_.GetCapacity()) {
+    RebuildFilter();
   }
   return DB_SUCCESS;
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 dberr_t BPLUSTREE_INDEX_TYPE::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_KEY_NOT_FOUND;
+  }
   KeyType index_key;
   index_key.SerializeFromKey(key, key_schema_);
 
   container_.Remove(index_key, txn);
+  // removed keys keep their bits, rebuild once they make up half of the filter
+  if (filter_built_ && ++removed_count_ * 2 > filter_.GetKeyCount() && removed_count_ >= BloomFilter::DEFAULT_CAPACITY) {
+    RebuildFilter();
+  }
   return DB_SUCCESS;
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 dberr_t BPLUSTREE_INDEX_TYPE::ScanKey(const Row &key, vector<RowId> &result, Transaction *txn) {
+  // a key too long to be stored cannot be found
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_SUCCESS;
+  }
   KeyType index_key;
   index_key.SerializeFromKey(key, key_schema_);
+  if (!MayContain(index_key)) {
+    return DB_SUCCESS;
+  }
   if (container_.GetValue(index_key, result, txn)) {
     return DB_SUCCESS;
   }
   return DB_SUCCESS;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t BPLUSTREE_INDEX_TYPE::ScanKeys(const std::vector<Row> &keys, vector<RowId> &result, Transaction *txn) {
+  result.assign(keys.size(), INVALID_ROWID);
+  std::vector<KeyType> probe_keys;
+  std::vector<size_t> positions;
+  probe_keys.reserve(keys.size());
+  positions.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!KeyType::Fits(keys[i], key_schema_)) {
+      continue;
+    }
+    KeyType index_key;
+    index_key.SerializeFromKey(keys[i], key_schema_);
+    if (MayContain(index_key)) {
+      probe_keys.push_back(index_key);
+      positions.push_back(i);
+    }
+  }
+  // sort by key so that neighbouring probes share a leaf
+  std::vector<size_t> order(probe_keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) -> bool { return comparator_(probe_keys[a], probe_keys[b]) < 0; });
+  std::vector<KeyType> sorted_keys;
+  sorted_keys.reserve(order.size());
+  for (auto i : order) {
+    sorted_keys.push_back(probe_keys[i]);
+  }
+  std::vector<RowId> values;
+  std::vector<bool> found;
+  container_.GetValues(sorted_keys, values, found, txn);
+  for (size_t i = 0; i < order.size(); i++) {
+    if (found[i]) {
+      result[positions[order[i]]] = values[i];
+    }
+  }
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t BPLUSTREE_INDEX_TYPE::ScanRange(const Row *low, const Row *high, vector<RowId> &result, Transaction *txn) {
+  KeyType low_key, high_key;
+  if ((low != nullptr && !KeyType::Fits(*low, key_schema_)) || (high != nullptr && !KeyType::Fits(*high, key_schema_))) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  if (low != nullptr) {
+    low_key.SerializeFromKey(*low, key_schema_);
+  }
+  if (high != nullptr) {
+    high_key.SerializeFromKey(*high, key_schema_);
+  }
+  auto end = container_.End();
+  for (auto iter = low == nullptr ? container_.Begin() : container_.Begin(low_key); iter != end; ++iter) {
+    if (high != nullptr && comparator_((*iter).first, high_key) > 0) {
+      break;
+    }
+    result.push_back((*iter).second);
+  }
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t BPLUSTREE_INDEX_TYPE::Flush() {
+  container_.MergeChangeBuffer();
+  return DB_SUCCESS;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 dberr_t BPLUSTREE_INDEX_TYPE::Destroy() {
   container_.Destroy();
+  filter_.Reset(BloomFilter::DEFAULT_CAPACITY);
+  filter_built_ = true;
+  has_null_key_ = false;
+  removed_count_ = 0;
   return DB_SUCCESS;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_INDEX_TYPE::MayContain(const KeyType &key) {
+  if (!filter_built_) {
+    RebuildFilter();
+  }
+  // keys equal to the comparator are hashed as the same bytes; a null matches any key
+  KeyType canonical = key;
+  if (has_null_key_ || !comparator_.Canonicalize(canonical)) {
+    return true;
+  }
+  return filter_.MayContain(reinterpret_cast<const char *>(&canonical), sizeof(KeyType));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::AddToFilter(const KeyType &key) {
+  KeyType canonical = key;
+  if (!comparator_.Canonicalize(canonical)) {
+    has_null_key_ = true;
+    return;
+  }
+  filter_.Add(reinterpret_cast<const char *>(&canonical), sizeof(KeyType));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::RebuildFilter() {
+  size_t count = 0;
+  auto end = container_.End();
+  for (auto iter = container_.Begin(); iter != end; ++iter) {
+    count++;
+  }
+  filter_.Reset(count * 2);
+  filter_built_ = true;
+  has_null_key_ = false;
+  for (auto iter = container_.Begin(); iter != end; ++iter) {
+    AddToFilter((*iter).first);
+  }
+  removed_count_ = 0;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator() { return container_.Begin(); }
 
@@ -55,6 +194,17 @@ BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) { return container_.B
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetEndIterator() { return container_.End(); }
 
+INDEX_TEMPLATE_ARGUMENTS
+BPlusTreeStatistics BPLUSTREE_INDEX_TYPE::GetStatistics() { return container_.GetStatistics(); }
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::EnableNodeCache(int levels, size_t max_pages) {
+  container_.EnableNodeCache(levels, max_pages);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::EnableChangeBuffer(size_t capacity) { container_.EnableChangeBuffer(capacity); }
+
 template class BPlusTreeIndex<GenericKey<4>, RowId, GenericComparator<4>>;
 
 template class BPlusTreeIndex<GenericKey<8>, RowId, GenericComparator<8>>;
@@ -63,4 +213,10 @@ template class BPlusTreeIndex<GenericKey<16>, RowId, GenericComparator<16>>;
 
 template class BPlusTreeIndex<GenericKey<32>, RowId, GenericComparator<32>>;
 
-template class BPlusTreeIndex<GenericKey<64>, RowId, GenericComparator<64>>;
\ No newline at end of file
+template class BPlusTreeIndex<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class BPlusTreeIndex<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class BPlusTreeIndex<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class BPlusTreeIndex<GenericKey<512>, RowId, GenericComparator<512>>;
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "index/bloom_filter.h"
+#include <functional>
+#include <string_view>
+
+namespace {
+// finalizer of MurmurHash3, derives the second hash for double hashing
+inline uint64_t Mix64(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+}  // namespace
+
+BloomFilter::BloomFilter(size_t capacity) { Reset(capacity); }
+
+void BloomFilter::Reset(size_t capacity) {
+  capacity_ = capacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : capacity;
+  num_bits_ = static_cast<uint64_t>(capacity_) * BITS_PER_KEY;
+  bits_.assign((num_bits_ + 63) / 64, 0);
+  key_count_ = 0;
+}
+
+void BloomFilter::Add(const char *data, size_t size) {
+  uint64_t h1 = std::hash<std::string_view>{}(std::string_view(data, size));
+  uint64_t h2 = Mix64(h1) | 1;
+  for (uint32_t i = 0; i < NUM_HASHES; i++) {
+    uint64_t bit = (h1 + i * h2) % num_bits_;
+    bits_[bit >> 6] |= 1ULL << (bit & 63);
+  }
+  key_count_++;
+}
+
+bool BloomFilter::MayContain(const char *data, size_t size) const {
+  uint64_t h1 = std::hash<std::string_view>{}(std::string_view(data, size));
+  uint64_t h2 = Mix64(h1) | 1;
+  for (uint32_t i = 0; i < NUM_HASHES; i++) {
+    uint64_t bit = (h1 + i * h2) % num_bits_;
+    if ((bits_[bit >> 6] & (1ULL << (bit & 63))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
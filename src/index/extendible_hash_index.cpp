@@ -0,0 +1,74 @@
+#include "index/extendible_hash_index.h"
+#include "index/generic_key.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+EXTENDIBLE_HASH_INDEX_TYPE::ExtendibleHashIndex(index_id_t index_id, IndexSchema *key_schema,
+                                                BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema), comparator_(key_schema_), container_(index_id, buffer_pool_manager, comparator_) {}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t EXTENDIBLE_HASH_INDEX_TYPE::InsertEntry(const Row &key, RowId row_id, Transaction *txn) {
+  dberr_t result = InsertIfAbsent(key, row_id, txn);
+  return result == DB_KEY_ALREADY_EXIST ? DB_FAILED : result;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t EXTENDIBLE_HASH_INDEX_TYPE::InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) {
+  ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+
+  if (container_.Insert(index_key, row_id, txn)) {
+    return DB_SUCCESS;
+  }
+  return DB_KEY_ALREADY_EXIST;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t EXTENDIBLE_HASH_INDEX_TYPE::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_KEY_NOT_FOUND;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+
+  container_.Remove(index_key, txn);
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t EXTENDIBLE_HASH_INDEX_TYPE::ScanKey(const Row &key, vector<RowId> &result, Transaction *txn) {
+  // a key too long to be stored cannot be found
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_SUCCESS;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+  container_.GetValue(index_key, result, txn);
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t EXTENDIBLE_HASH_INDEX_TYPE::Destroy() {
+  container_.Destroy();
+  return DB_SUCCESS;
+}
+
+template class ExtendibleHashIndex<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class ExtendibleHashIndex<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class ExtendibleHashIndex<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class ExtendibleHashIndex<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class ExtendibleHashIndex<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class ExtendibleHashIndex<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class ExtendibleHashIndex<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class ExtendibleHashIndex<GenericKey<512>, RowId, GenericComparator<512>>;
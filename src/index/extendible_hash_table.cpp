@@ -0,0 +1,427 @@
+#include "index/extendible_hash_table.h"
+#include <string_view>
+#include <unordered_set>
+#include "glog/logging.h"
+#include "index/basic_comparator.h"
+#include "index/generic_key.h"
+#include "page/index_roots_page.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+EXTENDIBLE_HASH_TABLE_TYPE::ExtendibleHashTable(index_id_t index_id, BufferPoolManager *buffer_pool_manager,
+                                                const KeyComparator &comparator)
+    : index_id_(index_id), buffer_pool_manager_(buffer_pool_manager), comparator_(comparator) {
+  Page *index_root_page_raw = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  auto index_root_page = reinterpret_cast<IndexRootsPage *>(index_root_page_raw->GetData());
+  directory_page_id_ = INVALID_PAGE_ID;
+  index_root_page->GetRootId(index_id, &directory_page_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::IsEmpty() const { return directory_page_id_ == INVALID_PAGE_ID; }
+
+template <typename KeyType, typename KeyComparator>
+static void CanonicalizeKey(KeyType &, const KeyComparator &) {}
+
+template <size_t KeySize>
+static void CanonicalizeKey(GenericKey<KeySize> &key, const GenericComparator<KeySize> &comparator) {
+  comparator.Canonicalize(key);
+}
+
+/*
+ * Keys are serialized with their padding zeroed and hashed in canonical form,
+ * so equal keys such as 0.0 and -0.0 land in the same bucket.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::Hash(const KeyType &key) const {
+  KeyType canonical = key;
+  CanonicalizeKey(canonical, comparator_);
+  std::string_view bytes(reinterpret_cast<const char *>(&canonical), sizeof(KeyType));
+  return static_cast<uint32_t>(std::hash<std::string_view>{}(bytes));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+HashTableDirectoryPage *EXTENDIBLE_HASH_TABLE_TYPE::FetchDirectoryPage() {
+  Page *page = buffer_pool_manager_->FetchPage(directory_page_id_);
+  ASSERT(page != nullptr, "Can not fetch hash directory page.");
+  return reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+typename EXTENDIBLE_HASH_TABLE_TYPE::BucketPage *EXTENDIBLE_HASH_TABLE_TYPE::FetchBucketPage(
+    page_id_t bucket_page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  ASSERT(page != nullptr, "Can not fetch hash bucket page.");
+  return reinterpret_cast<BucketPage *>(page->GetData());
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::GetGlobalDepth() {
+  if (IsEmpty()) return 0;
+  HashTableDirectoryPage *dir = FetchDirectoryPage();
+  uint32_t depth = dir->GetGlobalDepth();
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  return depth;
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> &result,
+                                          Transaction *transaction) {
+  if (IsEmpty()) return false;
+  HashTableDirectoryPage *dir = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir->GetBucketPageId(Hash(key) & dir->GetGlobalDepthMask());
+  BucketPage *bucket = FetchBucketPage(bucket_page_id);
+  ValueType v;
+  bool found = bucket->Lookup(key, v, comparator_);
+  page_id_t next_page_id = bucket->GetNextPageId();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  while (!found && next_page_id != INVALID_PAGE_ID) {
+    BucketPage *overflow = FetchBucketPage(next_page_id);
+    found = overflow->Lookup(key, v, comparator_);
+    page_id_t overflow_page_id = next_page_id;
+    next_page_id = overflow->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(overflow_page_id, false);
+  }
+  if (found) {
+    result.push_back(v);
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  return found;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * Create the directory page with a single bucket of local depth 0
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void EXTENDIBLE_HASH_TABLE_TYPE::StartNewTable() {
+  page_id_t dir_page_id, bucket_page_id;
+  Page *dir_page = buffer_pool_manager_->NewPage(dir_page_id);
+  ASSERT(dir_page != nullptr, "out of memory");
+  Page *bucket_page = buffer_pool_manager_->NewPage(bucket_page_id);
+  ASSERT(bucket_page != nullptr, "out of memory");
+  auto dir = reinterpret_cast<HashTableDirectoryPage *>(dir_page->GetData());
+  dir->Init(dir_page_id);
+  dir->SetBucketPageId(0, bucket_page_id);
+  auto bucket = reinterpret_cast<BucketPage *>(bucket_page->GetData());
+  bucket->Init(bucket_page_id);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(dir_page_id, true);
+  directory_page_id_ = dir_page_id;
+  UpdateDirectoryPageId();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  if (IsEmpty()) {
+    StartNewTable();
+  }
+  HashTableDirectoryPage *dir = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir->GetBucketPageId(Hash(key) & dir->GetGlobalDepthMask());
+  BucketPage *bucket = FetchBucketPage(bucket_page_id);
+  bool full = bucket->IsFull();
+  bool inserted = !full && bucket->Insert(key, value, comparator_);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  if (!full) {
+    return inserted;
+  }
+  return SplitInsert(key, value);
+}
+
+/*
+ * Split the target bucket until the key fits, doubling the directory whenever
+ * the bucket is already as deep as the directory. A bucket at the max depth of
+ * the directory takes the key into its overflow chain instead.
+ * @return: false on duplicate key
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::SplitInsert(const KeyType &key, const ValueType &value) {
+  uint32_t hash = Hash(key);
+  while (true) {
+    HashTableDirectoryPage *dir = FetchDirectoryPage();
+    uint32_t bucket_idx = hash & dir->GetGlobalDepthMask();
+    page_id_t bucket_page_id = dir->GetBucketPageId(bucket_idx);
+    BucketPage *bucket = FetchBucketPage(bucket_page_id);
+    ValueType v;
+    if (bucket->Lookup(key, v, comparator_)) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      return false;
+    }
+    if (!bucket->IsFull()) {
+      bucket->Insert(key, value, comparator_);
+      buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+      buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+      return true;
+    }
+    uint32_t local_depth = dir->GetLocalDepth(bucket_idx);
+    if (local_depth == DIRECTORY_MAX_DEPTH) {
+      bool inserted = OverflowInsert(bucket, key, value);
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      return inserted;
+    }
+    if (local_depth == dir->GetGlobalDepth()) {
+      dir->IncrGlobalDepth();
+    }
+    page_id_t image_page_id;
+    Page *image_page = buffer_pool_manager_->NewPage(image_page_id);
+    ASSERT(image_page != nullptr, "out of memory");
+    auto image = reinterpret_cast<BucketPage *>(image_page->GetData());
+    image->Init(image_page_id);
+    // every slot sharing the bucket gets one more bit, half of them move to the image
+    uint32_t split_bit = 1U << local_depth;
+    for (uint32_t i = 0; i < dir->Size(); i++) {
+      if (dir->GetBucketPageId(i) == bucket_page_id) {
+        dir->SetLocalDepth(i, local_depth + 1);
+        if (i & split_bit) {
+          dir->SetBucketPageId(i, image_page_id);
+        }
+      }
+    }
+    for (int i = 0; i < bucket->GetSize();) {
+      KeyType k = bucket->KeyAt(i);
+      if (Hash(k) & split_bit) {
+        image->Insert(k, bucket->ValueAt(i), comparator_);
+        bucket->RemoveAt(i);
+      } else {
+        i++;
+      }
+    }
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+    buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+  }
+}
+
+/*
+ * Insert into the overflow chain of a bucket that can not split any more. Every
+ * page of the chain but the last one is full, new entries go to the last page.
+ * @return: false on duplicate key
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::OverflowInsert(BucketPage *bucket, const KeyType &key, const ValueType &value) {
+  ValueType v;
+  if (bucket->Lookup(key, v, comparator_)) {
+    return false;
+  }
+  page_id_t page_id = bucket->GetPageId();
+  BucketPage *page = bucket;
+  while (page->GetNextPageId() != INVALID_PAGE_ID) {
+    page_id_t next_page_id = page->GetNextPageId();
+    if (page != bucket) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+    }
+    page_id = next_page_id;
+    page = FetchBucketPage(page_id);
+    if (page->Lookup(key, v, comparator_)) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      return false;
+    }
+  }
+  if (page->IsFull()) {
+    page_id_t overflow_page_id;
+    Page *overflow_page = buffer_pool_manager_->NewPage(overflow_page_id);
+    ASSERT(overflow_page != nullptr, "out of memory");
+    auto overflow = reinterpret_cast<BucketPage *>(overflow_page->GetData());
+    overflow->Init(overflow_page_id);
+    overflow->Insert(key, value, comparator_);
+    page->SetNextPageId(overflow_page_id);
+    buffer_pool_manager_->UnpinPage(overflow_page_id, true);
+  } else {
+    page->Insert(key, value, comparator_);
+  }
+  if (page != bucket) {
+    buffer_pool_manager_->UnpinPage(page_id, true);
+  }
+  return true;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void EXTENDIBLE_HASH_TABLE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  if (IsEmpty()) return;
+  HashTableDirectoryPage *dir = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir->GetBucketPageId(Hash(key) & dir->GetGlobalDepthMask());
+  BucketPage *bucket = FetchBucketPage(bucket_page_id);
+  bool removed = bucket->GetNextPageId() == INVALID_PAGE_ID ? bucket->Remove(key, comparator_)
+                                                            : OverflowRemove(bucket, key);
+  bool empty = bucket->IsEmpty();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, removed);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  if (removed && empty) {
+    Merge(key);
+  }
+}
+
+/*
+ * Remove from a bucket with overflow pages. The last entry of the chain fills
+ * the hole and the last page is released once empty, so every page of the chain
+ * but the last one stays full.
+ * @return: false if the key does not exist
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::OverflowRemove(BucketPage *bucket, const KeyType &key) {
+  std::vector<page_id_t> chain{bucket->GetPageId()};
+  page_id_t hole_page_id = bucket->Remove(key, comparator_) ? bucket->GetPageId() : INVALID_PAGE_ID;
+  for (page_id_t page_id = bucket->GetNextPageId(); page_id != INVALID_PAGE_ID;) {
+    BucketPage *page = FetchBucketPage(page_id);
+    bool removed = hole_page_id == INVALID_PAGE_ID && page->Remove(key, comparator_);
+    if (removed) {
+      hole_page_id = page_id;
+    }
+    chain.push_back(page_id);
+    page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(chain.back(), removed);
+  }
+  if (hole_page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  page_id_t last_page_id = chain.back();
+  BucketPage *last = FetchBucketPage(last_page_id);
+  if (hole_page_id != last_page_id) {
+    BucketPage *hole = hole_page_id == bucket->GetPageId() ? bucket : FetchBucketPage(hole_page_id);
+    int index = last->GetSize() - 1;
+    hole->Insert(last->KeyAt(index), last->ValueAt(index), comparator_);
+    last->RemoveAt(index);
+    if (hole != bucket) {
+      buffer_pool_manager_->UnpinPage(hole_page_id, true);
+    }
+  }
+  bool empty = last->IsEmpty();
+  buffer_pool_manager_->UnpinPage(last_page_id, true);
+  if (empty) {
+    page_id_t prev_page_id = chain[chain.size() - 2];
+    BucketPage *prev = prev_page_id == bucket->GetPageId() ? bucket : FetchBucketPage(prev_page_id);
+    prev->SetNextPageId(INVALID_PAGE_ID);
+    if (prev != bucket) {
+      buffer_pool_manager_->UnpinPage(prev_page_id, true);
+    }
+    buffer_pool_manager_->DeletePage(last_page_id);
+  }
+  return true;
+}
+
+/*
+ * Fold an empty bucket into its split image while both have the same local
+ * depth, then shrink the directory as far as possible.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void EXTENDIBLE_HASH_TABLE_TYPE::Merge(const KeyType &key) {
+  uint32_t hash = Hash(key);
+  HashTableDirectoryPage *dir = FetchDirectoryPage();
+  bool dirty = false;
+  while (true) {
+    uint32_t bucket_idx = hash & dir->GetGlobalDepthMask();
+    uint32_t local_depth = dir->GetLocalDepth(bucket_idx);
+    if (local_depth == 0) break;
+    uint32_t image_idx = dir->GetSplitImageIndex(bucket_idx);
+    if (dir->GetLocalDepth(image_idx) != local_depth) break;
+    page_id_t bucket_page_id = dir->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = dir->GetBucketPageId(image_idx);
+    BucketPage *bucket = FetchBucketPage(bucket_page_id);
+    bool empty = bucket->IsEmpty();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    if (!empty) break;
+    // an image with overflow pages stays at the max depth, a split could not divide its chain
+    BucketPage *image = FetchBucketPage(image_page_id);
+    bool chained = image->GetNextPageId() != INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(image_page_id, false);
+    if (chained) break;
+    buffer_pool_manager_->DeletePage(bucket_page_id);
+    for (uint32_t i = 0; i < dir->Size(); i++) {
+      page_id_t page_id = dir->GetBucketPageId(i);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir->SetBucketPageId(i, image_page_id);
+        dir->SetLocalDepth(i, local_depth - 1);
+      }
+    }
+    while (dir->CanShrink()) {
+      dir->DecrGlobalDepth();
+    }
+    dirty = true;
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dirty);
+}
+
+/*****************************************************************************
+ * UTILITIES AND DEBUG
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void EXTENDIBLE_HASH_TABLE_TYPE::Destroy() {
+  if (IsEmpty()) return;
+  HashTableDirectoryPage *dir = FetchDirectoryPage();
+  std::unordered_set<page_id_t> bucket_page_ids;
+  for (uint32_t i = 0; i < dir->Size(); i++) {
+    bucket_page_ids.insert(dir->GetBucketPageId(i));
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  std::vector<page_id_t> pages(bucket_page_ids.begin(), bucket_page_ids.end());
+  for (page_id_t bucket_page_id : bucket_page_ids) {
+    BucketPage *bucket = FetchBucketPage(bucket_page_id);
+    page_id_t page_id = bucket->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    while (page_id != INVALID_PAGE_ID) {
+      pages.push_back(page_id);
+      BucketPage *overflow = FetchBucketPage(page_id);
+      page_id_t next_page_id = overflow->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+    }
+  }
+  pages.push_back(directory_page_id_);
+  buffer_pool_manager_->DeletePages(pages);
+  directory_page_id_ = INVALID_PAGE_ID;
+  // drop the record so that a reused index id starts from an empty table
+  Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  reinterpret_cast<IndexRootsPage *>(root_page->GetData())->Delete(index_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
+
+/*
+ * Update or insert the directory page id in the index roots page
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void EXTENDIBLE_HASH_TABLE_TYPE::UpdateDirectoryPageId() {
+  Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  auto root = reinterpret_cast<IndexRootsPage *>(root_page->GetData());
+  if (!root->Update(index_id_, directory_page_id_)) {
+    root->Insert(index_id_, directory_page_id_);
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool EXTENDIBLE_HASH_TABLE_TYPE::Check() {
+  bool all_unpinned = buffer_pool_manager_->CheckAllUnpinned();
+  if (!all_unpinned) {
+    LOG(ERROR) << "problem in page unpin" << endl;
+  }
+  return all_unpinned;
+}
+
+template class ExtendibleHashTable<int, int, BasicComparator<int>>;
+
+template class ExtendibleHashTable<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class ExtendibleHashTable<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class ExtendibleHashTable<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class ExtendibleHashTable<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class ExtendibleHashTable<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class ExtendibleHashTable<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class ExtendibleHashTable<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class ExtendibleHashTable<GenericKey<512>, RowId, GenericComparator<512>>;
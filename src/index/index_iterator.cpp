@@ -6,10 +6,15 @@ INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE::IndexIterator(B_PLUS_TREE_LEAF_PAGE
                                                            BufferPoolManager *buffer_pool_manager_)
     : c_page(Leafpage), c_index(index), c_buffer_pool_manager_(buffer_pool_manager_) {}
 
+INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE::IndexIterator(const IndexIterator &other)
+    : c_page(other.c_page), c_index(other.c_index), c_buffer_pool_manager_(other.c_buffer_pool_manager_) {
+  if (c_page != nullptr) {
+    c_buffer_pool_manager_->FetchPage(c_page->GetPageId());
+  }
+}
+
 INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE::~IndexIterator() {
   if (c_page != nullptr) {
-    Page *page = c_buffer_pool_manager_->FetchPage(c_page->GetPageId());
-    page->RUnlatch();
     c_buffer_pool_manager_->UnpinPage(c_page->GetPageId(), false);
   }
 }
@@ -22,12 +27,13 @@ INDEX_TEMPLATE_ARGUMENTS const MappingType &INDEXITERATOR_TYPE::operator*() {
 INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
   // ASSERT(false, "Not implemented yet.");
   c_index++;
-  if (c_index == this->c_page->GetSize() && this->c_page->GetNextPageId() != -1) {
+  if (c_index == this->c_page->GetSize() && this->c_page->GetNextPageId() != INVALID_PAGE_ID) {
     page_id_t next = c_page->GetNextPageId();
-    Page *Next_page = this->c_buffer_pool_manager_->FetchPage(next);
-    B_PLUS_TREE_LEAF_PAGE_TYPE *next_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(Next_page);
+    // the leaf remembers the frame of its right sibling, a resident sibling skips the page table
+    Page *Next_page = this->c_buffer_pool_manager_->FetchPage(next, reinterpret_cast<Page *>(c_page)->SwizzleSlot(0));
+    B_PLUS_TREE_LEAF_PAGE_TYPE *next_node = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(Next_page->GetData());
+    this->c_buffer_pool_manager_->UnpinPage(c_page->GetPageId(), false);
     c_page = next_node;
-    this->c_buffer_pool_manager_->UnpinPage(Next_page->GetPageId(), false);
     c_index = 0;
   }
   return *this;
@@ -35,7 +41,11 @@ INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
 
 INDEX_TEMPLATE_ARGUMENTS
 bool INDEXITERATOR_TYPE::operator==(const IndexIterator &itr) const {
-  return this->c_page == itr.c_page && this->c_index == itr.c_index;
+  // compare page ids, two iterators over the same leaf may hold different frames after eviction
+  if (this->c_page == nullptr || itr.c_page == nullptr) {
+    return this->c_page == itr.c_page;
+  }
+  return this->c_page->GetPageId() == itr.c_page->GetPageId() && this->c_index == itr.c_index;
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -52,3 +62,9 @@ template class IndexIterator<GenericKey<16>, RowId, GenericComparator<16>>;
 template class IndexIterator<GenericKey<32>, RowId, GenericComparator<32>>;
 
 template class IndexIterator<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class IndexIterator<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class IndexIterator<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class IndexIterator<GenericKey<512>, RowId, GenericComparator<512>>;
@@ -0,0 +1,108 @@
+#include "index/lsm_index.h"
+#include "index/generic_key.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+LSM_INDEX_TYPE::LSMIndex(index_id_t index_id, IndexSchema *key_schema, BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema), comparator_(key_schema_), container_(index_id, buffer_pool_manager, comparator_) {}
+
+/*
+ * A blind put into the memtable, an entry of the same key is overwritten
+ * instead of being reported. Callers that must detect duplicates use
+ * InsertIfAbsent, which pays for the lookup.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::InsertEntry(const Row &key, RowId row_id, Transaction *txn) {
+  ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+
+  container_.Insert(index_key, row_id, txn);
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) {
+  ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+
+  return container_.InsertIfAbsent(index_key, row_id, txn) ? DB_SUCCESS : DB_KEY_ALREADY_EXIST;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_KEY_NOT_FOUND;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+
+  container_.Remove(index_key, txn);
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::ScanKey(const Row &key, vector<RowId> &result, Transaction *txn) {
+  // a key too long to be stored cannot be found
+  if (!KeyType::Fits(key, key_schema_)) {
+    return DB_SUCCESS;
+  }
+  KeyType index_key;
+  index_key.SerializeFromKey(key, key_schema_);
+  container_.GetValue(index_key, result, txn);
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::ScanRange(const Row *low, const Row *high, vector<RowId> &result, Transaction *txn) {
+  KeyType low_key, high_key;
+  if ((low != nullptr && !KeyType::Fits(*low, key_schema_)) || (high != nullptr && !KeyType::Fits(*high, key_schema_))) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  if (low != nullptr) {
+    low_key.SerializeFromKey(*low, key_schema_);
+  }
+  if (high != nullptr) {
+    high_key.SerializeFromKey(*high, key_schema_);
+  }
+  std::vector<MappingType> entries;
+  container_.GetRange(low == nullptr ? nullptr : &low_key, high == nullptr ? nullptr : &high_key, entries, txn);
+  for (auto &entry : entries) {
+    result.push_back(entry.second);
+  }
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::Flush() {
+  container_.Flush();
+  return DB_SUCCESS;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+dberr_t LSM_INDEX_TYPE::Destroy() {
+  container_.Destroy();
+  return DB_SUCCESS;
+}
+
+template class LSMIndex<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class LSMIndex<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class LSMIndex<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class LSMIndex<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class LSMIndex<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class LSMIndex<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class LSMIndex<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class LSMIndex<GenericKey<512>, RowId, GenericComparator<512>>;
@@ -0,0 +1,398 @@
+#include "index/lsm_tree.h"
+#include <algorithm>
+#include "glog/logging.h"
+#include "index/generic_key.h"
+#include "page/index_roots_page.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+LSM_TREE_TYPE::LSMTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
+                       size_t memtable_capacity, size_t level_fanout)
+    : index_id_(index_id),
+      buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      memtable_(comparator),
+      memtable_capacity_(memtable_capacity),
+      level_fanout_(std::max<size_t>(level_fanout, 2)) {
+  Page *index_root_page_raw = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  auto index_root_page = reinterpret_cast<IndexRootsPage *>(index_root_page_raw->GetData());
+  manifest_page_id_ = INVALID_PAGE_ID;
+  index_root_page->GetRootId(index_id, &manifest_page_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+  if (manifest_page_id_ == INVALID_PAGE_ID) {
+    return;
+  }
+  Page *page = buffer_pool_manager_->FetchPage(manifest_page_id_);
+  ASSERT(page != nullptr, "Can not fetch lsm manifest page.");
+  auto *manifest = reinterpret_cast<LSMManifestPage *>(page->GetData());
+  std::vector<RunMeta> metas;
+  for (uint32_t i = 0; i < manifest->GetRunCount(); i++) {
+    metas.push_back(manifest->GetRun(i));
+  }
+  buffer_pool_manager_->UnpinPage(manifest_page_id_, false);
+  runs_.resize(metas.size());
+  for (size_t i = 0; i < metas.size(); i++) {
+    LoadRun(metas[i], runs_[i]);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::IsEmpty() const { return runs_.empty() && memtable_.IsEmpty(); }
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> &result, Transaction *transaction) {
+  ValueType value;
+  if (!Find(key, value) || IsTombstone(value)) {
+    return false;
+  }
+  result.push_back(value);
+  return true;
+}
+
+/*
+ * The memtable holds the newest entries, then runs are probed from the newest
+ * to the oldest. The first entry found decides, even if it is a tombstone.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::Find(const KeyType &key, ValueType &value) {
+  if (memtable_.Get(key, value)) {
+    return true;
+  }
+  for (auto it = runs_.rbegin(); it != runs_.rend(); ++it) {
+    if (LookupRun(*it, key, value)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::LookupRun(const Run &run, const KeyType &key, ValueType &value) {
+  // the filter holds canonical keys, see GenericComparator::Canonicalize
+  KeyType canonical = key;
+  if (!run.has_null_key && comparator_.Canonicalize(canonical) &&
+      !run.filter.MayContain(reinterpret_cast<const char *>(&canonical), sizeof(KeyType))) {
+    return false;
+  }
+  // the last page whose first key is <= key
+  auto fence = std::upper_bound(run.fences.begin(), run.fences.end(), key, [this](const KeyType &a, const KeyType &b) {
+    return comparator_(a, b) < 0;
+  });
+  if (fence == run.fences.begin()) {
+    return false;
+  }
+  page_id_t page_id = run.page_ids[fence - run.fences.begin() - 1];
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  ASSERT(page != nullptr, "Can not fetch lsm run page.");
+  bool found = reinterpret_cast<RunPage *>(page->GetData())->Lookup(key, value, comparator_);
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return found;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::GetRange(const KeyType *low, const KeyType *high, std::vector<MappingType> &result,
+                             Transaction *transaction) {
+  std::vector<MappingType> merged, older, next;
+  memtable_.Range(low, high, merged);
+  for (auto it = runs_.rbegin(); it != runs_.rend(); ++it) {
+    older.clear();
+    ReadRun(*it, low, high, older);
+    next.clear();
+    MergeSorted(merged, older, next);
+    merged.swap(next);
+  }
+  for (auto &item : merged) {
+    if (!IsTombstone(item.second)) {
+      result.push_back(item);
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::ReadRun(const Run &run, const KeyType *low, const KeyType *high,
+                            std::vector<MappingType> &result) {
+  size_t first = 0;
+  if (low != nullptr) {
+    auto fence = std::upper_bound(run.fences.begin(), run.fences.end(), *low,
+                                  [this](const KeyType &a, const KeyType &b) { return comparator_(a, b) < 0; });
+    first = fence == run.fences.begin() ? 0 : fence - run.fences.begin() - 1;
+  }
+  for (size_t i = first; i < run.page_ids.size(); i++) {
+    if (high != nullptr && comparator_(run.fences[i], *high) > 0) {
+      break;
+    }
+    Page *page = buffer_pool_manager_->FetchPage(run.page_ids[i]);
+    ASSERT(page != nullptr, "Can not fetch lsm run page.");
+    auto *run_page = reinterpret_cast<RunPage *>(page->GetData());
+    int j = (i == first && low != nullptr) ? run_page->KeyIndex(*low, comparator_) : 0;
+    for (; j < run_page->GetSize(); j++) {
+      if (high != nullptr && comparator_(run_page->KeyAt(j), *high) > 0) {
+        break;
+      }
+      result.push_back(run_page->GetItem(j));
+    }
+    buffer_pool_manager_->UnpinPage(run.page_ids[i], false);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::MergeSorted(const std::vector<MappingType> &newer, const std::vector<MappingType> &older,
+                                std::vector<MappingType> &result) const {
+  result.reserve(newer.size() + older.size());
+  size_t i = 0, j = 0;
+  while (i < newer.size() && j < older.size()) {
+    int cmp = comparator_(newer[i].first, older[j].first);
+    if (cmp <= 0) {
+      result.push_back(newer[i++]);
+      // the older entry of the same key is shadowed
+      j += cmp == 0;
+    } else {
+      result.push_back(older[j++]);
+    }
+  }
+  result.insert(result.end(), newer.begin() + i, newer.end());
+  result.insert(result.end(), older.begin() + j, older.end());
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  memtable_.Put(key, value);
+  if (memtable_.Size() >= memtable_capacity_) {
+    Flush();
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::InsertIfAbsent(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  ValueType existing;
+  if (Find(key, existing) && !IsTombstone(existing)) {
+    return false;
+  }
+  Insert(key, value, transaction);
+  return true;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::Remove(const KeyType &key, Transaction *transaction) { Insert(key, INVALID_ROWID, transaction); }
+
+/*****************************************************************************
+ * FLUSH & COMPACTION
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::Flush() {
+  if (memtable_.IsEmpty()) {
+    return;
+  }
+  std::vector<MappingType> entries;
+  memtable_.Range(nullptr, nullptr, entries);
+  memtable_.Clear();
+  // without older runs there is nothing a tombstone has to shadow
+  if (runs_.empty()) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [this](const MappingType &item) { return IsTombstone(item.second); }),
+                  entries.end());
+  }
+  Run run;
+  if (WriteRun(entries, 0, run)) {
+    runs_.push_back(std::move(run));
+  }
+  UpdateManifest();
+  Compact();
+}
+
+/*
+ * Runs are written into freshly allocated pages one after the other, so the
+ * pages of a run are contiguous in the file unless freed pages are reused.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::WriteRun(const std::vector<MappingType> &entries, uint32_t level, Run &run) {
+  if (entries.empty()) {
+    return false;
+  }
+  run.filter.Reset(entries.size());
+  page_id_t page_id = INVALID_PAGE_ID;
+  RunPage *run_page = nullptr;
+  for (auto &item : entries) {
+    if (run_page == nullptr || run_page->IsFull()) {
+      page_id_t next_page_id;
+      Page *page = buffer_pool_manager_->NewPage(next_page_id);
+      ASSERT(page != nullptr, "Can not allocate lsm run page.");
+      if (run_page != nullptr) {
+        run_page->SetNextPageId(next_page_id);
+        buffer_pool_manager_->UnpinPage(page_id, true);
+      }
+      page_id = next_page_id;
+      run_page = reinterpret_cast<RunPage *>(page->GetData());
+      run_page->Init();
+      run.page_ids.push_back(page_id);
+      run.fences.push_back(item.first);
+    }
+    run_page->Append(item);
+    AddToFilter(run, item.first);
+  }
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  run.meta = RunMeta{run.page_ids.front(), static_cast<uint32_t>(run.page_ids.size()),
+                     static_cast<uint32_t>(entries.size()), level};
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::AddToFilter(Run &run, const KeyType &key) {
+  KeyType canonical = key;
+  if (!comparator_.Canonicalize(canonical)) {
+    run.has_null_key = true;
+    return;
+  }
+  run.filter.Add(reinterpret_cast<const char *>(&canonical), sizeof(KeyType));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::LoadRun(const RunMeta &meta, Run &run) {
+  run.meta = meta;
+  run.filter.Reset(meta.entry_count);
+  page_id_t page_id = meta.first_page_id;
+  for (uint32_t i = 0; i < meta.page_count; i++) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    ASSERT(page != nullptr, "Can not fetch lsm run page.");
+    auto *run_page = reinterpret_cast<RunPage *>(page->GetData());
+    run.page_ids.push_back(page_id);
+    run.fences.push_back(run_page->KeyAt(0));
+    for (int j = 0; j < run_page->GetSize(); j++) {
+      AddToFilter(run, run_page->KeyAt(j));
+    }
+    page_id_t next_page_id = run_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+/*
+ * Levels only grow by a merge of the level below, whose output is the newest
+ * run of its level and sits at the back. So the back level is the only one
+ * that can be full, and a merge may cascade upwards. The engine executes one
+ * statement at a time, so compaction runs inline right after the flush.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::Compact() {
+  while (!runs_.empty()) {
+    uint32_t level = runs_.back().meta.level;
+    size_t first = runs_.size();
+    while (first > 0 && runs_[first - 1].meta.level == level) {
+      first--;
+    }
+    if (runs_.size() - first < level_fanout_) {
+      break;
+    }
+    std::vector<MappingType> merged, older, next;
+    for (size_t i = runs_.size(); i > first; i--) {
+      older.clear();
+      ReadRun(runs_[i - 1], nullptr, nullptr, older);
+      next.clear();
+      MergeSorted(merged, older, next);
+      merged.swap(next);
+    }
+    if (first == 0) {
+      merged.erase(std::remove_if(merged.begin(), merged.end(),
+                                  [this](const MappingType &item) { return IsTombstone(item.second); }),
+                   merged.end());
+    }
+    Run run;
+    bool written = WriteRun(merged, level + 1, run);
+    std::vector<Run> obsolete(std::make_move_iterator(runs_.begin() + first), std::make_move_iterator(runs_.end()));
+    runs_.erase(runs_.begin() + first, runs_.end());
+    if (written) {
+      runs_.push_back(std::move(run));
+    }
+    UpdateManifest();
+    FreeRuns(obsolete);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::FreeRuns(const std::vector<Run> &runs) {
+  std::vector<page_id_t> pages;
+  for (auto &run : runs) {
+    pages.insert(pages.end(), run.page_ids.begin(), run.page_ids.end());
+  }
+  if (!pages.empty()) {
+    buffer_pool_manager_->DeletePages(pages);
+  }
+}
+
+/*
+ * Rewrite the manifest page, creating it and registering it in the index
+ * roots page on the first flush
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::UpdateManifest() {
+  Page *page;
+  if (manifest_page_id_ == INVALID_PAGE_ID) {
+    page = buffer_pool_manager_->NewPage(manifest_page_id_);
+    ASSERT(page != nullptr, "Can not allocate lsm manifest page.");
+    Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+    auto root = reinterpret_cast<IndexRootsPage *>(root_page->GetData());
+    if (!root->Update(index_id_, manifest_page_id_)) {
+      root->Insert(index_id_, manifest_page_id_);
+    }
+    buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+  } else {
+    page = buffer_pool_manager_->FetchPage(manifest_page_id_);
+    ASSERT(page != nullptr, "Can not fetch lsm manifest page.");
+  }
+  std::vector<RunMeta> metas;
+  for (auto &run : runs_) {
+    metas.push_back(run.meta);
+  }
+  bool fits = reinterpret_cast<LSMManifestPage *>(page->GetData())->SetRuns(metas);
+  ASSERT(fits, "Too many lsm runs.");
+  buffer_pool_manager_->UnpinPage(manifest_page_id_, true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_TREE_TYPE::Destroy() {
+  memtable_.Clear();
+  FreeRuns(runs_);
+  runs_.clear();
+  if (manifest_page_id_ == INVALID_PAGE_ID) {
+    return;
+  }
+  buffer_pool_manager_->DeletePages({manifest_page_id_});
+  manifest_page_id_ = INVALID_PAGE_ID;
+  // drop the record so that a reused index id starts from an empty tree
+  Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  reinterpret_cast<IndexRootsPage *>(root_page->GetData())->Delete(index_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_TREE_TYPE::Check() {
+  bool all_unpinned = buffer_pool_manager_->CheckAllUnpinned();
+  if (!all_unpinned) {
+    LOG(ERROR) << "problem in page unpin" << endl;
+  }
+  return all_unpinned;
+}
+
+template class LSMTree<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class LSMTree<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class LSMTree<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class LSMTree<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class LSMTree<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class LSMTree<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class LSMTree<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class LSMTree<GenericKey<512>, RowId, GenericComparator<512>>;
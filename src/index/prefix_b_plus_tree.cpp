@@ -0,0 +1,301 @@
+#include "index/prefix_b_plus_tree.h"
+#include <cstdlib>
+#include "page/index_roots_page.h"
+
+PrefixBPlusTree::PrefixBPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager)
+    : index_id_(index_id), buffer_pool_manager_(buffer_pool_manager) {
+  Page *index_root_page_raw = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  auto index_root_page = reinterpret_cast<IndexRootsPage *>(index_root_page_raw->GetData());
+  index_root_page->GetRootId(index_id, &root_page_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+}
+
+std::string PrefixBPlusTree::ShortestSeparator(const std::string &left, const std::string &right) {
+  return right.substr(0, PrefixBPlusTreePage::CommonPrefixLength(left, right) + 1);
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+page_id_t PrefixBPlusTree::FindLeaf(const std::string *key) {
+  page_id_t page_id = root_page_id_;
+  while (true) {
+    auto *page = FetchTreePage(page_id);
+    if (page->IsLeafPage()) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      return page_id;
+    }
+    page_id_t child = page->ChildAt(key == nullptr ? 0 : page->ChildIndex(*key));
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = child;
+  }
+}
+
+bool PrefixBPlusTree::GetValue(const std::string &key, RowId &value) {
+  if (IsEmpty()) {
+    return false;
+  }
+  page_id_t leaf_id = FindLeaf(&key);
+  auto *leaf = FetchTreePage(leaf_id);
+  int index = leaf->LowerBound(key);
+  bool found = index < leaf->GetSize() && leaf->CompareAt(index, key) == 0;
+  if (found) {
+    value = leaf->RowIdAt(index);
+  }
+  buffer_pool_manager_->UnpinPage(leaf_id, false);
+  return found;
+}
+
+void PrefixBPlusTree::Range(const std::string *low, const std::string *high, std::vector<RowId> &result) {
+  if (IsEmpty()) {
+    return;
+  }
+  page_id_t leaf_id = FindLeaf(low);
+  auto *leaf = FetchTreePage(leaf_id);
+  int index = low == nullptr ? 0 : leaf->LowerBound(*low);
+  while (true) {
+    for (; index < leaf->GetSize(); index++) {
+      if (high != nullptr && leaf->CompareAt(index, *high) > 0) {
+        buffer_pool_manager_->UnpinPage(leaf_id, false);
+        return;
+      }
+      result.push_back(leaf->RowIdAt(index));
+    }
+    page_id_t next_id = leaf->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(leaf_id, false);
+    if (next_id == INVALID_PAGE_ID) {
+      return;
+    }
+    leaf_id = next_id;
+    leaf = FetchTreePage(leaf_id);
+    index = 0;
+  }
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+bool PrefixBPlusTree::Insert(const std::string &key, RowId value) {
+  ASSERT(key.size() <= MAX_KEY_SIZE, "Key too long for the prefix b+ tree.");
+  if (IsEmpty()) {
+    auto *root = reinterpret_cast<PrefixBPlusTreePage *>(buffer_pool_manager_->NewPage(root_page_id_)->GetData());
+    root->Init(true);
+    root->WriteEntries({{key, value.Get()}});
+    buffer_pool_manager_->UnpinPage(root_page_id_, true);
+    UpdateRootPageId(true);
+    return true;
+  }
+  std::string separator;
+  page_id_t new_page_id;
+  InsertResult result = InsertInto(root_page_id_, key, value, separator, new_page_id);
+  if (result == InsertResult::kSplit) {
+    // 根节点分裂，树长高一层
+    page_id_t old_root_id = root_page_id_;
+    auto *root = reinterpret_cast<PrefixBPlusTreePage *>(buffer_pool_manager_->NewPage(root_page_id_)->GetData());
+    root->Init(false);
+    root->WriteEntries({{"", old_root_id}, {separator, new_page_id}});
+    buffer_pool_manager_->UnpinPage(root_page_id_, true);
+    UpdateRootPageId(false);
+  }
+  return result != InsertResult::kDuplicate;
+}
+
+PrefixBPlusTree::InsertResult PrefixBPlusTree::InsertInto(page_id_t page_id, const std::string &key, RowId value,
+                                                          std::string &separator, page_id_t &new_page_id) {
+  auto *page = FetchTreePage(page_id);
+  std::vector<PrefixBPlusTreeEntry> entries;
+  int index;
+  if (page->IsLeafPage()) {
+    index = page->LowerBound(key);
+    if (index < page->GetSize() && page->CompareAt(index, key) == 0) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      return InsertResult::kDuplicate;
+    }
+    page->ReadEntries(entries);
+    entries.insert(entries.begin() + index, {key, value.Get()});
+  } else {
+    // 子树分裂时才需要修改本页，递归时不保持本页固定在缓冲池中
+    index = page->ChildIndex(key);
+    page_id_t child_id = page->ChildAt(index);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    std::string child_separator;
+    page_id_t child_page_id;
+    InsertResult result = InsertInto(child_id, key, value, child_separator, child_page_id);
+    if (result != InsertResult::kSplit) {
+      return result;
+    }
+    page = FetchTreePage(page_id);
+    page->ReadEntries(entries);
+    entries.insert(entries.begin() + index + 1, {std::move(child_separator), child_page_id});
+  }
+  InsertResult result = InsertResult::kDone;
+  if (!page->WriteEntries(entries)) {
+    Split(page, entries, separator, new_page_id);
+    result = InsertResult::kSplit;
+  }
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  return result;
+}
+
+/*
+ * Both halves must fit a page once their own prefixes are factored out. Among
+ * the split points leaving the halves within a quarter page of each other, the
+ * one promoting the shortest separator is taken, otherwise the most balanced
+ * one. An internal split keeps at least two children on each side and promotes
+ * the first separator of the right half, which becomes its empty slot 0.
+ */
+void PrefixBPlusTree::Split(PrefixBPlusTreePage *page, std::vector<PrefixBPlusTreeEntry> &entries,
+                            std::string &separator, page_id_t &new_page_id) {
+  bool is_leaf = page->IsLeafPage();
+  int count = static_cast<int>(entries.size());
+  int min_entries = is_leaf ? 1 : 2;
+  int best = -1;
+  size_t best_length = 0;
+  uint32_t best_balance = 0;
+  bool best_in_window = false;
+  for (int split = min_entries; split <= count - min_entries; split++) {
+    uint32_t left_size = PrefixBPlusTreePage::GetPageSize(entries, 0, split, is_leaf);
+    uint32_t right_size = PrefixBPlusTreePage::GetPageSize(entries, split, count, is_leaf);
+    if (left_size > PAGE_SIZE || right_size > PAGE_SIZE) {
+      continue;
+    }
+    uint32_t balance = std::abs(static_cast<int>(left_size) - static_cast<int>(right_size));
+    bool in_window = balance <= PAGE_SIZE / 4;
+    size_t length = is_leaf ? PrefixBPlusTreePage::CommonPrefixLength(entries[split - 1].key, entries[split].key) + 1
+                            : entries[split].key.size();
+    bool better;
+    if (best < 0 || in_window != best_in_window) {
+      better = best < 0 || in_window;
+    } else if (in_window && length != best_length) {
+      better = length < best_length;
+    } else {
+      better = balance < best_balance;
+    }
+    if (better) {
+      best = split;
+      best_length = length;
+      best_balance = balance;
+      best_in_window = in_window;
+    }
+  }
+  ASSERT(best > 0, "No split point of the page fits.");
+  separator = is_leaf ? ShortestSeparator(entries[best - 1].key, entries[best].key) : entries[best].key;
+  std::vector<PrefixBPlusTreeEntry> right(entries.begin() + best, entries.end());
+  entries.resize(best);
+  if (!is_leaf) {
+    right[0].key.clear();
+  }
+  auto *sibling = reinterpret_cast<PrefixBPlusTreePage *>(buffer_pool_manager_->NewPage(new_page_id)->GetData());
+  sibling->Init(is_leaf);
+  if (is_leaf) {
+    sibling->SetNextPageId(page->GetNextPageId());
+    page->SetNextPageId(new_page_id);
+  }
+  bool written = page->WriteEntries(entries) && sibling->WriteEntries(right);
+  ASSERT(written, "Split halves do not fit their pages.");
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+bool PrefixBPlusTree::Remove(const std::string &key) {
+  if (IsEmpty()) {
+    return false;
+  }
+  page_id_t leaf_id = FindLeaf(&key);
+  auto *leaf = FetchTreePage(leaf_id);
+  int index = leaf->LowerBound(key);
+  if (index >= leaf->GetSize() || leaf->CompareAt(index, key) != 0) {
+    buffer_pool_manager_->UnpinPage(leaf_id, false);
+    return false;
+  }
+  // 删去一个键后共同前缀只会变长，页总是放得下
+  std::vector<PrefixBPlusTreeEntry> entries;
+  leaf->ReadEntries(entries);
+  entries.erase(entries.begin() + index);
+  leaf->WriteEntries(entries);
+  buffer_pool_manager_->UnpinPage(leaf_id, true);
+  return true;
+}
+
+/*****************************************************************************
+ * UTILITIES
+ *****************************************************************************/
+void PrefixBPlusTree::Destroy() {
+  if (IsEmpty()) {
+    return;
+  }
+  // collect the pages level by level, all leaves are on the last level so they are never read
+  std::vector<page_id_t> pages;
+  std::vector<page_id_t> level{root_page_id_};
+  while (!level.empty()) {
+    pages.insert(pages.end(), level.begin(), level.end());
+    bool is_leaf = FetchTreePage(level[0])->IsLeafPage();
+    buffer_pool_manager_->UnpinPage(level[0], false);
+    if (is_leaf) {
+      break;
+    }
+    std::vector<page_id_t> next_level;
+    for (auto page_id : level) {
+      auto *internal = FetchTreePage(page_id);
+      for (int i = 0; i < internal->GetSize(); i++) {
+        next_level.push_back(internal->ChildAt(i));
+      }
+      buffer_pool_manager_->UnpinPage(page_id, false);
+    }
+    level.swap(next_level);
+  }
+  buffer_pool_manager_->DeletePages(pages);
+  root_page_id_ = INVALID_PAGE_ID;
+  // drop the record so that a reused index id starts from an empty tree
+  Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  reinterpret_cast<IndexRootsPage *>(root_page->GetData())->Delete(index_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
+
+BPlusTreeStatistics PrefixBPlusTree::GetStatistics() {
+  BPlusTreeStatistics stats;
+  if (IsEmpty()) {
+    return stats;
+  }
+  size_t leaf_bytes = 0;
+  size_t internal_bytes = 0;
+  std::vector<page_id_t> level{root_page_id_};
+  while (!level.empty()) {
+    stats.height++;
+    std::vector<page_id_t> next_level;
+    for (auto page_id : level) {
+      auto *page = FetchTreePage(page_id);
+      if (page->IsLeafPage()) {
+        stats.leaf_pages++;
+        stats.entries += page->GetSize();
+        leaf_bytes += page->GetUsedSize();
+      } else {
+        stats.internal_pages++;
+        internal_bytes += page->GetUsedSize();
+        for (int i = 0; i < page->GetSize(); i++) {
+          next_level.push_back(page->ChildAt(i));
+        }
+      }
+      buffer_pool_manager_->UnpinPage(page_id, false);
+    }
+    level.swap(next_level);
+  }
+  stats.leaf_fill_factor = static_cast<double>(leaf_bytes) / (stats.leaf_pages * PAGE_SIZE);
+  if (stats.internal_pages != 0) {
+    stats.internal_fill_factor = static_cast<double>(internal_bytes) / (stats.internal_pages * PAGE_SIZE);
+  }
+  return stats;
+}
+
+void PrefixBPlusTree::UpdateRootPageId(bool insert_record) {
+  Page *root_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  auto *root = reinterpret_cast<IndexRootsPage *>(root_page->GetData());
+  if (insert_record) {
+    if (!root->Insert(index_id_, root_page_id_)) root->Update(index_id_, root_page_id_);
+  } else if (!root->Update(index_id_, root_page_id_)) {
+    root->Insert(index_id_, root_page_id_);
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
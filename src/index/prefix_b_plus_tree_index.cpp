@@ -0,0 +1,50 @@
+#include "index/prefix_b_plus_tree_index.h"
+#include "index/art_index.h"
+
+PrefixBPlusTreeIndex::PrefixBPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema,
+                                           BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema), container_(index_id, buffer_pool_manager) {}
+
+dberr_t PrefixBPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Transaction *txn) {
+  dberr_t result = InsertIfAbsent(key, row_id, txn);
+  return result == DB_KEY_ALREADY_EXIST ? DB_FAILED : result;
+}
+
+dberr_t PrefixBPlusTreeIndex::InsertIfAbsent(const Row &key, RowId row_id, Transaction *txn) {
+  ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
+  std::string index_key = ARTIndex::EncodeKey(key, key_schema_->GetColumnCount());
+  if (index_key.size() > PrefixBPlusTree::MAX_KEY_SIZE) {
+    return DB_INDEX_KEY_TOO_LONG;
+  }
+  return container_.Insert(index_key, row_id) ? DB_SUCCESS : DB_KEY_ALREADY_EXIST;
+}
+
+dberr_t PrefixBPlusTreeIndex::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
+  return container_.Remove(ARTIndex::EncodeKey(key, key_schema_->GetColumnCount())) ? DB_SUCCESS : DB_KEY_NOT_FOUND;
+}
+
+dberr_t PrefixBPlusTreeIndex::ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn) {
+  RowId row_id;
+  if (container_.GetValue(ARTIndex::EncodeKey(key, key_schema_->GetColumnCount()), row_id)) {
+    result.push_back(row_id);
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t PrefixBPlusTreeIndex::ScanRange(const Row *low, const Row *high, std::vector<RowId> &result,
+                                        Transaction *txn) {
+  std::string low_key, high_key;
+  if (low != nullptr) {
+    low_key = ARTIndex::EncodeKey(*low, key_schema_->GetColumnCount());
+  }
+  if (high != nullptr) {
+    high_key = ARTIndex::EncodeKey(*high, key_schema_->GetColumnCount());
+  }
+  container_.Range(low == nullptr ? nullptr : &low_key, high == nullptr ? nullptr : &high_key, result);
+  return DB_SUCCESS;
+}
+
+dberr_t PrefixBPlusTreeIndex::Destroy() {
+  container_.Destroy();
+  return DB_SUCCESS;
+}
@@ -0,0 +1,113 @@
+#include "index/skip_list.h"
+#include <algorithm>
+#include "index/basic_comparator.h"
+#include "index/generic_key.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+SKIP_LIST_TYPE::SkipList(const KeyComparator &comparator) : comparator_(comparator), rng_(0x5eed) {
+  head_.next.assign(MAX_HEIGHT, nullptr);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+SKIP_LIST_TYPE::~SkipList() { Clear(); }
+
+/*
+ * Each level keeps a quarter of the nodes of the level below.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+int SKIP_LIST_TYPE::RandomHeight() {
+  int height = 1;
+  while (height < MAX_HEIGHT && (rng_() & 3) == 0) {
+    height++;
+  }
+  return height;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+typename SKIP_LIST_TYPE::Node *SKIP_LIST_TYPE::FindGreaterOrEqual(const KeyType &key, Node **prev) const {
+  auto *node = const_cast<Node *>(&head_);
+  for (int level = height_ - 1; level >= 0; level--) {
+    Node *next = node->next[level];
+    while (next != nullptr && comparator_(next->item.first, key) < 0) {
+      node = next;
+      next = node->next[level];
+    }
+    if (prev != nullptr) {
+      prev[level] = node;
+    }
+  }
+  return node->next[0];
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void SKIP_LIST_TYPE::Put(const KeyType &key, const ValueType &value) {
+  Node *prev[MAX_HEIGHT];
+  Node *node = FindGreaterOrEqual(key, prev);
+  if (node != nullptr && comparator_(node->item.first, key) == 0) {
+    node->item.second = value;
+    return;
+  }
+  int height = RandomHeight();
+  for (int level = height_; level < height; level++) {
+    prev[level] = &head_;
+  }
+  height_ = std::max(height_, height);
+  node = new Node{MappingType(key, value), std::vector<Node *>(height)};
+  for (int level = 0; level < height; level++) {
+    node->next[level] = prev[level]->next[level];
+    prev[level]->next[level] = node;
+  }
+  size_++;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool SKIP_LIST_TYPE::Get(const KeyType &key, ValueType &value) const {
+  Node *node = FindGreaterOrEqual(key, nullptr);
+  if (node != nullptr && comparator_(node->item.first, key) == 0) {
+    value = node->item.second;
+    return true;
+  }
+  return false;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void SKIP_LIST_TYPE::Range(const KeyType *low, const KeyType *high, std::vector<MappingType> &result) const {
+  Node *node = low == nullptr ? head_.next[0] : FindGreaterOrEqual(*low, nullptr);
+  for (; node != nullptr; node = node->next[0]) {
+    if (high != nullptr && comparator_(node->item.first, *high) > 0) {
+      break;
+    }
+    result.push_back(node->item);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void SKIP_LIST_TYPE::Clear() {
+  Node *node = head_.next[0];
+  while (node != nullptr) {
+    Node *next = node->next[0];
+    delete node;
+    node = next;
+  }
+  head_.next.assign(MAX_HEIGHT, nullptr);
+  height_ = 1;
+  size_ = 0;
+}
+
+template class SkipList<int, int, BasicComparator<int>>;
+
+template class SkipList<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class SkipList<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class SkipList<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class SkipList<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class SkipList<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class SkipList<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class SkipList<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class SkipList<GenericKey<512>, RowId, GenericComparator<512>>;
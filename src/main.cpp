@@ -91,6 +91,10 @@ int main(int argc, char **argv) {
       cout << "DB_PRIMARY_KEY_COLLISION ERROR\n";
     } else if (result == DB_UNIQUE_KEY_COLLISION) {
       cout << "DB_UNIQUE_KEY_COLLISION ERROR\n";
+    } else if (result == DB_INDEX_KEY_TOO_LONG) {
+      cout << "DB_INDEX_KEY_TOO_LONG ERROR\n";
+    } else if (result == DB_TYPE_MISMATCH) {
+      cout << "DB_TYPE_MISMATCH ERROR\n";
     }
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     cout << "time cost: "
@@ -1,4 +1,7 @@
 #include "page/b_plus_tree_internal_page.h"
+
+#include <algorithm>
+
 #include "index/basic_comparator.h"
 #include "index/generic_key.h"
 
@@ -16,6 +19,8 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id
   SetPageId(page_id);
   SetParentPageId(parent_id);
   SetSize(0);
+  // one spare slot holds the overflowing entry until the page is split
+  ASSERT(max_size < SLOT_COUNT, "Internal page max size does not fit in a page.");
   SetMaxSize(max_size);
 }
 /*
@@ -24,14 +29,13 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id
  */
 INDEX_TEMPLATE_ARGUMENTS
 KeyType B_PLUS_TREE_INTERNAL_PAGE_TYPE::KeyAt(int index) const {
-  // replace with your own code
-  return array_[index].first;
+  return keys_[index];
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_INTERNAL_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) {
   // assert(index < GetSize() && index >= 0);
-  array_[index].first = key;
+  keys_[index] = key;
 }
 
 /*
@@ -41,8 +45,9 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::SetKeyAt(int index, const KeyType &key) {
 INDEX_TEMPLATE_ARGUMENTS
 int B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueIndex(const ValueType &value) const {
   int size = GetSize();
+  const ValueType *children = Children();
   for (int i = 0; i < size; i++) {
-    if (array_[i].second == value) return i;
+    if (children[i] == value) return i;
   }
   return -1;
 }
@@ -53,10 +58,9 @@ int B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueIndex(const ValueType &value) const {
  */
 INDEX_TEMPLATE_ARGUMENTS
 ValueType B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueAt(int index) const {
-  // replace with your own code
   // int size = GetSize();
   // assert(index >= 0 && index < size);
-  return array_[index].second;
+  return Children()[index];
 }
 
 /*****************************************************************************
@@ -69,33 +73,31 @@ ValueType B_PLUS_TREE_INTERNAL_PAGE_TYPE::ValueAt(int index) const {
  */
 INDEX_TEMPLATE_ARGUMENTS
 ValueType B_PLUS_TREE_INTERNAL_PAGE_TYPE::Lookup(const KeyType &key, const KeyComparator &comparator) const {
-  // replace with your own code
-  int size = GetSize();
-  ValueType result;
-  int i;
-  for (i = 1; i < size; i++) {
-    if (comparator(key, array_[i].first) < 0) {
-      result = array_[i - 1].second;
-      break;
-    }
-  }
-  if (i == size) result = array_[i - 1].second;
-  return result;
+  return Children()[LookupIndex(key, comparator)];
+}
 
-  // int left = 1;
-  // int right = GetSize() - 1;
-  // while (left <= right) {
-  //   int mid = left + (right - left) / 2;
-  //   if (comparator(KeyAt(mid), key) > 0) {  // 下标还需要减小
-  //     right = mid - 1;
-  //   } else {  // 下标还需要增大
-  //     left = mid + 1;
-  //   }
-  // }  // upper_bound
-  // int target_index = left;
-  // assert(target_index - 1 >= 0);
-  // // 注意，返回的value下标要减1，这样才能满足key(i-1) <= subtree(value(i)) < key(i)
-  // return ValueAt(target_index - 1);
+/*
+ * Same as Lookup, but return the index of the child pointer
+ */
+INDEX_TEMPLATE_ARGUMENTS
+int B_PLUS_TREE_INTERNAL_PAGE_TYPE::LookupIndex(const KeyType &key, const KeyComparator &comparator) const {
+  // binary search over KEY(1)...KEY(n), the comparison only selects the next base so that it compiles to a
+  // conditional move instead of a branch, and both halves of the next step are prefetched
+  const KeyType *base = keys_ + 1;
+  int n = GetSize() - 1;
+  if (n <= 0) {
+    return 0;
+  }
+  while (n > 1) {
+    int half = n / 2;
+    __builtin_prefetch(base + half / 2);
+    __builtin_prefetch(base + half + half / 2);
+    base = comparator(base[half], key) <= 0 ? base + half : base;
+    n -= half;
+  }
+  // base is the last key not greater than key, or KEY(1) if every key is greater
+  int index = static_cast<int>(base - keys_);
+  return comparator(*base, key) <= 0 ? index : index - 1;
 }
 
 /*****************************************************************************
@@ -110,9 +112,9 @@ ValueType B_PLUS_TREE_INTERNAL_PAGE_TYPE::Lookup(const KeyType &key, const KeyCo
 INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_INTERNAL_PAGE_TYPE::PopulateNewRoot(const ValueType &old_value, const KeyType &new_key,
                                                      const ValueType &new_value) {
-  array_[0].second = old_value;
-  array_[1].first = new_key;
-  array_[1].second = new_value;
+  Children()[0] = old_value;
+  keys_[1] = new_key;
+  Children()[1] = new_value;
   SetSize(2);
 }
 
@@ -126,12 +128,11 @@ int B_PLUS_TREE_INTERNAL_PAGE_TYPE::InsertNodeAfter(const ValueType &old_value,
                                                     const ValueType &new_value) {
   int size = GetSize();
   int old_location = ValueIndex(old_value);
-  for (int i = size - 1; i > old_location; i--) {
-    array_[i + 1].first = array_[i].first;
-    array_[i + 1].second = array_[i].second;
-  }
-  array_[old_location + 1].first = new_key;
-  array_[old_location + 1].second = new_value;
+  ValueType *children = Children();
+  std::copy_backward(keys_ + old_location + 1, keys_ + size, keys_ + size + 1);
+  std::copy_backward(children + old_location + 1, children + size, children + size + 1);
+  keys_[old_location + 1] = new_key;
+  children[old_location + 1] = new_value;
   IncreaseSize(1);
   return GetSize();
 }
@@ -150,17 +151,30 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveHalfTo(BPlusTreeInternalPage *recipient
   // assert(size == GetMaxSize() + 1);
   int start = GetMaxSize() / 2;
   int length = size - start;
-  recipient->CopyNFrom(array_ + GetMaxSize() / 2, length, buffer_pool_manager);
+  recipient->CopyNFrom(keys_ + start, Children() + start, length, buffer_pool_manager);
   SetSize(GetMinSize());
 }
 
+/*
+ * Uneven split used on the right edge of the tree, the key of the first moved
+ * entry becomes the separator pushed up to the parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveTailTo(BPlusTreeInternalPage *recipient, int start,
+                                                BufferPoolManager *buffer_pool_manager) {
+  recipient->CopyNFrom(keys_ + start, Children() + start, GetSize() - start, buffer_pool_manager);
+  SetSize(start);
+}
+
 /* Copy entries into me, starting from {items} and copy {size} entries.
  * Since it is an internal page, for all entries (pages) moved, their parents page now changes to me.
  * So I need to 'adopt' them by changing their parent page id, which needs to be persisted with BufferPoolManger
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_INTERNAL_PAGE_TYPE::CopyNFrom(MappingType *items, int size, BufferPoolManager *buffer_pool_manager) {
-  std::copy(items, items + size, array_ + GetSize());
+void B_PLUS_TREE_INTERNAL_PAGE_TYPE::CopyNFrom(const KeyType *keys, const ValueType *children, int size,
+                                               BufferPoolManager *buffer_pool_manager) {
+  std::copy(keys, keys + size, keys_ + GetSize());
+  std::copy(children, children + size, Children() + GetSize());
   for (int i = GetSize(); i < GetSize() + size; i++) {
     Page *child_page = buffer_pool_manager->FetchPage(ValueAt(i));
     BPlusTreePage *child_node = reinterpret_cast<BPlusTreePage *>(child_page->GetData());
@@ -182,7 +196,9 @@ INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Remove(int index) {
   int size = GetSize();
   if (index >= 0 && index < size) {
-    for (int i = index + 1; i < size; i++) array_[i - 1] = array_[i];
+    ValueType *children = Children();
+    std::copy(keys_ + index + 1, keys_ + size, keys_ + index);
+    std::copy(children + index + 1, children + size, children + index);
     IncreaseSize(-1);
   }
 }
@@ -193,7 +209,6 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::Remove(int index) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 ValueType B_PLUS_TREE_INTERNAL_PAGE_TYPE::RemoveAndReturnOnlyChild() {
-  // replace with your own code
   SetSize(0);
   return ValueAt(0);
 }
@@ -214,7 +229,7 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveAllTo(BPlusTreeInternalPage *recipient,
   int size = GetSize();
   // assert(GetSize() + recipient->GetSize() <= GetMaxSize());
   SetKeyAt(0, middle_key);
-  recipient->CopyNFrom(array_, size, buffer_pool_manager);
+  recipient->CopyNFrom(keys_, Children(), size, buffer_pool_manager);
   SetSize(0);
 }
 
@@ -233,7 +248,7 @@ INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key,
                                                       BufferPoolManager *buffer_pool_manager) {
   SetKeyAt(0, middle_key);
-  recipient->CopyLastFrom(array_[0], buffer_pool_manager);
+  recipient->CopyLastFrom({KeyAt(0), ValueAt(0)}, buffer_pool_manager);
   Remove(0);
   Page *parent = buffer_pool_manager->FetchPage(GetParentPageId());
   B_PLUS_TREE_INTERNAL_PAGE_TYPE *p = reinterpret_cast<B_PLUS_TREE_INTERNAL_PAGE_TYPE *>(parent);
@@ -249,7 +264,8 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeInternalPage *rec
 INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_INTERNAL_PAGE_TYPE::CopyLastFrom(const MappingType &pair, BufferPoolManager *buffer_pool_manager) {
   int size = GetSize();
-  array_[size] = pair;
+  keys_[size] = pair.first;
+  Children()[size] = pair.second;
   Page *page = buffer_pool_manager->FetchPage(ValueAt(size));
   BPlusTreePage *datapage = reinterpret_cast<BPlusTreePage *>(page->GetData());
   datapage->SetParentPageId(GetPageId());
@@ -269,7 +285,7 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeInternalPage *re
                                                        BufferPoolManager *buffer_pool_manager) {
   int size = GetSize();
   recipient->SetKeyAt(0, middle_key);
-  recipient->CopyFirstFrom(array_[size - 1], buffer_pool_manager);
+  recipient->CopyFirstFrom({KeyAt(size - 1), ValueAt(size - 1)}, buffer_pool_manager);
   IncreaseSize(-1);
 }
 
@@ -280,10 +296,11 @@ void B_PLUS_TREE_INTERNAL_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeInternalPage *re
 INDEX_TEMPLATE_ARGUMENTS
 void B_PLUS_TREE_INTERNAL_PAGE_TYPE::CopyFirstFrom(const MappingType &pair, BufferPoolManager *buffer_pool_manager) {
   int size = GetSize();
-  for (int i = size; i > 0; i--) {
-    array_[i] = array_[i - 1];
-  }
-  array_[0] = pair;
+  ValueType *children = Children();
+  std::copy_backward(keys_, keys_ + size, keys_ + size + 1);
+  std::copy_backward(children, children + size, children + size + 1);
+  keys_[0] = pair.first;
+  children[0] = pair.second;
   Page *page = buffer_pool_manager->FetchPage(ValueAt(0));
   BPlusTreePage *datapage = reinterpret_cast<BPlusTreePage *>(page->GetData());
   datapage->SetParentPageId(GetPageId());
@@ -306,4 +323,10 @@ template class BPlusTreeInternalPage<GenericKey<16>, page_id_t, GenericComparato
 
 template class BPlusTreeInternalPage<GenericKey<32>, page_id_t, GenericComparator<32>>;
 
-template class BPlusTreeInternalPage<GenericKey<64>, page_id_t, GenericComparator<64>>;
\ No newline at end of file
+template class BPlusTreeInternalPage<GenericKey<64>, page_id_t, GenericComparator<64>>;
+
+template class BPlusTreeInternalPage<GenericKey<128>, page_id_t, GenericComparator<128>>;
+
+template class BPlusTreeInternalPage<GenericKey<256>, page_id_t, GenericComparator<256>>;
+
+template class BPlusTreeInternalPage<GenericKey<512>, page_id_t, GenericComparator<512>>;
\ No newline at end of file
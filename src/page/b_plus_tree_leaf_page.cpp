@@ -108,6 +108,16 @@ void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveHalfTo(BPlusTreeLeafPage *recipient) {
   SetSize(start);
 }
 
+/*
+ * Uneven split used on the right edge of the tree, where the entries before
+ * start stay and only the tail moves to the new right sibling.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveTailTo(BPlusTreeLeafPage *recipient, int start) {
+  recipient->CopyNFrom(array_ + start, GetSize() - start);
+  SetSize(start);
+}
+
 /*
  * Copy starting from items, and copy {size} number of elements into me.
  */
@@ -231,7 +241,6 @@ void B_PLUS_TREE_LEAF_PAGE_TYPE::CopyFirstFrom(const MappingType &item, BufferPo
   int index = parent_id->ValueIndex(GetPageId());
   parent_id->SetKeyAt(index, array_[0].first);
   buffer_pool_manager->UnpinPage(GetParentPageId(), true);
-  buffer_pool_manager->UnpinPage(GetPageId(), true);
 }
 
 template class BPlusTreeLeafPage<int, int, BasicComparator<int>>;
@@ -244,4 +253,10 @@ template class BPlusTreeLeafPage<GenericKey<16>, RowId, GenericComparator<16>>;
 
 template class BPlusTreeLeafPage<GenericKey<32>, RowId, GenericComparator<32>>;
 
-template class BPlusTreeLeafPage<GenericKey<64>, RowId, GenericComparator<64>>;
\ No newline at end of file
+template class BPlusTreeLeafPage<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class BPlusTreeLeafPage<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class BPlusTreeLeafPage<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class BPlusTreeLeafPage<GenericKey<512>, RowId, GenericComparator<512>>;
\ No newline at end of file
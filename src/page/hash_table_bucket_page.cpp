@@ -0,0 +1,79 @@
+#include "page/hash_table_bucket_page.h"
+#include "index/basic_comparator.h"
+#include "index/generic_key.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+void HASH_TABLE_BUCKET_TYPE::Init(page_id_t page_id) {
+  page_id_ = page_id;
+  size_ = 0;
+  next_page_id_ = INVALID_PAGE_ID;
+}
+
+/*
+ * Helper method to find the slot holding key, -1 if the key is not in this bucket
+ */
+INDEX_TEMPLATE_ARGUMENTS
+int HASH_TABLE_BUCKET_TYPE::KeyIndex(const KeyType &key, const KeyComparator &comparator) const {
+  for (int i = 0; i < size_; i++) {
+    if (comparator(array_[i].first, key) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool HASH_TABLE_BUCKET_TYPE::Lookup(const KeyType &key, ValueType &value, const KeyComparator &comparator) const {
+  int index = KeyIndex(key, comparator);
+  if (index == -1) {
+    return false;
+  }
+  value = array_[index].second;
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool HASH_TABLE_BUCKET_TYPE::Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator) {
+  if (IsFull() || KeyIndex(key, comparator) != -1) {
+    return false;
+  }
+  array_[size_].first = key;
+  array_[size_].second = value;
+  size_++;
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool HASH_TABLE_BUCKET_TYPE::Remove(const KeyType &key, const KeyComparator &comparator) {
+  int index = KeyIndex(key, comparator);
+  if (index == -1) {
+    return false;
+  }
+  RemoveAt(index);
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void HASH_TABLE_BUCKET_TYPE::RemoveAt(int index) {
+  ASSERT(index >= 0 && index < size_, "bucket index out of range");
+  array_[index] = array_[size_ - 1];
+  size_--;
+}
+
+template class HashTableBucketPage<int, int, BasicComparator<int>>;
+
+template class HashTableBucketPage<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class HashTableBucketPage<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class HashTableBucketPage<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class HashTableBucketPage<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class HashTableBucketPage<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class HashTableBucketPage<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class HashTableBucketPage<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class HashTableBucketPage<GenericKey<512>, RowId, GenericComparator<512>>;
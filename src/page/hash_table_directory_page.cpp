@@ -0,0 +1,56 @@
+#include "page/hash_table_directory_page.h"
+
+static_assert(sizeof(HashTableDirectoryPage) <= PAGE_SIZE, "directory page exceeds page size");
+
+void HashTableDirectoryPage::Init(page_id_t page_id) {
+  page_id_ = page_id;
+  global_depth_ = 0;
+  for (uint32_t i = 0; i < DIRECTORY_ARRAY_SIZE; i++) {
+    local_depths_[i] = 0;
+    bucket_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
+
+bool HashTableDirectoryPage::IncrGlobalDepth() {
+  if (global_depth_ >= DIRECTORY_MAX_DEPTH) {
+    return false;
+  }
+  uint32_t size = Size();
+  for (uint32_t i = 0; i < size; i++) {
+    local_depths_[i + size] = local_depths_[i];
+    bucket_page_ids_[i + size] = bucket_page_ids_[i];
+  }
+  global_depth_++;
+  return true;
+}
+
+void HashTableDirectoryPage::DecrGlobalDepth() {
+  ASSERT(global_depth_ > 0, "cannot shrink a directory of depth 0");
+  global_depth_--;
+  uint32_t size = Size();
+  for (uint32_t i = size; i < size * 2; i++) {
+    local_depths_[i] = 0;
+    bucket_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
+
+bool HashTableDirectoryPage::CanShrink() const {
+  if (global_depth_ == 0) {
+    return false;
+  }
+  uint32_t size = Size();
+  for (uint32_t i = 0; i < size; i++) {
+    if (local_depths_[i] >= global_depth_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t HashTableDirectoryPage::GetSplitImageIndex(uint32_t bucket_idx) const {
+  uint32_t local_depth = local_depths_[bucket_idx];
+  if (local_depth == 0) {
+    return bucket_idx;
+  }
+  return bucket_idx ^ (1U << (local_depth - 1));
+}
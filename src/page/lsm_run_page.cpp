@@ -0,0 +1,55 @@
+#include "page/lsm_run_page.h"
+#include "index/basic_comparator.h"
+#include "index/generic_key.h"
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_RUN_PAGE_TYPE::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  size_ = 0;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void LSM_RUN_PAGE_TYPE::Append(const MappingType &item) {
+  ASSERT(!IsFull(), "Append to a full run page.");
+  array_[size_++] = item;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+int LSM_RUN_PAGE_TYPE::KeyIndex(const KeyType &key, const KeyComparator &comparator) const {
+  int st = 0, ed = size_;
+  while (st < ed) {
+    int mid = (ed - st) / 2 + st;
+    if (comparator(array_[mid].first, key) < 0) {
+      st = mid + 1;
+    } else {
+      ed = mid;
+    }
+  }
+  return st;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool LSM_RUN_PAGE_TYPE::Lookup(const KeyType &key, ValueType &value, const KeyComparator &comparator) const {
+  int index = KeyIndex(key, comparator);
+  if (index < size_ && comparator(array_[index].first, key) == 0) {
+    value = array_[index].second;
+    return true;
+  }
+  return false;
+}
+
+template class LSMRunPage<GenericKey<4>, RowId, GenericComparator<4>>;
+
+template class LSMRunPage<GenericKey<8>, RowId, GenericComparator<8>>;
+
+template class LSMRunPage<GenericKey<16>, RowId, GenericComparator<16>>;
+
+template class LSMRunPage<GenericKey<32>, RowId, GenericComparator<32>>;
+
+template class LSMRunPage<GenericKey<64>, RowId, GenericComparator<64>>;
+
+template class LSMRunPage<GenericKey<128>, RowId, GenericComparator<128>>;
+
+template class LSMRunPage<GenericKey<256>, RowId, GenericComparator<256>>;
+
+template class LSMRunPage<GenericKey<512>, RowId, GenericComparator<512>>;
@@ -0,0 +1,150 @@
+#include "page/prefix_b_plus_tree_page.h"
+#include <algorithm>
+#include "common/macros.h"
+
+void PrefixBPlusTreePage::Init(bool is_leaf) {
+  is_leaf_ = is_leaf;
+  size_ = 0;
+  prefix_length_ = 0;
+  data_begin_ = PAGE_SIZE;
+  next_page_id_ = INVALID_PAGE_ID;
+}
+
+std::string PrefixBPlusTreePage::KeyAt(int index) const {
+  if (!IsLeafPage() && index == 0) {
+    return "";
+  }
+  std::string key(Prefix(), prefix_length_);
+  key.append(SuffixAt(index), SuffixLengthAt(index));
+  return key;
+}
+
+RowId PrefixBPlusTreePage::RowIdAt(int index) const {
+  int64_t value;
+  memcpy(&value, ValueAt(index), sizeof(value));
+  return RowId(value);
+}
+
+page_id_t PrefixBPlusTreePage::ChildAt(int index) const {
+  page_id_t value;
+  memcpy(&value, ValueAt(index), sizeof(value));
+  return value;
+}
+
+// 先与页内共同前缀比较一次，之后的二分查找只比较各个键的后缀
+int PrefixBPlusTreePage::Search(const std::string &key, int first, bool upper) const {
+  size_t length = std::min<size_t>(prefix_length_, key.size());
+  int cmp = memcmp(Prefix(), key.data(), length);
+  if (cmp < 0) {
+    return size_;
+  }
+  if (cmp > 0 || key.size() < prefix_length_) {
+    return first;
+  }
+  const char *rest = key.data() + prefix_length_;
+  size_t rest_length = key.size() - prefix_length_;
+  int st = first, ed = size_;
+  while (st < ed) {
+    int mid = (ed - st) / 2 + st;
+    uint32_t suffix_length = SuffixLengthAt(mid);
+    cmp = memcmp(SuffixAt(mid), rest, std::min<size_t>(suffix_length, rest_length));
+    if (cmp == 0) {
+      cmp = suffix_length < rest_length ? -1 : suffix_length > rest_length;
+    }
+    if (upper ? cmp <= 0 : cmp < 0) {
+      st = mid + 1;
+    } else {
+      ed = mid;
+    }
+  }
+  return st;
+}
+
+int PrefixBPlusTreePage::LowerBound(const std::string &key) const { return Search(key, 0, false); }
+
+int PrefixBPlusTreePage::ChildIndex(const std::string &key) const {
+  ASSERT(!IsLeafPage(), "Child index of a leaf page.");
+  return Search(key, 1, true) - 1;
+}
+
+int PrefixBPlusTreePage::CompareAt(int index, const std::string &key) const {
+  size_t length = std::min<size_t>(prefix_length_, key.size());
+  int cmp = memcmp(Prefix(), key.data(), length);
+  if (cmp != 0) {
+    return cmp;
+  }
+  if (key.size() < prefix_length_) {
+    return 1;
+  }
+  uint32_t suffix_length = SuffixLengthAt(index);
+  size_t rest_length = key.size() - prefix_length_;
+  cmp = memcmp(SuffixAt(index), key.data() + prefix_length_, std::min<size_t>(suffix_length, rest_length));
+  if (cmp != 0) {
+    return cmp;
+  }
+  return suffix_length < rest_length ? -1 : suffix_length > rest_length;
+}
+
+void PrefixBPlusTreePage::ReadEntries(std::vector<PrefixBPlusTreeEntry> &entries) const {
+  entries.clear();
+  entries.reserve(size_ + 1);
+  for (int i = 0; i < size_; i++) {
+    entries.push_back({KeyAt(i), IsLeafPage() ? RowIdAt(i).Get() : ChildAt(i)});
+  }
+}
+
+uint32_t PrefixBPlusTreePage::CommonPrefixLength(const std::string &a, const std::string &b) {
+  size_t length = std::min(a.size(), b.size());
+  size_t i = 0;
+  while (i < length && a[i] == b[i]) {
+    i++;
+  }
+  return i;
+}
+
+/*
+ * The keys are sorted, so the prefix shared by a range of them is the one of
+ * its first and last key.
+ */
+uint32_t PrefixBPlusTreePage::GetPageSize(const std::vector<PrefixBPlusTreeEntry> &entries, int begin, int end,
+                                          bool is_leaf) {
+  int first_keyed = is_leaf ? begin : begin + 1;
+  uint32_t prefix_length = first_keyed < end ? CommonPrefixLength(entries[first_keyed].key, entries[end - 1].key) : 0;
+  uint32_t value_size = is_leaf ? sizeof(int64_t) : sizeof(page_id_t);
+  uint32_t size = PREFIX_B_PLUS_TREE_PAGE_HEADER_SIZE + prefix_length +
+                  (end - begin) * (PREFIX_B_PLUS_TREE_SLOT_SIZE + value_size);
+  for (int i = first_keyed; i < end; i++) {
+    size += entries[i].key.size() - prefix_length;
+  }
+  return size;
+}
+
+bool PrefixBPlusTreePage::WriteEntries(const std::vector<PrefixBPlusTreeEntry> &entries) {
+  int count = static_cast<int>(entries.size());
+  if (GetPageSize(entries, 0, count, IsLeafPage()) > PAGE_SIZE) {
+    return false;
+  }
+  int first_keyed = IsLeafPage() ? 0 : 1;
+  prefix_length_ = first_keyed < count ? CommonPrefixLength(entries[first_keyed].key, entries[count - 1].key) : 0;
+  if (prefix_length_ > 0) {
+    memcpy(data_, entries[first_keyed].key.data(), prefix_length_);
+  }
+  size_ = count;
+  data_begin_ = PAGE_SIZE;
+  uint32_t value_size = IsLeafPage() ? sizeof(int64_t) : sizeof(page_id_t);
+  char *page = reinterpret_cast<char *>(this);
+  for (int i = 0; i < count; i++) {
+    uint16_t suffix_length = i < first_keyed ? 0 : entries[i].key.size() - prefix_length_;
+    data_begin_ -= suffix_length + value_size;
+    memcpy(page + data_begin_, entries[i].key.data() + (i < first_keyed ? 0 : prefix_length_), suffix_length);
+    if (IsLeafPage()) {
+      memcpy(page + data_begin_ + suffix_length, &entries[i].value, sizeof(int64_t));
+    } else {
+      auto child = static_cast<page_id_t>(entries[i].value);
+      memcpy(page + data_begin_ + suffix_length, &child, sizeof(child));
+    }
+    uint16_t slot[2] = {data_begin_, suffix_length};
+    memcpy(data_ + prefix_length_ + i * PREFIX_B_PLUS_TREE_SLOT_SIZE, slot, sizeof(slot));
+  }
+  return true;
+}
@@ -1182,13 +1182,26 @@ YY_DECL {
 #line 208 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
+        /* keywords matched here, rules of their own would change the generated tables */
+        if (strcmp(yytext, "analyze") == 0) {
+          return ANALYZE;
+        }
+        if (strcmp(yytext, "join") == 0) {
+          return JOIN;
+        }
+        if (strcmp(yytext, "group") == 0) {
+          return GROUP;
+        }
+        if (strcmp(yytext, "by") == 0) {
+          return BY;
+        }
         yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
         return IDENTIFIER;
       }
         YY_BREAK
       case 40:
         YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 227 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
@@ -1197,7 +1210,7 @@ YY_DECL {
         YY_BREAK
       case 41:
         YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 233 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
@@ -1206,7 +1219,7 @@ YY_DECL {
         YY_BREAK
       case 42:
         YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 239 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return EQ;
@@ -1214,7 +1227,7 @@ YY_DECL {
         YY_BREAK
       case 43:
         YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 244 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return NE;
@@ -1222,7 +1235,7 @@ YY_DECL {
         YY_BREAK
       case 44:
         YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 249 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return LE;
@@ -1230,7 +1243,7 @@ YY_DECL {
         YY_BREAK
       case 45:
         YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 254 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return GE;
@@ -1238,7 +1251,7 @@ YY_DECL {
         YY_BREAK
       case 46:
         YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 259 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return (',');
@@ -1246,7 +1259,7 @@ YY_DECL {
         YY_BREAK
       case 47:
         YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 264 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return ('*');
@@ -1254,7 +1267,7 @@ YY_DECL {
         YY_BREAK
       case 48:
         YY_RULE_SETUP
-#line 256 "minisql.l"
+#line 269 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return (';');
@@ -1262,7 +1275,7 @@ YY_DECL {
         YY_BREAK
       case 49:
         YY_RULE_SETUP
-#line 261 "minisql.l"
+#line 274 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return ('\'');
@@ -1270,7 +1283,7 @@ YY_DECL {
         YY_BREAK
       case 50:
         YY_RULE_SETUP
-#line 266 "minisql.l"
+#line 279 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return ('<');
@@ -1278,7 +1291,7 @@ YY_DECL {
         YY_BREAK
       case 51:
         YY_RULE_SETUP
-#line 271 "minisql.l"
+#line 284 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return ('>');
@@ -1286,7 +1299,7 @@ YY_DECL {
         YY_BREAK
       case 52:
         YY_RULE_SETUP
-#line 276 "minisql.l"
+#line 289 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return ('(');
@@ -1294,7 +1307,7 @@ YY_DECL {
         YY_BREAK
       case 53:
         YY_RULE_SETUP
-#line 281 "minisql.l"
+#line 294 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
         return (')');
@@ -1303,15 +1316,19 @@ YY_DECL {
       case 54:
 /* rule 54 can match eol */
         YY_RULE_SETUP
-#line 286 "minisql.l"
+#line 299 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
       }
         YY_BREAK
       case 55:
         YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 303 "minisql.l"
       {
+        if (yytext[0] == '.') {
+          MinisqlParserMovePos(yylineno, yytext);
+          return ('.');
+        }
         char str[128] = {0};
         sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
         MinisqlParserSetError(str);
@@ -1319,7 +1336,7 @@ YY_DECL {
         YY_BREAK
       case 56:
         YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 313 "minisql.l"
         ECHO;
         YY_BREAK
 #line 1314 "../../parser/minisql_lex.c"
@@ -2258,7 +2275,7 @@ void yyfree(void *ptr) {
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 313 "minisql.l"
 
 
 int yywrap() {
@@ -2,6 +2,7 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "glog/logging.h"
@@ -105,6 +106,28 @@ void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
   }
 }
 
+void DiskManager::DeAllocatePages(std::vector<page_id_t> logical_page_ids) {
+  // 按页号排序，同一个块中的页连续处理，每个块只查找一次位图
+  std::sort(logical_page_ids.begin(), logical_page_ids.end());
+  size_t i = 0;
+  while (i < logical_page_ids.size()) {
+    ASSERT(logical_page_ids[i] >= 0, "logical page id cannot be less than 0");
+    uint32_t extent_id = logical_page_ids[i] / BITMAP_SIZE;
+    auto bitmap = GetBitMapPage(logical_page_ids[i]);
+    uint32_t freed = 0;
+    for (; i < logical_page_ids.size() && logical_page_ids[i] / BITMAP_SIZE == extent_id; i++) {
+      if (bitmap->DeAllocatePage(logical_page_ids[i] % BITMAP_SIZE)) {
+        freed++;
+      }
+    }
+    meta->num_allocated_pages_ -= freed;
+    meta->extent_used_page_[extent_id] -= freed;
+    if (freed != 0 && tailBitMap > static_cast<int>(extent_id)) {
+      tailBitMap = extent_id;
+    }
+  }
+}
+
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
   ASSERT(logical_page_id >= 0, "logical_page_id cannot be less than 0");
   return GetBitMapPage(logical_page_id)->IsPageFree(logical_page_id % BITMAP_SIZE);
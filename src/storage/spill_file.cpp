@@ -0,0 +1,135 @@
+#include "storage/spill_file.h"
+#include <algorithm>
+
+SpillFile::~SpillFile() {
+  for (auto page_id : pages_) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+}
+
+bool SpillFile::Append(const char *data, uint32_t size) {
+  while (size > 0) {
+    uint32_t offset = size_ % PAGE_SIZE;
+    Page *page;
+    if (offset == 0) {
+      // 当前页已写满，取一个新页
+      page_id_t page_id;
+      page = buffer_pool_manager_->NewPage(page_id);
+      if (page == nullptr) {
+        return false;
+      }
+      pages_.push_back(page_id);
+    } else {
+      page = buffer_pool_manager_->FetchPage(pages_.back());
+      if (page == nullptr) {
+        return false;
+      }
+    }
+    uint32_t len = std::min(size, PAGE_SIZE - offset);
+    memcpy(page->GetData() + offset, data, len);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    data += len;
+    size -= len;
+    size_ += len;
+  }
+  return true;
+}
+
+bool SpillFile::Read(char *data, uint32_t size) {
+  if (read_pos_ + size > size_) {
+    return false;
+  }
+  while (size > 0) {
+    uint32_t offset = read_pos_ % PAGE_SIZE;
+    Page *page = buffer_pool_manager_->FetchPage(pages_[read_pos_ / PAGE_SIZE]);
+    if (page == nullptr) {
+      return false;
+    }
+    uint32_t len = std::min(size, PAGE_SIZE - offset);
+    memcpy(data, page->GetData() + offset, len);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    data += len;
+    size -= len;
+    read_pos_ += len;
+  }
+  return true;
+}
+
+/*
+ * A row is its field count, then for each field its type, whether it is null
+ * and, if not, its value: an int32 or a float, or the length and the bytes of
+ * a char.
+ */
+bool SpillFile::AppendRow(const Row &row) {
+  std::vector<char> buf(sizeof(uint32_t));
+  uint32_t count = row.GetFieldCount();
+  MACH_WRITE_UINT32(buf.data(), count);
+  for (uint32_t i = 0; i < count; i++) {
+    const Field *field = row.GetField(i);
+    TypeId type = field->GetType();
+    buf.push_back(static_cast<char>(type));
+    buf.push_back(field->IsNull());
+    if (field->IsNull()) {
+      continue;
+    }
+    size_t pos = buf.size();
+    if (type == kTypeChar) {
+      uint32_t len = field->GetCharLength();
+      buf.resize(pos + sizeof(uint32_t) + len);
+      MACH_WRITE_UINT32(buf.data() + pos, len);
+      memcpy(buf.data() + pos + sizeof(uint32_t), field->GetData(), len);
+    } else if (type == kTypeInt) {
+      buf.resize(pos + sizeof(int32_t));
+      MACH_WRITE_INT32(buf.data() + pos, field->GetIntData());
+    } else {
+      buf.resize(pos + sizeof(float));
+      MACH_WRITE_TO(float, buf.data() + pos, field->GetFloatData());
+    }
+  }
+  return Append(buf.data(), buf.size());
+}
+
+bool SpillFile::ReadRow(std::vector<Field> &fields) {
+  fields.clear();
+  uint32_t count;
+  if (!Read(reinterpret_cast<char *>(&count), sizeof(count))) {
+    return false;
+  }
+  fields.reserve(count);
+  std::vector<char> chars;
+  for (uint32_t i = 0; i < count; i++) {
+    char header[2];
+    if (!Read(header, sizeof(header))) {
+      return false;
+    }
+    auto type = static_cast<TypeId>(header[0]);
+    if (header[1]) {
+      fields.emplace_back(type);
+      continue;
+    }
+    if (type == kTypeChar) {
+      uint32_t len;
+      if (!Read(reinterpret_cast<char *>(&len), sizeof(len))) {
+        return false;
+      }
+      chars.resize(len);
+      if (!Read(chars.data(), len)) {
+        return false;
+      }
+      fields.emplace_back(kTypeChar, chars.data(), len, true);
+    } else if (type == kTypeInt) {
+      int32_t value;
+      if (!Read(reinterpret_cast<char *>(&value), sizeof(value))) {
+        return false;
+      }
+      fields.emplace_back(kTypeInt, value);
+    } else {
+      float value;
+      if (!Read(reinterpret_cast<char *>(&value), sizeof(value))) {
+        return false;
+      }
+      fields.emplace_back(kTypeFloat, value);
+    }
+  }
+  return true;
+}
@@ -24,12 +24,14 @@ bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
         buffer_pool_manager_->UnpinPage(next_page_id, true);
         last_page_id = next_page_id;
         total_page++;
+        page_count_++;
       } else {
         buffer_pool_manager_->UnpinPage(next_page_id, true);
         buffer_pool_manager_->UnpinPage(last_page_id, false);
         return false;
       }
     }
+    tuple_count_++;
     return true;
   }
 
@@ -62,6 +64,7 @@ bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
         inserted_page_id = next_page_id;
         last_page_id = next_page_id;
         total_page = index;
+        page_count_++;
       } else {
         buffer_pool_manager_->UnpinPage(inserted_page_id, false);
         return false;
@@ -74,6 +77,7 @@ bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
       inserted_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
     }
   }
+  tuple_count_++;
   return buffer_pool_manager_->UnpinPage(inserted_page_id, true);
 }
 
@@ -120,6 +124,9 @@ void TableHeap::ApplyDelete(const RowId &rid, Transaction *txn) {
   // Step2: Delete the tuple from the page.
   page_to_delete->ApplyDelete(rid, txn, log_manager_);
   buffer_pool_manager_->UnpinPage(page_id, true);
+  if (tuple_count_ > 0) {
+    tuple_count_--;
+  }
 }
 
 void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
@@ -133,8 +140,20 @@ void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
   buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
 }
 
-// TODO
-void TableHeap::FreeHeap() {}
+void TableHeap::FreeHeap() {
+  // 沿着页链收集所有页，一次性删除
+  std::vector<page_id_t> pages;
+  page_id_t cur_page_id = first_page_id_;
+  while (cur_page_id != INVALID_PAGE_ID) {
+    pages.push_back(cur_page_id);
+    auto cur_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(cur_page_id));
+    page_id_t next_page_id = cur_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(cur_page_id, false);
+    cur_page_id = next_page_id;
+  }
+  buffer_pool_manager_->DeletePages(pages);
+  first_page_id_ = INVALID_PAGE_ID;
+}
 
 bool TableHeap::GetTuple(Row *row, Transaction *txn) {
   auto page_id = row->GetRowId().GetPageId();
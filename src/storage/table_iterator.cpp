@@ -8,6 +8,7 @@ TableIterator::TableIterator(const TableIterator &other) {
   row_ = other.row_;
   owner_heap_ = other.owner_heap_;
   rid.Set(row_->GetRowId().GetPageId(), row_->GetRowId().GetSlotNum());
+  frame_ = other.frame_;
 }
 
 TableIterator::~TableIterator() {
@@ -39,7 +40,8 @@ TableIterator &TableIterator::operator++() {
   ASSERT(row_ != nullptr, "[ ERROR ] - cannot do ++ operation on a null iterator");
   page_id_t page_id = rid.GetPageId();
   ASSERT(page_id != INVALID_PAGE_ID, "[ ERROR ] - cannot do ++ operation on end iterator");
-  TablePage *page = reinterpret_cast<TablePage *>(owner_heap_->buffer_pool_manager_->FetchPage(page_id));
+  BufferPoolManager *bpm = owner_heap_->buffer_pool_manager_;
+  TablePage *page = reinterpret_cast<TablePage *>(bpm->FetchPage(page_id, frame_));
   ASSERT(page_id == page->GetPageId(), "[ ERROR ] - page_id == page->GetPageId() should be true");
   RowId nextid;
   // 搜索下一个可用的页面
@@ -47,27 +49,30 @@ TableIterator &TableIterator::operator++() {
     //找到了
     rid.Set(nextid.GetPageId(), nextid.GetSlotNum());
     row_->SetRowId(rid);
-    owner_heap_->GetTuple(row_, nullptr);
-    owner_heap_->buffer_pool_manager_->UnpinPage(page_id, false);
+    // 元组就在已经pin住的页上，不必再通过GetTuple获取一次页面
+    page->GetTuple(row_, owner_heap_->schema_, nullptr, owner_heap_->lock_manager_);
+    bpm->UnpinPage(page_id, false);
     return *this;
   }
   page_id_t next_page_id = INVALID_PAGE_ID;
   while ((next_page_id = page->GetNextPageId()) != INVALID_PAGE_ID) {
-    TablePage *next_page = reinterpret_cast<TablePage *>(owner_heap_->buffer_pool_manager_->FetchPage(next_page_id));
-    owner_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    // 下一页的帧记录在当前页的引用槽中
+    frame_ = bpm->FetchPage(next_page_id, reinterpret_cast<Page *>(page)->SwizzleSlot(0));
+    TablePage *next_page = reinterpret_cast<TablePage *>(frame_);
+    bpm->UnpinPage(page->GetPageId(), false);
     page = next_page;
     if (page->GetFirstTupleRid(&nextid)) {
       rid = nextid;
       row_->SetRowId(nextid);
-      owner_heap_->GetTuple(row_, nullptr);
-      owner_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      page->GetTuple(row_, owner_heap_->schema_, nullptr, owner_heap_->lock_manager_);
+      bpm->UnpinPage(page->GetPageId(), false);
       return *this;
     }
   }
   // 到这里，说明咩有元组了
   rid.Set(INVALID_PAGE_ID, 0);
   //  row_ = nullptr;
-  owner_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  bpm->UnpinPage(page->GetPageId(), false);
   return *this;
 }
 
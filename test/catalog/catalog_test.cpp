@@ -141,4 +141,93 @@ TEST(CatalogTest, CatalogIndexTest) {
   ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_02->GetTable("table-1", table_info));
 
   delete db_02;
-}
\ No newline at end of file
+}
+TEST(CatalogTest, CatalogIndexKeySizeTest) {
+  SimpleMemHeap heap;
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  TableInfo *table_info = nullptr;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, true),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 16, 1, true, true),
+                                   ALLOC_COLUMN(heap)("comment", TypeId::kTypeChar, 64, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Transaction txn;
+  catalog_01->CreateTable("table-1", schema.get(), &txn, table_info);
+  IndexInfo *index_info = nullptr;
+  // the narrowest key holding the widest value of the key columns is chosen,
+  // unique columns are indexed when the table is created
+  ASSERT_EQ(DB_SUCCESS, catalog_01->GetIndex("table-1", "table-1__unique__0", index_info));
+  ASSERT_EQ(16, index_info->GetKeySize());
+  ASSERT_EQ(DB_SUCCESS, catalog_01->GetIndex("table-1", "table-1__unique__1", index_info));
+  ASSERT_EQ(32, index_info->GetKeySize());
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-comment", {"id", "comment"}, &txn, index_info));
+  ASSERT_EQ(128, index_info->GetKeySize());
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, catalog_01->GetIndex("table-1", "table-1__unique__0", index_info));
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(row, RowId(1000, i), nullptr));
+  }
+  delete db_01;
+  // the key size is persisted with the index metadata
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "table-1__unique__0", index_info));
+  ASSERT_EQ(16, index_info->GetKeySize());
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    std::vector<RowId> ret;
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(row, ret, &txn));
+    ASSERT_EQ(RowId(1000, i).Get(), ret[0].Get());
+  }
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "table-1__unique__1", index_info));
+  ASSERT_EQ(32, index_info->GetKeySize());
+  delete db_02;
+}
+
+TEST(CatalogTest, CatalogLongKeyIndexTest) {
+  SimpleMemHeap heap;
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  TableInfo *table_info = nullptr;
+  Transaction txn;
+  // keys wider than the largest generic key are rejected up front
+  std::vector<Column *> bad_columns = {ALLOC_COLUMN(heap)("url", TypeId::kTypeChar, 1000, 0, false, true)};
+  auto bad_schema = std::make_shared<Schema>(bad_columns);
+  ASSERT_EQ(DB_INDEX_KEY_TOO_LONG, catalog_01->CreateTable("table-0", bad_schema.get(), &txn, table_info));
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_01->GetTable("table-0", table_info));
+
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("url", TypeId::kTypeChar, 200, 0, false, true)};
+  auto schema = std::make_shared<Schema>(columns);
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->GetIndex("table-1", "table-1__unique__0", index_info));
+  ASSERT_EQ(256, index_info->GetKeySize());
+  // long keys sharing a prefix
+  const std::string prefix(180, 'x');
+  for (int i = 0; i < 200; i++) {
+    std::string url = prefix + std::to_string(i);
+    std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(url.c_str()), url.size(), true)};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(row, RowId(1000, i), nullptr));
+  }
+  for (int i = 0; i < 200; i++) {
+    std::string url = prefix + std::to_string(i);
+    std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(url.c_str()), url.size(), true)};
+    Row row(fields);
+    std::vector<RowId> ret;
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(row, ret, &txn));
+    ASSERT_EQ(1, ret.size());
+    ASSERT_EQ(RowId(1000, i).Get(), ret[0].Get());
+  }
+  // a value longer than any stored key is reported instead of overflowing the key
+  std::string too_long(300, 'y');
+  std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(too_long.c_str()), too_long.size(), true)};
+  Row row(fields);
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(row, ret, &txn));
+  ASSERT_TRUE(ret.empty());
+  ASSERT_EQ(DB_INDEX_KEY_TOO_LONG, index_info->GetIndex()->InsertEntry(row, RowId(1000, 300), nullptr));
+  delete db_01;
+}
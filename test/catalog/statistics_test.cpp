@@ -0,0 +1,115 @@
+#include "catalog/statistics.h"
+#include "common/instance.h"
+#include "executor/operators.h"
+#include "executor/planner.h"
+#include "gtest/gtest.h"
+#include "utils/utils.h"
+
+static string db_file_name = "statistics_test.db";
+
+TEST(StatisticsTest, AnalyzeTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 16, 1, true, false),
+                                   ALLOC_COLUMN(heap)("v", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  schema->getPrimaryKeys().push_back(0);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("t", schema.get(), nullptr, table_info));
+  std::vector<IndexInfo *> indexes;
+  catalog->GetTableIndexes("t", indexes);
+  // v is null in a tenth of the rows, 7 in half of them and spread over [0, 100) otherwise.
+  // name takes four values
+  const int n = 10000;
+  for (int i = 0; i < n; i++) {
+    std::string name = "name" + std::to_string(i % 4);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    if (i % 10 == 0) {
+      fields.emplace_back(TypeId::kTypeFloat);
+    } else {
+      fields.emplace_back(TypeId::kTypeFloat, i % 2 ? 7.0f : (i % 1000) / 10.0f);
+    }
+    InsertOperator insert(table_info, indexes, fields);
+    ASSERT_EQ(DB_SUCCESS, insert.Init());
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  ASSERT_EQ(nullptr, table_info->GetStatistics());
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog->AnalyzeTable("none"));
+  ASSERT_EQ(DB_SUCCESS, catalog->AnalyzeTable("t"));
+  TableStatistics *statistics = table_info->GetStatistics();
+  ASSERT_NE(nullptr, statistics);
+  ASSERT_EQ(static_cast<uint64_t>(n), statistics->row_count);
+  ASSERT_EQ(3u, statistics->columns.size());
+
+  // id: distinct, spread evenly over [0, n)
+  const ColumnStatistics &id = statistics->columns[0];
+  ASSERT_EQ(0, id.null_fraction);
+  ASSERT_TRUE(id.mcv_values.empty());
+  ASSERT_EQ(static_cast<size_t>(STATISTICS_BUCKET_COUNT + 1), id.bounds.size());
+  ASSERT_GT(id.distinct_count, n / 2);
+  ASSERT_NEAR(0.25, id.EstimateLess(Field(TypeId::kTypeInt, n / 4), false), 0.05);
+  ASSERT_EQ(0, id.EstimateLess(Field(TypeId::kTypeInt, -1), true));
+  ASSERT_EQ(1, id.EstimateLess(Field(TypeId::kTypeInt, n), true));
+
+  // name: every value is a most common one
+  const ColumnStatistics &name = statistics->columns[1];
+  ASSERT_EQ(4u, name.mcv_values.size());
+  ASSERT_TRUE(name.bounds.empty());
+  ASSERT_EQ(4, name.distinct_count);
+  ASSERT_NEAR(0.25, name.EstimateEqual(Field(TypeId::kTypeChar, const_cast<char *>("name2"), 5, true)), 0.05);
+  ASSERT_EQ(0, name.EstimateEqual(Field(TypeId::kTypeChar, const_cast<char *>("other"), 5, true)));
+
+  // v: nulls, one most common value and a histogram for the rest
+  const ColumnStatistics &v = statistics->columns[2];
+  ASSERT_NEAR(0.1, v.null_fraction, 0.03);
+  ASSERT_NEAR(0.5, v.EstimateEqual(Field(TypeId::kTypeFloat, 7.0f)), 0.05);
+  ASSERT_NEAR(0.7, v.EstimateLess(Field(TypeId::kTypeFloat, 50.0f), false), 0.05);
+  ASSERT_NEAR(0.02, v.EstimateLess(Field(TypeId::kTypeFloat, 5.0f), false), 0.02);
+
+  // the planner reads the statistics
+  ConditionList conditions;
+  conditions.compare.push_back(const_cast<char *>("="));
+  conditions.pairs.emplace_back("v", nullptr, kNodeNumber);
+  conditions.column_index.push_back(2);
+  conditions.to_be_compared.emplace_back(TypeId::kTypeFloat, 7.0f);
+  ASSERT_NEAR(0.5, Planner(table_info, indexes).EstimateSelectivity(conditions), 0.05);
+
+  // serialization keeps everything
+  char buf[PAGE_SIZE];
+  ASSERT_EQ(statistics->GetSerializedSize(), statistics->SerializeTo(buf));
+  std::unique_ptr<TableStatistics> other;
+  ASSERT_EQ(statistics->GetSerializedSize(), TableStatistics::DeserializeFrom(buf, other));
+  ASSERT_EQ(statistics->row_count, other->row_count);
+  ASSERT_EQ(statistics->page_count, other->page_count);
+  for (uint32_t i = 0; i < 3; i++) {
+    ASSERT_EQ(statistics->columns[i].type, other->columns[i].type);
+    ASSERT_EQ(statistics->columns[i].distinct_count, other->columns[i].distinct_count);
+    ASSERT_EQ(statistics->columns[i].mcv_fractions, other->columns[i].mcv_fractions);
+    ASSERT_EQ(statistics->columns[i].bounds.size(), other->columns[i].bounds.size());
+  }
+  ASSERT_EQ(name.mcv_values[0].text, other->columns[1].mcv_values[0].text);
+
+  // shrinking halves the histogram of the column keeping the most values first
+  other->ShrinkTo(other->GetSerializedSize() - 1);
+  ASSERT_EQ(static_cast<size_t>(STATISTICS_BUCKET_COUNT / 2 + 1), other->columns[2].bounds.size());
+  ASSERT_EQ(1u, other->columns[2].mcv_values.size());
+  ASSERT_EQ(static_cast<size_t>(STATISTICS_BUCKET_COUNT + 1), other->columns[0].bounds.size());
+  other->ShrinkTo(0);
+  ASSERT_TRUE(other->columns[2].mcv_values.empty() && other->columns[2].bounds.empty());
+  delete engine;
+
+  // the statistics are loaded with the catalog, and give the row count of the table
+  engine = new DBStorageEngine(db_file_name, false);
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->GetTable("t", table_info));
+  ASSERT_NE(nullptr, table_info->GetStatistics());
+  ASSERT_EQ(4u, table_info->GetStatistics()->columns[1].mcv_values.size());
+  engine->catalog_mgr_->GetTableIndexes("t", indexes);
+  Planner planner(table_info, indexes);
+  ASSERT_TRUE(planner.HasRowCount());
+  ASSERT_EQ(static_cast<uint64_t>(n), planner.GetRowCount());
+  delete engine;
+  remove(db_file_name.c_str());
+}
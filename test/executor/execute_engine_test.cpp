@@ -0,0 +1,180 @@
+#include "executor/execute_engine.h"
+#include "gtest/gtest.h"
+
+// parse and execute one statement, keeping what it prints
+static dberr_t RunSql(ExecuteEngine &engine, const char *sql, std::string *output = nullptr) {
+  YY_BUFFER_STATE bp = yy_scan_string(sql);
+  yy_switch_to_buffer(bp);
+  MinisqlParserInit();
+  yyparse();
+  EXPECT_FALSE(MinisqlParserGetError()) << sql;
+  ExecuteContext context;
+  testing::internal::CaptureStdout();
+  dberr_t result = engine.Execute(MinisqlGetParserRootNode(), &context);
+  std::string printed = testing::internal::GetCapturedStdout();
+  if (output != nullptr) {
+    *output = std::move(printed);
+  }
+  MinisqlParserFinish();
+  yy_delete_buffer(bp);
+  yylex_destroy();
+  return result;
+}
+
+// the values printed by a select, in order
+static std::string SelectValues(ExecuteEngine &engine, const char *sql) {
+  std::string output;
+  EXPECT_EQ(DB_SUCCESS, RunSql(engine, sql, &output)) << sql;
+  std::string values;
+  std::istringstream lines(output);
+  for (std::string line; std::getline(lines, line);) {
+    if (line.rfind("total", 0) == 0) {
+      break;
+    }
+    values += line;
+  }
+  return values;
+}
+
+TEST(ExecuteEngineTest, FractionalBoundOnIntColumnTest) {
+  ExecuteEngine engine;
+  RunSql(engine, "drop database execute_engine_test_db;");
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create database execute_engine_test_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "use execute_engine_test_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create table t(id int, v int, primary key(id));"));
+  for (const char *sql : {"insert into t values(1, 1);", "insert into t values(2, null);",
+                          "insert into t values(3, 3);", "insert into t values(16777217, 4);"}) {
+    ASSERT_EQ(DB_SUCCESS, RunSql(engine, sql));
+  }
+  // a range compares with the nearest integer inside it, on the indexed key and on a plain column
+  EXPECT_EQ("1 2 ", SelectValues(engine, "select id from t where id < 2.5;"));
+  EXPECT_EQ("1 2 ", SelectValues(engine, "select id from t where id <= 2.5;"));
+  EXPECT_EQ("3 16777217 ", SelectValues(engine, "select id from t where id > 2.5;"));
+  EXPECT_EQ("2 3 ", SelectValues(engine, "select id from t where id >= 1.5 and id <= 3.5;"));
+  EXPECT_EQ("1 ", SelectValues(engine, "select id from t where v < 2.5;"));
+  EXPECT_EQ("16777217 ", SelectValues(engine, "select id from t where id > 16777216.5;"));
+  // <> holds for every value that is not null, = for none
+  EXPECT_EQ("1 2 3 16777217 ", SelectValues(engine, "select id from t where id <> 2.5;"));
+  EXPECT_EQ("1 3 16777217 ", SelectValues(engine, "select id from t where v <> 2.5;"));
+  EXPECT_EQ("", SelectValues(engine, "select id from t where id = 2.5;"));
+  // bounds beyond the range of int
+  EXPECT_EQ("1 2 3 16777217 ", SelectValues(engine, "select id from t where id < 9999999999.5;"));
+  EXPECT_EQ("", SelectValues(engine, "select id from t where id > 9999999999.5;"));
+  // the rewritten bound also drives deletes
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "delete from t where id < 1.5;"));
+  EXPECT_EQ("2 3 16777217 ", SelectValues(engine, "select id from t;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "drop database execute_engine_test_db;"));
+}
+
+TEST(ExecuteEngineTest, IndexRangeScanTest) {
+  ExecuteEngine engine;
+  RunSql(engine, "drop database execute_engine_range_db;");
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create database execute_engine_range_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "use execute_engine_range_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create table t(id int, v int, primary key(id));"));
+  // inserted in descending order, so only the index returns ascending ids
+  for (int i = 2000; i > 0; i--) {
+    std::string sql = "insert into t values(" + std::to_string(i) + ", " + std::to_string(i % 7) + ");";
+    ASSERT_EQ(DB_SUCCESS, RunSql(engine, sql.c_str()));
+  }
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "analyze t;"));
+  // v is not in the key, so no covering scan answers these
+  EXPECT_EQ("1 1 2 2 3 3 4 4 ", SelectValues(engine, "select id, v from t where id < 5;"));
+  EXPECT_EQ("1 1 2 2 3 3 4 4 5 5 ", SelectValues(engine, "select id, v from t where id <= 5;"));
+  EXPECT_EQ("1997 2 1998 3 1999 4 2000 5 ", SelectValues(engine, "select id, v from t where id > 1996;"));
+  EXPECT_EQ("11 4 12 5 ", SelectValues(engine, "select id, v from t where id > 10 and id <= 12;"));
+  // the other conditions still filter the rows of the range
+  EXPECT_EQ("14 0 ", SelectValues(engine, "select id, v from t where id >= 10 and id < 20 and v = 0;"));
+  EXPECT_EQ("3 3 ", SelectValues(engine, "select id, v from t where id < 4 and id > 1.5 and id <> 2;"));
+  // a wide range reads the table in insertion order
+  std::string wide = SelectValues(engine, "select id, v from t where id > 5;");
+  EXPECT_EQ(0u, wide.rfind("2000 5 1999 4 ", 0)) << wide.substr(0, 100);
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "delete from t where id < 3;"));
+  EXPECT_EQ("3 3 4 4 ", SelectValues(engine, "select id, v from t where id < 5;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "drop database execute_engine_range_db;"));
+}
+
+TEST(ExecuteEngineTest, UpdateMaintainsIndexesTest) {
+  ExecuteEngine engine;
+  RunSql(engine, "drop database execute_engine_update_db;");
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create database execute_engine_update_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "use execute_engine_update_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create table t(id int, name char(16) unique, v float, primary key(id));"));
+  for (const char *sql : {"insert into t values(1, \"a\", 1.5);", "insert into t values(2, \"b\", 2.5);",
+                          "insert into t values(3, \"c\", 3.5);"}) {
+    ASSERT_EQ(DB_SUCCESS, RunSql(engine, sql));
+  }
+  // the covering scans read the keys from the indexes, which must follow the update
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "update t set id = 10 where id = 1;"));
+  EXPECT_EQ("2 3 10 ", SelectValues(engine, "select id from t;"));
+  EXPECT_EQ("10 ", SelectValues(engine, "select id from t where id = 10;"));
+  EXPECT_EQ("", SelectValues(engine, "select id from t where id = 1;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "update t set name = \"z\" where id = 2;"));
+  EXPECT_EQ("a c z ", SelectValues(engine, "select name from t;"));
+  // a collision leaves the row and its index entries as they were
+  EXPECT_EQ(DB_PRIMARY_KEY_COLLISION, RunSql(engine, "update t set id = 3 where id = 10;"));
+  EXPECT_EQ(DB_UNIQUE_KEY_COLLISION, RunSql(engine, "update t set name = \"c\" where id = 10;"));
+  EXPECT_EQ("2 3 10 ", SelectValues(engine, "select id from t;"));
+  EXPECT_EQ("a c z ", SelectValues(engine, "select name from t;"));
+  EXPECT_EQ("10 a 1.500000 ", SelectValues(engine, "select * from t where id = 10;"));
+  // an update of other columns keeps the keys
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "update t set v = 9.5 where id = 3;"));
+  EXPECT_EQ("3 ", SelectValues(engine, "select id from t where name = \"c\";"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "drop database execute_engine_update_db;"));
+}
+
+TEST(ExecuteEngineTest, AggregateWithoutGroupByTest) {
+  ExecuteEngine engine;
+  RunSql(engine, "drop database execute_engine_aggregate_db;");
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create database execute_engine_aggregate_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "use execute_engine_aggregate_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create table t(id int, name char(8), v int, f float, primary key(id));"));
+  for (const char *sql : {"insert into t values(1, \"a\", 10, 1.5);", "insert into t values(2, \"b\", null, null);",
+                          "insert into t values(3, \"c\", 2147483647, -2.5);",
+                          "insert into t values(4, null, -5, 0.5);"}) {
+    ASSERT_EQ(DB_SUCCESS, RunSql(engine, sql));
+  }
+  // a single table is aggregated over the batches of its scan, a qualified column name takes the
+  // row at a time pipeline, and the two agree
+  const char *queries[][2] = {
+      {"select count(*), count(v), count(name), sum(f), min(v), max(v), avg(f) from t;",
+       "select count(*), count(t.v), count(t.name), sum(t.f), min(t.v), max(t.v), avg(t.f) from t;"},
+      {"select sum(v), max(f) from t where name <> \"c\";", "select sum(t.v), max(t.f) from t where t.name <> \"c\";"},
+      {"select count(*), min(v), avg(v) from t where name = \"z\";",
+       "select count(*), min(t.v), avg(t.v) from t where t.name = \"z\";"}};
+  const char *expected[] = {"4 3 3 -0.500000 -5 2147483647 -0.166667 ", "10 1.500000 ", "0 null null "};
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(expected[i], SelectValues(engine, queries[i][0]));
+    EXPECT_EQ(expected[i], SelectValues(engine, queries[i][1]));
+  }
+  // an int sum out of the range of int fails, a text column has no sum
+  EXPECT_EQ(DB_FAILED, RunSql(engine, "select sum(v) from t;"));
+  EXPECT_EQ(DB_TYPE_MISMATCH, RunSql(engine, "select sum(name) from t;"));
+  EXPECT_EQ(DB_FAILED, RunSql(engine, "select sum(*) from t;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "drop database execute_engine_aggregate_db;"));
+}
+
+TEST(ExecuteEngineTest, PrefixIndexTest) {
+  ExecuteEngine engine;
+  RunSql(engine, "drop database execute_engine_prefix_db;");
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create database execute_engine_prefix_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "use execute_engine_prefix_db;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create table t(id int, url char(48) unique, primary key(id));"));
+  // the unique column gets a b+ tree index, replaced by a prefix compressed one
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "drop index t__unique__1;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "create index url_index on t(url) using prefix;"));
+  for (int i = 0; i < 500; i++) {
+    std::string sql = "insert into t values(" + std::to_string(i) + ", \"https://example.com/item-" +
+                      std::to_string(1000 + i) + "\");";
+    ASSERT_EQ(DB_SUCCESS, RunSql(engine, sql.c_str()));
+  }
+  ASSERT_EQ(DB_UNIQUE_KEY_COLLISION, RunSql(engine, "insert into t values(999, \"https://example.com/item-1007\");"));
+  EXPECT_EQ("7 ", SelectValues(engine, "select id from t where url = \"https://example.com/item-1007\";"));
+  EXPECT_EQ("497 498 499 ", SelectValues(engine, "select id from t where url > \"https://example.com/item-1496\";"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "update t set url = \"https://example.com/moved\" where id = 7;"));
+  EXPECT_EQ("", SelectValues(engine, "select id from t where url = \"https://example.com/item-1007\";"));
+  EXPECT_EQ("7 ", SelectValues(engine, "select id from t where url = \"https://example.com/moved\";"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "delete from t where url = \"https://example.com/moved\";"));
+  EXPECT_EQ("", SelectValues(engine, "select id from t where id = 7;"));
+  ASSERT_EQ(DB_SUCCESS, RunSql(engine, "drop database execute_engine_prefix_db;"));
+}
@@ -0,0 +1,382 @@
+#include "executor/operators.h"
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "utils/utils.h"
+
+static string db_file_name = "operators_test.db";
+
+static size_t Drain(Operator &op) {
+  size_t count = 0;
+  while (op.Next() != nullptr) {
+    count++;
+  }
+  return count;
+}
+
+TEST(OperatorsTest, PipelineTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 16, 1, false, true),
+                                   ALLOC_COLUMN(heap)("v", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  schema->getPrimaryKeys().push_back(0);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("t", schema.get(), nullptr, table_info));
+  std::vector<IndexInfo *> indexes;
+  catalog->GetTableIndexes("t", indexes);
+  ASSERT_EQ(2u, indexes.size());
+  const int n = 1000;
+  for (int i = 0; i < n; i++) {
+    std::string name = "name" + std::to_string(i);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                              Field(TypeId::kTypeFloat, static_cast<float>(i % 10))};
+    InsertOperator insert(table_info, indexes, fields);
+    ASSERT_EQ(DB_SUCCESS, insert.Init());
+    const Row *row = insert.Next();
+    ASSERT_NE(nullptr, row);
+    ASSERT_EQ(nullptr, insert.Next());
+  }
+  // key collisions leave neither the tuple nor index entries behind
+  std::vector<Field> dup{Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeChar, const_cast<char *>("other"), 5, true),
+                         Field(TypeId::kTypeFloat, 0.0f)};
+  InsertOperator dup_insert(table_info, indexes, dup);
+  ASSERT_EQ(DB_SUCCESS, dup_insert.Init());
+  ASSERT_EQ(nullptr, dup_insert.Next());
+  ASSERT_EQ(DB_PRIMARY_KEY_COLLISION, dup_insert.GetStatus());
+  SeqScanOperator seq_scan(table_info->GetTableHeap());
+  ASSERT_EQ(DB_SUCCESS, seq_scan.Init());
+  ASSERT_EQ(static_cast<size_t>(n), Drain(seq_scan));
+  // scan -> filter -> projection
+  auto filter = std::make_unique<FilterOperator>(
+      std::make_unique<SeqScanOperator>(table_info->GetTableHeap()),
+      [](const Row &row) { return row.GetField(2)->CompareEquals(Field(TypeId::kTypeFloat, 3.0f)) == kTrue; });
+  ProjectionOperator projection(std::move(filter), {1});
+  ASSERT_EQ(DB_SUCCESS, projection.Init());
+  size_t count = 0;
+  for (const Row *row = projection.Next(); row != nullptr; row = projection.Next()) {
+    ASSERT_EQ(1u, row->GetFieldCount());
+    std::string name(row->GetField(0)->GetData(), row->GetField(0)->GetLength());
+    ASSERT_EQ("name" + std::to_string(10 * count + 3), name);
+    count++;
+  }
+  ASSERT_EQ(static_cast<size_t>(n / 10), count);
+  // index scan over the primary key, duplicate keys yield one row
+  IndexInfo *primary = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->GetIndex("t", "t__primary", primary));
+  std::vector<Row> keys;
+  for (int id : {5, 7, 5, n + 1}) {
+    std::vector<Field> key{Field(TypeId::kTypeInt, id)};
+    keys.emplace_back(key);
+  }
+  IndexScanOperator index_scan(primary->GetIndex(), table_info->GetTableHeap(), keys);
+  ASSERT_EQ(DB_SUCCESS, index_scan.Init());
+  ASSERT_EQ(2u, Drain(index_scan));
+  // update every row with v = 3, then delete them
+  std::vector<std::pair<uint32_t, Field>> assignments;
+  assignments.emplace_back(2, Field(TypeId::kTypeFloat, 42.0f));
+  auto pred = [](float v) {
+    return [v](const Row &row) { return row.GetField(2)->CompareEquals(Field(TypeId::kTypeFloat, v)) == kTrue; };
+  };
+  UpdateOperator update(
+      std::make_unique<FilterOperator>(std::make_unique<SeqScanOperator>(table_info->GetTableHeap()), pred(3.0f)),
+      table_info, indexes, assignments);
+  ASSERT_EQ(DB_SUCCESS, update.Init());
+  ASSERT_EQ(static_cast<size_t>(n / 10), Drain(update));
+  DeleteOperator deleter(
+      std::make_unique<FilterOperator>(std::make_unique<SeqScanOperator>(table_info->GetTableHeap()), pred(42.0f)),
+      table_info, indexes);
+  ASSERT_EQ(DB_SUCCESS, deleter.Init());
+  ASSERT_EQ(static_cast<size_t>(n / 10), Drain(deleter));
+  ASSERT_EQ(DB_SUCCESS, seq_scan.Init());
+  ASSERT_EQ(static_cast<size_t>(n - n / 10), Drain(seq_scan));
+  // the deleted keys are gone from the indexes too
+  std::vector<Field> deleted_key{Field(TypeId::kTypeInt, 3)};
+  std::vector<Row> deleted_keys{Row(deleted_key)};
+  IndexScanOperator deleted_scan(primary->GetIndex(), table_info->GetTableHeap(), deleted_keys);
+  ASSERT_EQ(DB_SUCCESS, deleted_scan.Init());
+  ASSERT_EQ(0u, Drain(deleted_scan));
+  delete engine;
+  remove(db_file_name.c_str());
+}
+
+TEST(OperatorsTest, HashJoinTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> a_columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, true),
+                                     ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 16, 1, false, false)};
+  std::vector<Column *> b_columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                     ALLOC_COLUMN(heap)("a_id", TypeId::kTypeInt, 1, true, false),
+                                     ALLOC_COLUMN(heap)("tag", TypeId::kTypeChar, 16, 2, true, false)};
+  auto a_schema = std::make_shared<Schema>(a_columns);
+  auto b_schema = std::make_shared<Schema>(b_columns);
+  TableInfo *a = nullptr;
+  TableInfo *b = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("a", a_schema.get(), nullptr, a));
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("b", b_schema.get(), nullptr, b));
+  std::vector<IndexInfo *> a_indexes;
+  catalog->GetTableIndexes("a", a_indexes);
+  ASSERT_EQ(1u, a_indexes.size());
+  IndexInfo *a_index = a_indexes[0];
+  // b.a_id refers to a.id for most rows; it is null in some and matches nothing in others
+  const int n = 2000;
+  const int m = 3000;
+  for (int i = 0; i < n; i++) {
+    std::string name = "name" + std::to_string(i);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    InsertOperator insert(a, {a_index}, fields);
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  size_t expected = 0;
+  for (int i = 0; i < m; i++) {
+    std::string tag = "name" + std::to_string(i % 2500);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    if (i % 100 == 0) {
+      fields.emplace_back(TypeId::kTypeInt);
+    } else {
+      fields.emplace_back(TypeId::kTypeInt, i % 2500);
+      expected += i % 2500 < n;
+    }
+    fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(tag.c_str()), tag.size(), true);
+    InsertOperator insert(b, {}, fields);
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  auto make_join = [&](std::vector<uint32_t> left_keys, std::vector<uint32_t> right_keys, bool build_left,
+                       size_t budget) {
+    return std::make_unique<HashJoinOperator>(std::make_unique<SeqScanOperator>(a->GetTableHeap()),
+                                              std::make_unique<SeqScanOperator>(b->GetTableHeap()), left_keys,
+                                              right_keys, build_left, engine->bpm_, budget);
+  };
+  // either side built, in memory or spilled to pages, with one key or two
+  for (bool build_left : {true, false}) {
+    for (size_t budget : {static_cast<size_t>(JOIN_MEMORY_BUDGET), static_cast<size_t>(PAGE_SIZE)}) {
+      for (bool two_keys : {false, true}) {
+        auto join = two_keys ? make_join({0, 1}, {1, 2}, build_left, budget) : make_join({0}, {1}, build_left, budget);
+        ASSERT_EQ(DB_SUCCESS, join->Init());
+        ASSERT_EQ(budget == PAGE_SIZE, join->IsSpilled());
+        size_t count = 0;
+        for (const Row *row = join->Next(); row != nullptr; row = join->Next()) {
+          ASSERT_EQ(5u, row->GetFieldCount());
+          ASSERT_EQ(row->GetField(0)->GetIntData(), row->GetField(3)->GetIntData());
+          ASSERT_EQ(0, strncmp(row->GetField(1)->GetData(), row->GetField(4)->GetData(),
+                               row->GetField(1)->GetCharLength()));
+          count++;
+        }
+        ASSERT_EQ(DB_SUCCESS, join->GetStatus());
+        ASSERT_EQ(expected, count);
+      }
+    }
+  }
+  // probing the index of a for every row of b, in batches of various sizes
+  for (size_t batch_size : {1, 7, INDEX_JOIN_BATCH_SIZE}) {
+    IndexJoinOperator join(std::make_unique<SeqScanOperator>(b->GetTableHeap()), a_index, a->GetTableHeap(), {1},
+                           nullptr, batch_size);
+    ASSERT_EQ(DB_SUCCESS, join.Init());
+    size_t count = 0;
+    for (const Row *row = join.Next(); row != nullptr; row = join.Next()) {
+      ASSERT_EQ(5u, row->GetFieldCount());
+      ASSERT_EQ(row->GetField(1)->GetIntData(), row->GetField(3)->GetIntData());
+      count++;
+    }
+    ASSERT_EQ(DB_SUCCESS, join.GetStatus());
+    ASSERT_EQ(expected, count);
+  }
+  // inner rows are filtered, and a key of another type is converted
+  IndexJoinOperator filtered(std::make_unique<SeqScanOperator>(b->GetTableHeap()), a_index, a->GetTableHeap(), {1},
+                             [](const Row &row) { return row.GetField(0)->GetIntData() < 10; });
+  ASSERT_EQ(DB_SUCCESS, filtered.Init());
+  ASSERT_EQ(18u, Drain(filtered));
+  std::vector<Field> float_fields{Field(TypeId::kTypeFloat, 5.0f)};
+  std::vector<Field> fraction_fields{Field(TypeId::kTypeFloat, 5.5f)};
+  std::vector<Row> float_rows{Row(float_fields), Row(fraction_fields)};
+  class RowsOperator : public Operator {
+   public:
+    explicit RowsOperator(std::vector<Row> &rows) : rows_(rows) {}
+    dberr_t Init() override {
+      next_ = 0;
+      return DB_SUCCESS;
+    }
+    const Row *Next() override { return next_ < rows_.size() ? &rows_[next_++] : nullptr; }
+
+   private:
+    std::vector<Row> &rows_;
+    size_t next_{0};
+  };
+  IndexJoinOperator converted(std::make_unique<RowsOperator>(float_rows), a_index, a->GetTableHeap(), {0});
+  ASSERT_EQ(DB_SUCCESS, converted.Init());
+  const Row *match = converted.Next();
+  ASSERT_NE(nullptr, match);
+  ASSERT_EQ(5, match->GetField(1)->GetIntData());
+  ASSERT_EQ(nullptr, converted.Next());
+
+  // without keys every pair is joined
+  auto small = std::make_unique<FilterOperator>(std::make_unique<SeqScanOperator>(a->GetTableHeap()),
+                                                [](const Row &row) { return row.GetField(0)->GetIntData() < 3; });
+  HashJoinOperator cross(std::move(small), std::make_unique<SeqScanOperator>(b->GetTableHeap()), {}, {}, true,
+                         engine->bpm_);
+  ASSERT_EQ(DB_SUCCESS, cross.Init());
+  ASSERT_EQ(static_cast<size_t>(3 * m), Drain(cross));
+  delete engine;
+  remove(db_file_name.c_str());
+}
+
+TEST(OperatorsTest, HashJoinZeroKeyTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> f_columns = {ALLOC_COLUMN(heap)("v", TypeId::kTypeFloat, 0, false, false)};
+  std::vector<Column *> g_columns = {ALLOC_COLUMN(heap)("i", TypeId::kTypeInt, 0, false, false)};
+  auto f_schema = std::make_shared<Schema>(f_columns);
+  auto g_schema = std::make_shared<Schema>(g_columns);
+  TableInfo *f = nullptr;
+  TableInfo *g = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("f", f_schema.get(), nullptr, f));
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("g", g_schema.get(), nullptr, g));
+  for (float v : {-0.0f, 0.0f, 1.5f}) {
+    InsertOperator insert(f, {}, {Field(TypeId::kTypeFloat, v)});
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  for (int i : {0, 1}) {
+    InsertOperator insert(g, {}, {Field(TypeId::kTypeInt, i)});
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  // -0.0 equals 0 and 0.0 as in a where clause, whichever side is built
+  auto count = [&](TableInfo *left, TableInfo *right, bool build_left) {
+    HashJoinOperator join(std::make_unique<SeqScanOperator>(left->GetTableHeap()),
+                          std::make_unique<SeqScanOperator>(right->GetTableHeap()), {0}, {0}, build_left,
+                          engine->bpm_);
+    EXPECT_EQ(DB_SUCCESS, join.Init());
+    size_t rows = 0;
+    for (const Row *row = join.Next(); row != nullptr; row = join.Next()) {
+      const Field *key = row->GetField(1);
+      EXPECT_EQ(row->GetField(0)->GetFloatData(),
+                key->GetType() == TypeId::kTypeInt ? key->GetIntData() : key->GetFloatData());
+      rows++;
+    }
+    return rows;
+  };
+  for (bool build_left : {true, false}) {
+    ASSERT_EQ(2u, count(f, g, build_left));
+    ASSERT_EQ(5u, count(f, f, build_left));
+  }
+  delete engine;
+  remove(db_file_name.c_str());
+}
+
+TEST(OperatorsTest, HashAggregateTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("g", TypeId::kTypeChar, 16, 1, true, false),
+                                   ALLOC_COLUMN(heap)("v", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *t = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("t", schema.get(), nullptr, t));
+  // 5000 groups of four rows, v is null in every seventh row and g in the rows of the last group
+  const int n = 20000;
+  const int groups = 5000;
+  for (int i = 0; i < n; i++) {
+    std::string g = "g" + std::to_string(i % groups);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    if (i % groups == groups - 1) {
+      fields.emplace_back(TypeId::kTypeChar);
+    } else {
+      fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(g.c_str()), g.size(), true);
+    }
+    if (i % 7 == 0) {
+      fields.emplace_back(TypeId::kTypeFloat);
+    } else {
+      fields.emplace_back(TypeId::kTypeFloat, static_cast<float>(i));
+    }
+    InsertOperator insert(t, {}, fields);
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  std::vector<std::pair<AggregateType, int>> aggregates{{AggregateType::kCount, -1}, {AggregateType::kCount, 2},
+                                                        {AggregateType::kSum, 2},    {AggregateType::kAvg, 2},
+                                                        {AggregateType::kMin, 0},    {AggregateType::kMax, 2}};
+  // in memory or spilled to pages, every group is yielded once with the aggregates of its rows
+  for (size_t budget : {static_cast<size_t>(GROUP_MEMORY_BUDGET), static_cast<size_t>(128 * 1024)}) {
+    HashAggregateOperator aggregate(std::make_unique<SeqScanOperator>(t->GetTableHeap()), {1}, aggregates,
+                                    engine->bpm_, budget);
+    ASSERT_EQ(DB_SUCCESS, aggregate.Init());
+    std::vector<bool> seen(groups);
+    size_t count = 0;
+    for (const Row *row = aggregate.Next(); row != nullptr; row = aggregate.Next()) {
+      ASSERT_EQ(7u, row->GetFieldCount());
+      int group = groups - 1;
+      if (!row->GetField(0)->IsNull()) {
+        group = std::stoi(std::string(row->GetField(0)->GetData() + 1, row->GetField(0)->GetCharLength() - 1));
+      }
+      ASSERT_FALSE(seen[group]);
+      seen[group] = true;
+      int values = 0;
+      double sum = 0;
+      double max = 0;
+      for (int i = group; i < n; i += groups) {
+        if (i % 7 != 0) {
+          values++;
+          sum += i;
+          max = i;
+        }
+      }
+      ASSERT_EQ(n / groups, row->GetField(1)->GetIntData());
+      ASSERT_EQ(values, row->GetField(2)->GetIntData());
+      ASSERT_FLOAT_EQ(sum, row->GetField(3)->GetFloatData());
+      ASSERT_FLOAT_EQ(sum / values, row->GetField(4)->GetFloatData());
+      ASSERT_EQ(group, row->GetField(5)->GetIntData());
+      ASSERT_FLOAT_EQ(max, row->GetField(6)->GetFloatData());
+      count++;
+    }
+    ASSERT_EQ(DB_SUCCESS, aggregate.GetStatus());
+    ASSERT_EQ(static_cast<size_t>(groups), count);
+    ASSERT_EQ(budget != GROUP_MEMORY_BUDGET, aggregate.IsSpilled());
+  }
+
+  // without group columns there is one row even over no rows, the aggregates of no values being null
+  auto none = std::make_unique<FilterOperator>(std::make_unique<SeqScanOperator>(t->GetTableHeap()),
+                                               [](const Row &row) { return false; });
+  HashAggregateOperator total(std::move(none), {}, aggregates, engine->bpm_);
+  ASSERT_EQ(DB_SUCCESS, total.Init());
+  const Row *row = total.Next();
+  ASSERT_NE(nullptr, row);
+  ASSERT_EQ(0, row->GetField(0)->GetIntData());
+  ASSERT_EQ(0, row->GetField(1)->GetIntData());
+  ASSERT_TRUE(row->GetField(2)->IsNull());
+  ASSERT_TRUE(row->GetField(5)->IsNull());
+  ASSERT_EQ(nullptr, total.Next());
+
+  // the aggregates of an int column keep every digit, a sum out of the range of int fails
+  std::vector<Column *> big_columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false)};
+  auto big_schema = std::make_shared<Schema>(big_columns);
+  TableInfo *big = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("big", big_schema.get(), nullptr, big));
+  for (int32_t id : {16777217, 16777219, -16777217}) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id)};
+    InsertOperator insert(big, {}, fields);
+    ASSERT_NE(nullptr, insert.Next());
+  }
+  HashAggregateOperator exact(std::make_unique<SeqScanOperator>(big->GetTableHeap()), {},
+                              {{AggregateType::kSum, 0}, {AggregateType::kMin, 0}, {AggregateType::kMax, 0}},
+                              engine->bpm_);
+  ASSERT_EQ(DB_SUCCESS, exact.Init());
+  row = exact.Next();
+  ASSERT_NE(nullptr, row);
+  ASSERT_EQ(16777219, row->GetField(0)->GetIntData());
+  ASSERT_EQ(-16777217, row->GetField(1)->GetIntData());
+  ASSERT_EQ(16777219, row->GetField(2)->GetIntData());
+  std::vector<Field> max_fields{Field(TypeId::kTypeInt, INT32_MAX)};
+  InsertOperator insert(big, {}, max_fields);
+  ASSERT_NE(nullptr, insert.Next());
+  HashAggregateOperator overflow(std::make_unique<SeqScanOperator>(big->GetTableHeap()), {},
+                                 {{AggregateType::kSum, 0}}, engine->bpm_);
+  ASSERT_EQ(DB_SUCCESS, overflow.Init());
+  ASSERT_EQ(nullptr, overflow.Next());
+  ASSERT_EQ(DB_FAILED, overflow.GetStatus());
+  delete engine;
+  remove(db_file_name.c_str());
+}
@@ -0,0 +1,141 @@
+#include "executor/planner.h"
+#include "common/instance.h"
+#include "executor/operators.h"
+#include "gtest/gtest.h"
+#include "utils/utils.h"
+
+static string db_file_name = "planner_test.db";
+
+static void Insert(TableInfo *table_info, std::vector<IndexInfo *> &indexes, int from, int to) {
+  for (int i = from; i < to; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeFloat, static_cast<float>(i % 10))};
+    InsertOperator insert(table_info, indexes, fields);
+    ASSERT_EQ(DB_SUCCESS, insert.Init());
+    ASSERT_NE(nullptr, insert.Next());
+  }
+}
+
+// append the bound condition "column op value", joined to the previous one by connector
+static void AddCondition(ConditionList &conditions, uint32_t column, const char *op, int value,
+                         const char *connector = "and") {
+  if (!conditions.pairs.empty()) {
+    conditions.connector.push_back(const_cast<char *>(connector));
+  }
+  conditions.compare.push_back(const_cast<char *>(op));
+  conditions.pairs.emplace_back(column == 0 ? "id" : "v", nullptr, kNodeNumber);
+  conditions.column_index.push_back(column);
+  if (column == 0) {
+    conditions.to_be_compared.emplace_back(TypeId::kTypeInt, value);
+  } else {
+    conditions.to_be_compared.emplace_back(TypeId::kTypeFloat, static_cast<float>(value));
+  }
+}
+
+TEST(PlannerTest, AccessPathTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("v", TypeId::kTypeFloat, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  schema->getPrimaryKeys().push_back(0);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("t", schema.get(), nullptr, table_info));
+  std::vector<IndexInfo *> indexes;
+  catalog->GetTableIndexes("t", indexes);
+  ASSERT_EQ(1u, indexes.size());
+
+  // a table of a single page is scanned rather than probed
+  Insert(table_info, indexes, 0, 3);
+  ConditionList point;
+  AddCondition(point, 0, "=", 1);
+  {
+    Planner planner(table_info, indexes);
+    ASSERT_TRUE(planner.HasRowCount());
+    ASSERT_EQ(3u, planner.GetRowCount());
+    AccessPath path = planner.ChooseAccessPath(point);
+    ASSERT_EQ(nullptr, path.index);
+    ASSERT_FALSE(path.empty);
+  }
+
+  Insert(table_info, indexes, 3, 5000);
+  Planner planner(table_info, indexes);
+  ASSERT_EQ(5000u, planner.GetRowCount());
+  // an equality on the key matches one row
+  ASSERT_DOUBLE_EQ(1.0 / 5000, planner.EstimateSelectivity(point));
+  AccessPath path = planner.ChooseAccessPath(point);
+  ASSERT_EQ(indexes[0], path.index);
+  ASSERT_EQ(std::vector<uint32_t>{0}, path.key_conditions);
+  ASSERT_LT(path.cost, planner.GetSeqScanCost());
+
+  // the remaining conditions are left to the filter
+  ConditionList residual;
+  AddCondition(residual, 1, ">", 3);
+  AddCondition(residual, 0, "=", 7);
+  path = planner.ChooseAccessPath(residual);
+  ASSERT_EQ(indexes[0], path.index);
+  ASSERT_EQ(std::vector<uint32_t>{1}, path.key_conditions);
+
+  // no index on v, and a range on id taking the default third of the table is scanned
+  ConditionList unindexed;
+  AddCondition(unindexed, 1, "=", 3);
+  ASSERT_EQ(nullptr, planner.ChooseAccessPath(unindexed).index);
+  ConditionList range;
+  AddCondition(range, 0, "<", 100);
+  ASSERT_EQ(nullptr, planner.ChooseAccessPath(range).index);
+
+  // an in-list probes once per constant, until the probes cost more than the scan
+  ConditionList in_list;
+  AddCondition(in_list, 0, "=", 1);
+  AddCondition(in_list, 0, "=", 2, "or");
+  AddCondition(in_list, 0, "=", 3, "or");
+  path = planner.ChooseAccessPath(in_list);
+  ASSERT_EQ(indexes[0], path.index);
+  ASSERT_TRUE(path.in_list);
+  ASSERT_EQ(3u, path.key_conditions.size());
+  ConditionList long_list;
+  for (int i = 0; i < 200; i++) {
+    AddCondition(long_list, 0, "=", i, "or");
+  }
+  ASSERT_EQ(nullptr, planner.ChooseAccessPath(long_list).index);
+
+  // two different values of one column
+  ConditionList contradiction;
+  AddCondition(contradiction, 0, "=", 1);
+  AddCondition(contradiction, 0, "=", 2);
+  ASSERT_TRUE(planner.ChooseAccessPath(contradiction).empty);
+
+  // a few outer rows probe the primary key, many outer rows or an unknown count read the table
+  std::vector<uint32_t> key_order;
+  ASSERT_EQ(indexes[0], planner.ChooseJoinIndex({0}, 3, planner.GetSeqScanCost(), key_order));
+  ASSERT_EQ(std::vector<uint32_t>{0}, key_order);
+  ASSERT_EQ(nullptr, planner.ChooseJoinIndex({0}, 1e6, planner.GetSeqScanCost(), key_order));
+  ASSERT_EQ(nullptr, planner.ChooseJoinIndex({0}, -1, planner.GetSeqScanCost(), key_order));
+  // the key must be exactly the join columns
+  ASSERT_EQ(nullptr, planner.ChooseJoinIndex({1}, 3, planner.GetSeqScanCost(), key_order));
+  ASSERT_EQ(nullptr, planner.ChooseJoinIndex({0, 1}, 3, planner.GetSeqScanCost(), key_order));
+
+  // once analyzed, a narrow range on the key scans the index between its tightest bounds
+  ASSERT_EQ(DB_SUCCESS, catalog->AnalyzeTable("t"));
+  Planner analyzed(table_info, indexes);
+  ConditionList narrow;
+  AddCondition(narrow, 0, "<", 5);
+  path = analyzed.ChooseAccessPath(narrow);
+  ASSERT_EQ(indexes[0], path.index);
+  ASSERT_TRUE(path.range);
+  ASSERT_EQ(-1, path.low_condition);
+  ASSERT_EQ(0, path.high_condition);
+  ASSERT_LT(path.cost, analyzed.GetSeqScanCost());
+  ConditionList between;
+  AddCondition(between, 0, ">", 10);
+  AddCondition(between, 0, "<=", 20);
+  AddCondition(between, 0, ">=", 15);
+  AddCondition(between, 1, "=", 3);
+  path = analyzed.ChooseAccessPath(between);
+  ASSERT_TRUE(path.range);
+  ASSERT_EQ(2, path.low_condition);
+  ASSERT_EQ(1, path.high_condition);
+  ASSERT_EQ(nullptr, analyzed.ChooseAccessPath(range).index);
+  delete engine;
+  remove(db_file_name.c_str());
+}
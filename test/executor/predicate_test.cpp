@@ -0,0 +1,95 @@
+#include "executor/predicate.h"
+#include "gtest/gtest.h"
+
+static Row MakeRow(int id, const std::string &name, bool null_v, float v) {
+  std::vector<Field> fields{Field(TypeId::kTypeFloat, static_cast<float>(id)),
+                            Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                            null_v ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, v)};
+  return Row(fields);
+}
+
+TEST(PredicateTest, CompareTest) {
+  ASSERT_EQ(CompareOp::kEqual, ParseCompareOp("="));
+  ASSERT_EQ(CompareOp::kNotEqual, ParseCompareOp("<>"));
+  ASSERT_EQ(CompareOp::kLessEqual, ParseCompareOp("<="));
+  ASSERT_EQ(CompareOp::kGreater, ParseCompareOp(">"));
+  ASSERT_EQ(CompareOp::kIsNull, ParseCompareOp("is"));
+  ASSERT_EQ(CompareOp::kNotNull, ParseCompareOp("not"));
+
+  Row row = MakeRow(3, "abc", false, 1.5f);
+  Row null_row = MakeRow(4, "ab", true, 0);
+  ASSERT_TRUE(Predicate::MakeNumberCompare(0, kTypeFloat, CompareOp::kEqual, 3.0004f)->Evaluate(row));
+  ASSERT_FALSE(Predicate::MakeNumberCompare(0, kTypeFloat, CompareOp::kNotEqual, 3.0004f)->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeNumberCompare(2, kTypeFloat, CompareOp::kGreaterEqual, 1.5f)->Evaluate(row));
+  ASSERT_FALSE(Predicate::MakeNumberCompare(2, kTypeFloat, CompareOp::kLess, 1.5f)->Evaluate(row));
+  // a null value never satisfies a comparison
+  ASSERT_FALSE(Predicate::MakeNumberCompare(2, kTypeFloat, CompareOp::kNotEqual, 1.5f)->Evaluate(null_row));
+  ASSERT_TRUE(Predicate::MakeNullTest(2, true)->Evaluate(null_row));
+  ASSERT_FALSE(Predicate::MakeNullTest(2, false)->Evaluate(null_row));
+  ASSERT_FALSE(Predicate::MakeFalse()->Evaluate(row));
+  // text compares byte by byte, a prefix being the smaller
+  ASSERT_TRUE(Predicate::MakeTextCompare(1, CompareOp::kEqual, "abc")->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeTextCompare(1, CompareOp::kLess, "abd")->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeTextCompare(1, CompareOp::kLess, "abc")->Evaluate(null_row));
+  ASSERT_TRUE(Predicate::MakeTextCompare(1, CompareOp::kGreater, "ab")->Evaluate(row));
+}
+
+TEST(PredicateTest, ColumnCompareTest) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 3),
+                            Field(TypeId::kTypeInt, 16777217),
+                            Field(TypeId::kTypeInt, 16777216),
+                            Field(TypeId::kTypeFloat, 3.0004f),
+                            Field(TypeId::kTypeChar, const_cast<char *>("ab"), 2, true),
+                            Field(TypeId::kTypeChar, const_cast<char *>("abc"), 3, true),
+                            Field(TypeId::kTypeInt)};
+  Row row(fields);
+  // two ints compare exactly, an int and a float up to 1e-3
+  ASSERT_TRUE(Predicate::MakeColumnCompare(1, kTypeInt, 2, kTypeInt, CompareOp::kGreater)->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeColumnCompare(0, kTypeInt, 3, kTypeFloat, CompareOp::kEqual)->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeColumnCompare(3, kTypeFloat, 0, kTypeInt, CompareOp::kGreaterEqual)->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeColumnCompare(4, kTypeChar, 5, kTypeChar, CompareOp::kLess)->Evaluate(row));
+  ASSERT_FALSE(Predicate::MakeColumnCompare(4, kTypeChar, 5, kTypeChar, CompareOp::kEqual)->Evaluate(row));
+  // mismatched types and nulls never match
+  ASSERT_FALSE(Predicate::MakeColumnCompare(0, kTypeInt, 4, kTypeChar, CompareOp::kNotEqual)->Evaluate(row));
+  ASSERT_FALSE(Predicate::MakeColumnCompare(0, kTypeInt, 6, kTypeInt, CompareOp::kNotEqual)->Evaluate(row));
+  ASSERT_FALSE(Predicate::MakeColumnCompare(6, kTypeInt, 0, kTypeInt, CompareOp::kNotEqual)->Evaluate(row));
+}
+
+TEST(PredicateTest, KernelTest) {
+  ASSERT_TRUE((ApplyCompare<CompareOp::kEqual, float>(1.0f, 1.0005f)));
+  ASSERT_FALSE((ApplyCompare<CompareOp::kNotEqual, float>(1.0f, 1.0005f)));
+  ASSERT_FALSE((ApplyCompare<CompareOp::kEqual, int32_t>(1, 2)));
+  ASSERT_TRUE((ApplyCompare<CompareOp::kGreaterEqual, int32_t>(2, 2)));
+  ASSERT_LT(CompareChars("ab", 2, "abc", 3), 0);
+  ASSERT_GT(CompareNumbers(1.0005f, 1.0f), 0);
+
+  // an int column is read as int, without going through TypeInt
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 7)};
+  Row row(fields);
+  ASSERT_TRUE(Predicate::MakeNumberCompare(0, kTypeInt, CompareOp::kEqual, 7)->Evaluate(row));
+  ASSERT_TRUE(Predicate::MakeNumberCompare(0, kTypeInt, CompareOp::kLess, 7.5f)->Evaluate(row));
+  ASSERT_FALSE(Predicate::MakeNumberCompare(0, kTypeInt, CompareOp::kGreater, 7)->Evaluate(row));
+
+  // integers above 2^24 are told apart, which they are not once converted to float
+  std::vector<Field> large_fields{Field(TypeId::kTypeInt, 16777217)};
+  Row large(large_fields);
+  ASSERT_TRUE(Predicate::MakeIntCompare(0, CompareOp::kGreater, 16777216)->Evaluate(large));
+  ASSERT_FALSE(Predicate::MakeIntCompare(0, CompareOp::kEqual, 16777216)->Evaluate(large));
+  ASSERT_TRUE(Predicate::MakeNumberCompare(0, kTypeInt, CompareOp::kEqual, 16777216.0f)->Evaluate(large));
+}
+
+TEST(PredicateTest, ConnectiveTest) {
+  // (v < 10 and name <> "name3") or v is null, folded like a where clause
+  auto predicate = Predicate::MakeOr(
+      Predicate::MakeAnd(Predicate::MakeNumberCompare(2, kTypeFloat, CompareOp::kLess, 10),
+                         Predicate::MakeTextCompare(1, CompareOp::kNotEqual, "name3")),
+      Predicate::MakeNullTest(2, true));
+  for (int i = 0; i < 1000; i++) {
+    std::string name = "name" + std::to_string(i % 10);
+    bool null_v = i % 7 == 0;
+    float v = static_cast<float>(i % 20);
+    Row row = MakeRow(i, name, null_v, v);
+    bool expected = (!null_v && v < 10 && name != "name3") || null_v;
+    ASSERT_EQ(expected, predicate->Evaluate(row)) << i;
+  }
+}
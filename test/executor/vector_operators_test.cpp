@@ -0,0 +1,148 @@
+#include "executor/vector_operators.h"
+#include <chrono>
+#include "common/instance.h"
+#include "executor/operators.h"
+#include "gtest/gtest.h"
+#include "utils/utils.h"
+
+static string db_file_name = "vector_operators_test.db";
+
+// a table of n rows (id float, name char(16), v float), v is null in every seventh row. The table
+// keeps using the schema, which must outlive it
+static TableInfo *CreateSampleTable(CatalogManager *catalog, SimpleMemHeap &heap, int n,
+                                    std::shared_ptr<Schema> &schema) {
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeFloat, 0, false, true),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 16, 1, true, false),
+                                   ALLOC_COLUMN(heap)("v", TypeId::kTypeFloat, 2, true, false)};
+  schema = std::make_shared<Schema>(columns);
+  schema->getPrimaryKeys().push_back(0);
+  TableInfo *table_info = nullptr;
+  EXPECT_EQ(DB_SUCCESS, catalog->CreateTable("t", schema.get(), nullptr, table_info));
+  auto table_heap = table_info->GetTableHeap();
+  for (int i = 0; i < n; i++) {
+    std::string name = "name" + std::to_string(i % 100);
+    std::vector<Field> fields{Field(TypeId::kTypeFloat, static_cast<float>(i)),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                              i % 7 == 0 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, i % 50 + 0.5f)};
+    Row row(fields);
+    EXPECT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  return table_info;
+}
+
+// count(*), sum(v), min(v), max(id), count(v), avg(v) where v < 10 and name <> "name3" or v is null, by batches
+static std::vector<float> RunVectorized(TableInfo *table_info) {
+  std::vector<VectorPredicate> predicates{{2, CompareOp::kLess, true, 10, ""},
+                                          {1, CompareOp::kNotEqual, false, 0, "name3"},
+                                          {2, CompareOp::kIsNull, true, 0, ""}};
+  auto filter = std::make_unique<VectorFilterOperator>(
+      std::make_unique<VectorScanOperator>(table_info->GetTableHeap(), table_info->GetSchema(),
+                                           std::vector<uint32_t>{0, 1, 2}),
+      predicates, std::vector<bool>{true, false});
+  VectorAggregateOperator aggregate(std::move(filter), {{AggregateType::kCount, -1},
+                                                        {AggregateType::kSum, 2},
+                                                        {AggregateType::kMin, 2},
+                                                        {AggregateType::kMax, 0},
+                                                        {AggregateType::kCount, 2},
+                                                        {AggregateType::kAvg, 2}});
+  EXPECT_EQ(DB_SUCCESS, aggregate.Init());
+  VectorBatch *batch = aggregate.NextBatch();
+  EXPECT_NE(nullptr, batch);
+  EXPECT_EQ(nullptr, aggregate.NextBatch());
+  return std::vector<float>{static_cast<float>(batch->columns[0].GetInts()[0]), batch->columns[1].GetFloats()[0],
+                            batch->columns[2].GetFloats()[0],  batch->columns[3].GetFloats()[0],
+                            static_cast<float>(batch->columns[4].GetInts()[0]), batch->columns[5].GetFloats()[0]};
+}
+
+// the same aggregates computed a row at a time
+static std::vector<float> RunRows(TableInfo *table_info) {
+  Field ten(TypeId::kTypeFloat, 10.0f);
+  Field name3(TypeId::kTypeChar, const_cast<char *>("name3"), 5, true);
+  FilterOperator filter(std::make_unique<SeqScanOperator>(table_info->GetTableHeap()), [&](const Row &row) {
+    Field *v = row.GetField(2);
+    return (v->CompareLessThan(ten) == kTrue && row.GetField(1)->CompareNotEquals(name3) == kTrue) || v->IsNull();
+  });
+  EXPECT_EQ(DB_SUCCESS, filter.Init());
+  float count = 0, sum = 0, min = 0, max = 0, seen = 0;
+  for (const Row *row = filter.Next(); row != nullptr; row = filter.Next()) {
+    count++;
+    max = std::max(max, row->GetField(0)->GetFloatData());
+    if (!row->GetField(2)->IsNull()) {
+      float v = row->GetField(2)->GetFloatData();
+      sum += v;
+      min = seen++ == 0 ? v : std::min(min, v);
+    }
+  }
+  return std::vector<float>{count, sum, min, max, seen, sum / seen};
+}
+
+TEST(VectorOperatorsTest, ScanFilterAggregateTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  const int n = 20000;
+  std::shared_ptr<Schema> schema;
+  TableInfo *table_info = CreateSampleTable(engine->catalog_mgr_, heap, n, schema);
+  auto table_heap = table_info->GetTableHeap();
+  // every row comes back once, with nulls in place
+  VectorScanOperator scan(table_heap, table_info->GetSchema(), {0, 2});
+  ASSERT_EQ(DB_SUCCESS, scan.Init());
+  size_t rows = 0, nulls = 0;
+  for (VectorBatch *batch = scan.NextBatch(); batch != nullptr; batch = scan.NextBatch()) {
+    ASSERT_EQ(2u, batch->columns.size());
+    for (uint32_t i = 0; i < batch->GetSize(); i++) {
+      int id = static_cast<int>(batch->columns[0].GetFloats()[i]);
+      ASSERT_EQ(id % 7 == 0, batch->columns[1].IsNull(i));
+      nulls += batch->columns[1].IsNull(i);
+    }
+    rows += batch->GetSize();
+  }
+  ASSERT_EQ(static_cast<size_t>(n), rows);
+  ASSERT_EQ(static_cast<size_t>((n + 6) / 7), nulls);
+
+  // the batches agree with the row at a time pipeline
+  auto vectorized = RunVectorized(table_info);
+  auto expected = RunRows(table_info);
+  ASSERT_EQ(expected.size(), vectorized.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_FLOAT_EQ(expected[i], vectorized[i]);
+  }
+
+  // projection gathers the selected rows densely
+  std::vector<VectorPredicate> predicates{{0, CompareOp::kGreaterEqual, true, static_cast<float>(n - 10), ""}};
+  VectorProjectionOperator projection(
+      std::make_unique<VectorFilterOperator>(
+          std::make_unique<VectorScanOperator>(table_heap, table_info->GetSchema(), std::vector<uint32_t>{0, 1}),
+          predicates, std::vector<bool>{}),
+      {1});
+  ASSERT_EQ(DB_SUCCESS, projection.Init());
+  rows = 0;
+  for (VectorBatch *batch = projection.NextBatch(); batch != nullptr; batch = projection.NextBatch()) {
+    ASSERT_EQ(1u, batch->columns.size());
+    for (uint32_t i = 0; i < batch->GetSize(); i++) {
+      std::string name(batch->columns[0].GetChars(i), batch->columns[0].GetCharLength(i));
+      ASSERT_EQ("name" + std::to_string((n - 10 + rows) % 100), name);
+      rows++;
+    }
+  }
+  ASSERT_EQ(10u, rows);
+  delete engine;
+  remove(db_file_name.c_str());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST(VectorOperatorsTest, DISABLED_ScanFilterAggregateBenchmark) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_file_name, true);
+  std::shared_ptr<Schema> schema;
+  TableInfo *table_info = CreateSampleTable(engine->catalog_mgr_, heap, 200000, schema);
+  auto start = std::chrono::steady_clock::now();
+  RunVectorized(table_info);
+  auto middle = std::chrono::steady_clock::now();
+  RunRows(table_info);
+  auto end = std::chrono::steady_clock::now();
+  std::cout << "vectorized: " << std::chrono::duration<double, std::milli>(middle - start).count()
+            << " ms, row at a time: " << std::chrono::duration<double, std::milli>(end - middle).count() << " ms"
+            << std::endl;
+  delete engine;
+  remove(db_file_name.c_str());
+}
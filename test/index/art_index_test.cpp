@@ -0,0 +1,163 @@
+#include "index/art_index.h"
+#include <map>
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "utils/utils.h"
+
+static std::string MakeKey(int value) {
+  // fixed width keys with a terminator, so that no key is a prefix of another
+  char buf[16];
+  snprintf(buf, sizeof(buf), "k%06d", value);
+  return std::string(buf) + '\x00';
+}
+
+TEST(ARTTests, SampleTest) {
+  AdaptiveRadixTree tree;
+  const int n = 30000;
+  vector<int> keys;
+  vector<int> delete_seq;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+    delete_seq.push_back(i);
+  }
+  ShuffleArray(keys);
+  ShuffleArray(delete_seq);
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.Insert(MakeKey(keys[i]), RowId(keys[i], 0)));
+  }
+  ASSERT_FALSE(tree.Insert(MakeKey(keys[0]), RowId(0, 1)));
+  ASSERT_EQ(static_cast<size_t>(n), tree.Size());
+  // ten digits per position give Node16, the rest of the kinds need wider fan out below
+  for (int byte = 0; byte < 256; byte++) {
+    ASSERT_TRUE(tree.Insert(std::string("w") + static_cast<char>(byte) + '\x00', RowId(-1, byte)));
+  }
+  for (int byte = 0; byte < 30; byte++) {
+    ASSERT_TRUE(tree.Insert(std::string("x") + static_cast<char>(byte) + '\x00', RowId(-2, byte)));
+  }
+  auto counts = tree.GetNodeCounts();
+  for (size_t count : counts) {
+    ASSERT_GT(count, 0u);
+  }
+  RowId value;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.Lookup(MakeKey(i), value));
+    ASSERT_EQ(i, value.GetPageId());
+  }
+  ASSERT_FALSE(tree.Lookup(MakeKey(n), value));
+  ASSERT_FALSE(tree.Lookup("k00", value));
+  // Range scan in key order
+  vector<RowId> result;
+  std::string low = MakeKey(1234), high = MakeKey(5678);
+  tree.Range(&low, &high, result);
+  ASSERT_EQ(5678u - 1234u + 1, result.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(1234 + static_cast<int>(i), result[i].GetPageId());
+  }
+  // Prefix scan selects the subtree below the prefix
+  result.clear();
+  tree.PrefixScan("k0012", result);
+  ASSERT_EQ(100u, result.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(1200 + static_cast<int>(i), result[i].GetPageId());
+  }
+  result.clear();
+  tree.PrefixScan("w", result);
+  ASSERT_EQ(256u, result.size());
+  // Delete half keys, nodes shrink back
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_TRUE(tree.Remove(MakeKey(delete_seq[i])));
+  }
+  ASSERT_FALSE(tree.Remove(MakeKey(delete_seq[0])));
+  for (int byte = 0; byte < 256; byte++) {
+    ASSERT_TRUE(tree.Remove(std::string("w") + static_cast<char>(byte) + '\x00'));
+  }
+  for (int byte = 0; byte < 30; byte++) {
+    ASSERT_TRUE(tree.Remove(std::string("x") + static_cast<char>(byte) + '\x00'));
+  }
+  counts = tree.GetNodeCounts();
+  ASSERT_EQ(0u, counts[2]);
+  ASSERT_EQ(0u, counts[3]);
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_FALSE(tree.Lookup(MakeKey(delete_seq[i]), value));
+  }
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(tree.Lookup(MakeKey(delete_seq[i]), value));
+    ASSERT_EQ(delete_seq[i], value.GetPageId());
+  }
+  result.clear();
+  tree.Range(nullptr, nullptr, result);
+  ASSERT_EQ(static_cast<size_t>(n - n / 2), result.size());
+  for (size_t i = 1; i < result.size(); i++) {
+    ASSERT_LT(result[i - 1].GetPageId(), result[i].GetPageId());
+  }
+  // removing every key leaves an empty tree
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(tree.Remove(MakeKey(delete_seq[i])));
+  }
+  ASSERT_EQ(0u, tree.Size());
+  for (size_t count : tree.GetNodeCounts()) {
+    ASSERT_EQ(0u, count);
+  }
+}
+
+TEST(ARTTests, ARTIndexTest) {
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 64, 1, true, false)
+  };
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{1, 0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  ARTIndex index(0, key_schema);
+  // keys sorted like the fields: name first, then signed id
+  std::map<std::pair<std::string, int>, RowId> expected;
+  const char *names[] = {"", "a", "ab", "b", "ba"};
+  for (int id = -300; id < 300; id += 7) {
+    for (int j = 0; j < 5; j++) {
+      std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(names[j]), strlen(names[j]), true),
+                                Field(TypeId::kTypeInt, id)};
+      RowId rid(id + 1000, j);
+      ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), rid, nullptr));
+      expected.emplace(std::make_pair(std::string(names[j]), id), rid);
+    }
+  }
+  std::vector<Field> dup_fields{Field(TypeId::kTypeChar, const_cast<char *>("a"), 1, true),
+                                Field(TypeId::kTypeInt, -300)};
+  ASSERT_EQ(DB_KEY_ALREADY_EXIST, index.InsertIfAbsent(Row(dup_fields), RowId(0, 0), nullptr));
+  ASSERT_EQ(expected.size(), index.GetSize());
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_SUCCESS, index.ScanRange(nullptr, nullptr, ret, nullptr));
+  ASSERT_EQ(expected.size(), ret.size());
+  size_t i = 0;
+  for (auto &it : expected) {
+    ASSERT_EQ(it.second.Get(), ret[i++].Get());
+  }
+  // all ids of one name, in id order
+  std::vector<Field> prefix_fields{Field(TypeId::kTypeChar, const_cast<char *>("a"), 1, true)};
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index.ScanPrefix(Row(prefix_fields), ret, nullptr));
+  ASSERT_EQ(expected.size() / 5, ret.size());
+  for (size_t j = 0; j < ret.size(); j++) {
+    ASSERT_EQ(-300 + 7 * static_cast<int>(j) + 1000, ret[j].GetPageId());
+    ASSERT_EQ(1u, ret[j].GetSlotNum());
+  }
+  // range over negative and positive ids
+  std::vector<Field> low_fields{Field(TypeId::kTypeChar, const_cast<char *>("b"), 1, true),
+                                Field(TypeId::kTypeInt, -20)};
+  std::vector<Field> high_fields{Field(TypeId::kTypeChar, const_cast<char *>("b"), 1, true),
+                                 Field(TypeId::kTypeInt, 20)};
+  Row low(low_fields), high(high_fields);
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index.ScanRange(&low, &high, ret, nullptr));
+  ASSERT_EQ(6u, ret.size());
+  ASSERT_EQ(-20 + 1000, ret[0].GetPageId());
+  ASSERT_EQ(15 + 1000, ret[5].GetPageId());
+  ASSERT_EQ(DB_SUCCESS, index.RemoveEntry(Row(dup_fields), RowId(700, 1), nullptr));
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index.ScanKey(Row(dup_fields), ret, nullptr));
+  ASSERT_TRUE(ret.empty());
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index.RemoveEntry(Row(dup_fields), RowId(700, 1), nullptr));
+  ASSERT_EQ(DB_SUCCESS, index.Destroy());
+  ASSERT_EQ(0u, index.GetSize());
+}
@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "index/b_plus_tree_index.h"
 #include "index/generic_key.h"
+#include "utils/utils.h"
 
 static const std::string db_name = "bp_tree_index_test.db";
 
@@ -78,4 +79,139 @@ TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
     ASSERT_EQ(i, (*iter).second.GetSlotNum());
     i++;
   }
-}
\ No newline at end of file
+}
+TEST(BPlusTreeTests, BPlusTreeIndexScanKeysTest) {
+  using INDEX_KEY_TYPE = GenericKey<32>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<32>;
+  using BP_TREE_INDEX = BPlusTreeIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 64, 1, true, false)
+  };
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  // even keys only, so that every other probe misses
+  const int n = 2000;
+  for (int i = 0; i < n; i += 2) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(row, RowId(1000, i), nullptr));
+  }
+  // probes in shuffled order, including keys past both ends
+  std::vector<int> probes;
+  for (int i = -5; i < n + 5; i++) {
+    probes.push_back(i);
+  }
+  ShuffleArray(probes);
+  std::vector<Row> keys;
+  keys.reserve(probes.size());
+  for (int probe : probes) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, probe)};
+    keys.emplace_back(fields);
+  }
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_SUCCESS, index->ScanKeys(keys, ret, nullptr));
+  ASSERT_EQ(probes.size(), ret.size());
+  for (size_t i = 0; i < probes.size(); i++) {
+    if (probes[i] >= 0 && probes[i] < n && probes[i] % 2 == 0) {
+      ASSERT_EQ(RowId(1000, probes[i]).Get(), ret[i].Get());
+    } else {
+      ASSERT_EQ(INVALID_ROWID.Get(), ret[i].Get());
+    }
+  }
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+TEST(BPlusTreeTests, ChangeBufferTest) {
+  using INDEX_KEY_TYPE = GenericKey<32>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<32>;
+  using BP_TREE_INDEX = BPlusTreeIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  // a pool much smaller than the tree, so that most leaves are not resident
+  DBStorageEngine engine(db_name, true, 32);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  index->EnableChangeBuffer(512);
+  const int n = 20000;
+  std::vector<int> keys;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+  }
+  ShuffleArray(keys);
+  size_t max_buffered = 0;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, keys[i])};
+    ASSERT_EQ(DB_SUCCESS, index->InsertIfAbsent(Row(fields), RowId(1000, keys[i]), nullptr));
+    max_buffered = std::max(max_buffered, index->GetBufferedCount());
+  }
+  ASSERT_GT(max_buffered, 0u);
+  ASSERT_LT(max_buffered, 512u);
+  // a duplicate is found even while its first insert may still be buffered
+  for (int i = n - 100; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, keys[i])};
+    ASSERT_EQ(DB_KEY_ALREADY_EXIST, index->InsertIfAbsent(Row(fields), RowId(1000, 0), nullptr));
+  }
+  std::vector<RowId> ret;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(Row(fields), ret, nullptr));
+    ASSERT_EQ(1u, ret.size());
+    ASSERT_EQ(RowId(1000, i).Get(), ret[0].Get());
+  }
+  // removes merge the pending inserts of the leaves they touch
+  for (int i = 0; i < n; i += 2) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(Row(fields), RowId(1000, i), nullptr));
+  }
+  for (int i = n; i < n + 1000; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index->InsertIfAbsent(Row(fields), RowId(1000, i), nullptr));
+  }
+  // a range scan sees buffered inserts as well
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanRange(nullptr, nullptr, ret, nullptr));
+  ASSERT_EQ(static_cast<size_t>(n / 2 + 1000), ret.size());
+  for (size_t i = 0; i < ret.size(); i++) {
+    int key = i < static_cast<size_t>(n / 2) ? static_cast<int>(2 * i + 1) : static_cast<int>(n + i - n / 2);
+    ASSERT_EQ(RowId(1000, key).Get(), ret[i].Get());
+  }
+  ASSERT_EQ(DB_SUCCESS, index->Flush());
+  ASSERT_EQ(0u, index->GetBufferedCount());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+TEST(BPlusTreeTests, ChangeBufferFloatKeyTest) {
+  using INDEX_KEY_TYPE = GenericKey<32>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<32>;
+  using BP_TREE_INDEX = BPlusTreeIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  DBStorageEngine engine(db_name, true, 32);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("score", TypeId::kTypeFloat, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  index->EnableChangeBuffer(512);
+  // 0.0 goes first, its leaf is evicted by the inserts after it
+  const int n = 20000;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeFloat, static_cast<float>(i))};
+    ASSERT_EQ(DB_SUCCESS, index->InsertIfAbsent(Row(fields), RowId(1000, i), nullptr));
+  }
+  // -0.0 equals 0.0 though its bytes differ, so it is a duplicate rather than a new key to buffer
+  std::vector<Field> negative_zero{Field(TypeId::kTypeFloat, -0.0f)};
+  ASSERT_EQ(DB_KEY_ALREADY_EXIST, index->InsertIfAbsent(Row(negative_zero), RowId(1000, n), nullptr));
+  ASSERT_EQ(DB_SUCCESS, index->Flush());
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_SUCCESS, index->ScanRange(nullptr, nullptr, ret, nullptr));
+  ASSERT_EQ(static_cast<size_t>(n), ret.size());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
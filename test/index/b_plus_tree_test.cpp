@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "index/b_plus_tree.h"
 #include "common/instance.h"
 #include "gtest/gtest.h"
@@ -61,4 +63,219 @@ TEST(BPlusTreeTests, SampleTest) {
     ASSERT_TRUE(tree.GetValue(delete_seq[i], ans));
     ASSERT_EQ(kv_map[delete_seq[i]], ans[ans.size() - 1]);
   }
-}
\ No newline at end of file
+}
+TEST(BPlusTreeTests, InsertIfAbsentTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 4, 4);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(tree.InsertIfAbsent(i, i * 10));
+  }
+  // existing keys are reported with their stored value and left unchanged
+  for (int i = 0; i < 100; i++) {
+    int existing = -1;
+    ASSERT_FALSE(tree.InsertIfAbsent(i, -i, &existing));
+    ASSERT_EQ(i * 10, existing);
+  }
+  vector<int> ans;
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(tree.GetValue(i, ans));
+    ASSERT_EQ(i * 10, ans.back());
+  }
+  ASSERT_TRUE(tree.Check());
+}
+
+TEST(BPlusTreeTests, DestroyTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  auto meta_page = reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData());
+  const uint32_t allocated = meta_page->GetAllocatedPages();
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 4, 4);
+  const int n = 2000;
+  for (int i = 0; i < n; i++) {
+    tree.Insert(i, i);
+  }
+  const uint32_t tree_pages = meta_page->GetAllocatedPages() - allocated;
+  ASSERT_GT(tree_pages, 0u);
+  // every leaf and internal page is released
+  tree.Destroy();
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_EQ(allocated, meta_page->GetAllocatedPages());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+  vector<int> ans;
+  ASSERT_FALSE(tree.GetValue(0, ans));
+  // a tree reopened with the same id starts empty
+  BPlusTree<int, int, BasicComparator<int>> reopened(0, engine.bpm_, comparator, 4, 4);
+  ASSERT_TRUE(reopened.IsEmpty());
+  // the freed pages are reused by the next tree
+  for (int i = 0; i < n; i++) {
+    tree.Insert(i, i);
+  }
+  ASSERT_EQ(allocated + tree_pages, meta_page->GetAllocatedPages());
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(i, ans));
+  }
+  ASSERT_TRUE(tree.Check());
+}
+
+TEST(BPlusTreeTests, RightEdgeAppendTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> ascending(0, engine.bpm_, comparator, 100, 100);
+  BPlusTree<int, int, BasicComparator<int>> shuffled(1, engine.bpm_, comparator, 100, 100);
+  const int n = 10000;
+  vector<int> keys;
+  for (int i = 0; i < n; i++) {
+    ascending.Insert(i, i);
+    keys.push_back(i);
+  }
+  ShuffleArray(keys);
+  for (int i = 0; i < n; i++) {
+    shuffled.Insert(keys[i], keys[i]);
+  }
+  ASSERT_TRUE(ascending.Check());
+  ASSERT_TRUE(shuffled.Check());
+  // appends leave the left page of every split 90% full
+  auto stats = ascending.GetStatistics();
+  ASSERT_EQ(static_cast<size_t>(n), stats.entries);
+  ASSERT_GT(stats.leaf_fill_factor, 0.85);
+  auto shuffled_stats = shuffled.GetStatistics();
+  ASSERT_EQ(static_cast<size_t>(n), shuffled_stats.entries);
+  ASSERT_LT(stats.leaf_pages, shuffled_stats.leaf_pages);
+  vector<int> ans;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(ascending.GetValue(i, ans));
+    ASSERT_EQ(i, ans.back());
+  }
+  int expected = 0;
+  for (auto iter = ascending.Begin(); iter != ascending.End(); ++iter) {
+    ASSERT_EQ(expected++, (*iter).first);
+  }
+  ASSERT_EQ(n, expected);
+  // keys below the max and removals that merge the right most leaf fall back to the descent
+  for (int i = n - 1; i >= n - 500; i--) {
+    ascending.Remove(i);
+  }
+  for (int i = -1; i >= -100; i--) {
+    ASSERT_TRUE(ascending.Insert(i, i));
+  }
+  for (int i = n - 500; i < n + 500; i++) {
+    ASSERT_TRUE(ascending.Insert(i, i));
+  }
+  ASSERT_FALSE(ascending.Insert(n, n));
+  for (int i = -100; i < n + 500; i++) {
+    ASSERT_TRUE(ascending.GetValue(i, ans));
+    ASSERT_EQ(i, ans.back());
+  }
+  ASSERT_TRUE(ascending.Check());
+}
+
+TEST(BPlusTreeTests, NodeCacheTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 100, 100);
+  tree.EnableNodeCache(2);
+  const int n = 10000;
+  vector<int> keys;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+  }
+  ShuffleArray(keys);
+  for (int i = 0; i < n; i++) {
+    tree.Insert(keys[i], keys[i]);
+  }
+  auto stats = tree.GetStatistics();
+  ASSERT_EQ(3, stats.height);
+  // after a lookup every internal page stays pinned and nothing else does
+  vector<int> ans;
+  ASSERT_TRUE(tree.GetValue(0, ans));
+  ASSERT_EQ(stats.internal_pages, DEFAULT_BUFFER_POOL_SIZE - engine.bpm_->GetFreeSize());
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(i, ans));
+    ASSERT_EQ(i, ans.back());
+  }
+  ASSERT_EQ(stats.internal_pages, DEFAULT_BUFFER_POOL_SIZE - engine.bpm_->GetFreeSize());
+  // splits and merges drop the cache, lookups see the new structure
+  for (int i = 0; i < n / 2; i++) {
+    tree.Remove(keys[i]);
+  }
+  for (int i = n; i < 2 * n; i++) {
+    tree.Insert(i, i);
+  }
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_FALSE(tree.GetValue(keys[i], ans));
+  }
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(keys[i], ans));
+    ASSERT_EQ(keys[i], ans.back());
+  }
+  for (int i = n; i < 2 * n; i++) {
+    ASSERT_TRUE(tree.GetValue(i, ans));
+  }
+  ASSERT_TRUE(tree.Check());
+  tree.Destroy();
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+// a deep tree of n shuffled keys, most of a lookup is spent moving between pages
+static void FillDeepTree(BPlusTree<int, int, BasicComparator<int>> &tree, vector<int> &keys, int n) {
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+  }
+  ShuffleArray(keys);
+  for (int i = 0; i < n; i++) {
+    tree.Insert(keys[i], i);
+  }
+}
+
+TEST(BPlusTreeTests, SwizzlingTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 16, 16);
+  const int n = 100000;
+  vector<int> keys;
+  FillDeepTree(tree, keys, n);
+  ASSERT_GE(tree.GetStatistics().height, 5);
+  auto run = [&](bool swizzling) {
+    engine.bpm_->SetSwizzling(swizzling);
+    vector<int> ans;
+    for (int i = 0; i < n; i++) {
+      tree.GetValue(keys[i], ans);
+    }
+    return ans;
+  };
+  // the first round swizzles the references, the second one follows them
+  auto plain = run(false);
+  run(true);
+  auto swizzled = run(true);
+  ASSERT_EQ(plain, swizzled);
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i, swizzled[i]);
+  }
+  ASSERT_TRUE(tree.Check());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST(BPlusTreeTests, DISABLED_SwizzlingBenchmark) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 16, 16);
+  const int n = 100000;
+  vector<int> keys;
+  FillDeepTree(tree, keys, n);
+  auto run = [&](bool swizzling) {
+    engine.bpm_->SetSwizzling(swizzling);
+    vector<int> ans;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+      tree.GetValue(keys[i], ans);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << (swizzling ? "swizzled" : "page table") << " lookups: " << n / elapsed.count() << " per second"
+              << std::endl;
+  };
+  // the first round warms the buffer pool and swizzles the references
+  run(true);
+  run(false);
+  run(true);
+}
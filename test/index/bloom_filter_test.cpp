@@ -0,0 +1,105 @@
+#include "index/bloom_filter.h"
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree_index.h"
+#include "index/generic_key.h"
+
+static const std::string db_name = "bloom_filter_test.db";
+
+TEST(BloomFilterTests, SampleTest) {
+  const int n = 10000;
+  BloomFilter filter(n);
+  for (int i = 0; i < n; i++) {
+    filter.Add(reinterpret_cast<const char *>(&i), sizeof(i));
+  }
+  ASSERT_EQ(static_cast<size_t>(n), filter.GetKeyCount());
+  // no false negative
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(filter.MayContain(reinterpret_cast<const char *>(&i), sizeof(i)));
+  }
+  // false positive rate stays around 1%
+  int false_positive = 0;
+  for (int i = n; i < 2 * n; i++) {
+    false_positive += filter.MayContain(reinterpret_cast<const char *>(&i), sizeof(i));
+  }
+  ASSERT_LT(false_positive, n / 20);
+  filter.Reset(n);
+  ASSERT_EQ(0u, filter.GetKeyCount());
+}
+
+TEST(BloomFilterTests, BPlusTreeIndexFilterTest) {
+  using INDEX_KEY_TYPE = GenericKey<32>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<32>;
+  using BP_TREE_INDEX = BPlusTreeIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  // insert past the initial capacity so the filter is rebuilt larger
+  const int n = 3000;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(fields), RowId(1000, i), nullptr));
+  }
+  INDEX_KEY_TYPE key;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    key.SerializeFromKey(Row(fields), index_schema);
+    ASSERT_TRUE(index->MayContain(key));
+  }
+  // remove most keys, the filter is rebuilt and scans stay exact
+  for (int i = 0; i < n - 10; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(Row(fields), RowId(1000, i), nullptr));
+  }
+  int filtered = 0;
+  std::vector<RowId> ret;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    key.SerializeFromKey(row, index_schema);
+    filtered += !index->MayContain(key);
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(row, ret, nullptr));
+    ASSERT_EQ(i >= n - 10 ? 1u : 0u, ret.size());
+  }
+  ASSERT_GT(filtered, n / 2);
+  // a new index object on the same tree builds its filter from the leaves on its first probe
+  auto *reloaded = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  for (int i = n - 10; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    key.SerializeFromKey(Row(fields), index_schema);
+    ASSERT_TRUE(reloaded->MayContain(key));
+  }
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+TEST(BloomFilterTests, CanonicalKeyTest) {
+  using INDEX_KEY_TYPE = GenericKey<32>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<32>;
+  using BP_TREE_INDEX = BPlusTreeIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("score", TypeId::kTypeFloat, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeFloat, static_cast<float>(i))};
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(fields), RowId(1000, i), nullptr));
+  }
+  // -0.0 has other bytes than the stored 0.0 but compares equal to it, in this index and in a reloaded one
+  std::vector<Field> negative_zero{Field(TypeId::kTypeFloat, -0.0f)};
+  auto *reloaded = ALLOC(heap, BP_TREE_INDEX)(0, index_schema, engine.bpm_);
+  for (auto *probed : {index, reloaded}) {
+    std::vector<RowId> ret;
+    ASSERT_EQ(DB_SUCCESS, probed->ScanKey(Row(negative_zero), ret, nullptr));
+    ASSERT_EQ(1u, ret.size());
+    ASSERT_EQ(RowId(1000, 0).Get(), ret[0].Get());
+  }
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
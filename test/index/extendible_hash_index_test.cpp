@@ -0,0 +1,196 @@
+#include "index/extendible_hash_index.h"
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/basic_comparator.h"
+#include "index/generic_key.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "hash_index_test.db";
+
+TEST(ExtendibleHashTests, SampleTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  ExtendibleHashTable<int, int, BasicComparator<int>> table(0, engine.bpm_, comparator);
+  const int n = 10000;
+  vector<int> keys;
+  vector<int> delete_seq;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+    delete_seq.push_back(i);
+  }
+  ShuffleArray(keys);
+  ShuffleArray(delete_seq);
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(table.Insert(keys[i], keys[i] * 2));
+  }
+  ASSERT_FALSE(table.Insert(keys[0], 0));
+  ASSERT_TRUE(table.Check());
+  // buckets must have split to hold all keys
+  ASSERT_GT(table.GetGlobalDepth(), 0u);
+  vector<int> ans;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(table.GetValue(i, ans));
+    ASSERT_EQ(i * 2, ans.back());
+  }
+  ASSERT_TRUE(table.Check());
+  // Delete half keys
+  for (int i = 0; i < n / 2; i++) {
+    table.Remove(delete_seq[i]);
+  }
+  ans.clear();
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_FALSE(table.GetValue(delete_seq[i], ans));
+  }
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(table.GetValue(delete_seq[i], ans));
+    ASSERT_EQ(delete_seq[i] * 2, ans.back());
+  }
+  // Delete the rest, the directory shrinks back to a single bucket
+  for (int i = n / 2; i < n; i++) {
+    table.Remove(delete_seq[i]);
+  }
+  ASSERT_EQ(0u, table.GetGlobalDepth());
+  ASSERT_TRUE(table.Check());
+  table.Destroy();
+  ASSERT_TRUE(table.IsEmpty());
+  ASSERT_TRUE(table.Check());
+}
+
+TEST(ExtendibleHashTests, HashIndexSimpleTest) {
+  using INDEX_KEY_TYPE = GenericKey<32>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<32>;
+  using HASH_INDEX = ExtendibleHashIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 64, 1, true, false),
+          ALLOC_COLUMN(heap)("account", TypeId::kTypeFloat, 2, true, false)
+  };
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, HASH_INDEX)(0, index_schema, engine.bpm_);
+  const int n = 1000;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    RowId rid(1000, i);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(row, rid, nullptr));
+  }
+  std::vector<Field> dup_fields{Field(TypeId::kTypeInt, 0)};
+  Row dup(dup_fields);
+  ASSERT_EQ(DB_FAILED, index->InsertEntry(dup, RowId(1000, 0), nullptr));
+  // Test Scan
+  std::vector<RowId> ret;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    RowId rid(1000, i);
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(row, ret, nullptr));
+    ASSERT_EQ(rid.Get(), ret[i].Get());
+  }
+  // Test Remove
+  for (int i = 0; i < n; i += 2) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(row, RowId(1000, i), nullptr));
+  }
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(row, ret, nullptr));
+    ASSERT_EQ(i % 2 == 0 ? 0u : 1u, ret.size());
+  }
+  ASSERT_EQ(DB_SUCCESS, index->Destroy());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+TEST(ExtendibleHashTests, HashIndexOverflowTest) {
+  using INDEX_KEY_TYPE = GenericKey<64>;
+  using INDEX_COMPARATOR_TYPE = GenericComparator<64>;
+  using HASH_INDEX = ExtendibleHashIndex<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  using HASH_TABLE = ExtendibleHashTable<INDEX_KEY_TYPE, RowId, INDEX_COMPARATOR_TYPE>;
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("account", TypeId::kTypeFloat, 1, true, false)
+  };
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, HASH_INDEX)(0, index_schema, engine.bpm_);
+  // far more keys than 512 buckets hold, the buckets at max depth chain overflow pages
+  const int n = 512 * 56 * 2 + 1000;
+  std::vector<int> keys;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+  }
+  ShuffleArray(keys);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, keys[i])};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(row, RowId(keys[i], 0), nullptr));
+  }
+  std::vector<Field> dup_fields{Field(TypeId::kTypeInt, keys[n - 1])};
+  Row dup(dup_fields);
+  ASSERT_EQ(DB_KEY_ALREADY_EXIST, index->InsertIfAbsent(dup, RowId(0, 0), nullptr));
+  HASH_TABLE table(0, engine.bpm_, INDEX_COMPARATOR_TYPE(index_schema));
+  ASSERT_EQ(static_cast<uint32_t>(DIRECTORY_MAX_DEPTH), table.GetGlobalDepth());
+  std::vector<RowId> ret;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(row, ret, nullptr));
+    ASSERT_EQ(1u, ret.size());
+    ASSERT_EQ(i, ret[0].GetPageId());
+  }
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+  // removing from a chain keeps every other key reachable
+  for (int i = 0; i < n; i += 2) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, keys[i])};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(row, RowId(keys[i], 0), nullptr));
+  }
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, keys[i])};
+    Row row(fields);
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(row, ret, nullptr));
+    ASSERT_EQ(i % 2 == 0 ? 0u : 1u, ret.size());
+  }
+  for (int i = 1; i < n; i += 2) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, keys[i])};
+    Row row(fields);
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(row, RowId(keys[i], 0), nullptr));
+  }
+  ASSERT_EQ(0u, table.GetGlobalDepth());
+  ASSERT_EQ(DB_SUCCESS, index->Destroy());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+TEST(ExtendibleHashTests, HashIndexFloatKeyTest) {
+  using HASH_INDEX = ExtendibleHashIndex<GenericKey<16>, RowId, GenericComparator<16>>;
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("account", TypeId::kTypeFloat, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  auto *index = ALLOC(heap, HASH_INDEX)(0, index_schema, engine.bpm_);
+  std::vector<Field> zero_fields{Field(TypeId::kTypeFloat, 0.0f)};
+  Row zero(zero_fields);
+  ASSERT_EQ(DB_SUCCESS, index->InsertEntry(zero, RowId(1, 0), nullptr));
+  // -0.0 equals 0.0 and must hash to the same bucket
+  std::vector<Field> negative_zero_fields{Field(TypeId::kTypeFloat, -0.0f)};
+  Row negative_zero(negative_zero_fields);
+  ASSERT_EQ(DB_KEY_ALREADY_EXIST, index->InsertIfAbsent(negative_zero, RowId(2, 0), nullptr));
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(negative_zero, ret, nullptr));
+  ASSERT_EQ(1u, ret.size());
+  ASSERT_EQ(DB_SUCCESS, index->Destroy());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
@@ -33,3 +33,30 @@ TEST(BPlusTreeTests, IndexIteratorTest) {
     EXPECT_EQ(ans * 100, (*iter).second);
   }
 }
+
+TEST(BPlusTreeTests, IndexIteratorFullScanTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 4, 4);
+  ASSERT_TRUE(tree.Begin() == tree.End());
+  for (int i = 1; i <= 100; i++) {
+    tree.Insert(i, i * 100, nullptr);
+  }
+  // the last entry is visited and every leaf is unpinned afterwards
+  int ans = 1;
+  {
+    auto end = tree.End();
+    for (auto iter = tree.Begin(); iter != end; ++iter, ans++) {
+      ASSERT_EQ(ans, (*iter).first);
+    }
+  }
+  ASSERT_EQ(101, ans);
+  ASSERT_TRUE(tree.Check());
+  // start from a key
+  ans = 40;
+  for (auto iter = tree.Begin(40); iter != tree.End(); ++iter, ans++) {
+    ASSERT_EQ(ans, (*iter).first);
+  }
+  ASSERT_EQ(101, ans);
+  ASSERT_TRUE(tree.Check());
+}
@@ -0,0 +1,154 @@
+#include "index/lsm_index.h"
+#include <set>
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/generic_key.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "lsm_index_test.db";
+
+using LSM_KEY_TYPE = GenericKey<16>;
+using LSM_COMPARATOR_TYPE = GenericComparator<16>;
+
+static LSM_KEY_TYPE MakeKey(int value, Schema *key_schema) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  LSM_KEY_TYPE key;
+  key.SerializeFromKey(Row(fields), key_schema);
+  return key;
+}
+
+TEST(LSMTreeTests, SampleTest) {
+  DBStorageEngine engine(db_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  LSM_COMPARATOR_TYPE comparator(key_schema);
+  uint32_t allocated = reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData())->GetAllocatedPages();
+  // small memtable and fanout, so that runs are flushed and merged over several levels
+  LSMTree<LSM_KEY_TYPE, RowId, LSM_COMPARATOR_TYPE> tree(0, engine.bpm_, comparator, 64, 4);
+  const int n = 5000;
+  vector<int> keys;
+  vector<int> delete_seq;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+    delete_seq.push_back(i);
+  }
+  ShuffleArray(keys);
+  ShuffleArray(delete_seq);
+  for (int i = 0; i < n; i++) {
+    tree.Insert(MakeKey(keys[i], key_schema), RowId(keys[i], 0));
+  }
+  ASSERT_FALSE(tree.InsertIfAbsent(MakeKey(keys[0], key_schema), RowId(0, 1)));
+  ASSERT_TRUE(tree.Check());
+  // 5000 / 64 flushes leave at most fanout - 1 runs per level
+  ASSERT_GT(tree.GetRunCount(), 0u);
+  ASSERT_LT(tree.GetRunCount(), 16u);
+  vector<RowId> ans;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(MakeKey(i, key_schema), ans));
+    ASSERT_EQ(i, ans.back().GetPageId());
+  }
+  ASSERT_TRUE(tree.Check());
+  // Delete half keys
+  for (int i = 0; i < n / 2; i++) {
+    tree.Remove(MakeKey(delete_seq[i], key_schema));
+  }
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_FALSE(tree.GetValue(MakeKey(delete_seq[i], key_schema), ans));
+  }
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(MakeKey(delete_seq[i], key_schema), ans));
+    ASSERT_EQ(delete_seq[i], ans.back().GetPageId());
+  }
+  // a removed key can be inserted again
+  ASSERT_TRUE(tree.InsertIfAbsent(MakeKey(delete_seq[0], key_schema), RowId(delete_seq[0], 0)));
+  // Range scan sees every live key once and in order
+  std::vector<std::pair<LSM_KEY_TYPE, RowId>> range;
+  LSM_KEY_TYPE low = MakeKey(1000, key_schema), high = MakeKey(1999, key_schema);
+  tree.GetRange(&low, &high, range);
+  std::set<int> live(delete_seq.begin() + n / 2, delete_seq.end());
+  live.insert(delete_seq[0]);
+  std::vector<int> expected;
+  for (int key : live) {
+    if (key >= 1000 && key <= 1999) {
+      expected.push_back(key);
+    }
+  }
+  ASSERT_EQ(expected.size(), range.size());
+  for (size_t i = 0; i < range.size(); i++) {
+    ASSERT_EQ(expected[i], range[i].second.GetPageId());
+  }
+  // a tree opened on the same index id finds the flushed runs
+  tree.Flush();
+  ASSERT_EQ(0u, tree.GetMemtableSize());
+  LSMTree<LSM_KEY_TYPE, RowId, LSM_COMPARATOR_TYPE> reopened(0, engine.bpm_, comparator, 64, 4);
+  ASSERT_EQ(tree.GetRunCount(), reopened.GetRunCount());
+  for (int i = 0; i < n; i++) {
+    ans.clear();
+    ASSERT_EQ(live.count(i) == 1, reopened.GetValue(MakeKey(i, key_schema), ans));
+  }
+  ASSERT_TRUE(tree.Check());
+  // Destroy releases every run and the manifest
+  tree.Destroy();
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_TRUE(tree.Check());
+  ASSERT_EQ(allocated, reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData())->GetAllocatedPages());
+}
+
+TEST(LSMTreeTests, LSMIndexPersistTest) {
+  using LSM_INDEX = LSMIndex<LSM_KEY_TYPE, RowId, LSM_COMPARATOR_TYPE>;
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 64, 1, true, false)
+  };
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map, &heap);
+  const int n = 10000;
+  {
+    DBStorageEngine engine(db_name);
+    auto *index = ALLOC(heap, LSM_INDEX)(0, index_schema, engine.bpm_);
+    for (int i = 0; i < n; i++) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+      ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(fields), RowId(1000, i), nullptr));
+    }
+    std::vector<Field> dup_fields{Field(TypeId::kTypeInt, 0)};
+    ASSERT_EQ(DB_KEY_ALREADY_EXIST, index->InsertIfAbsent(Row(dup_fields), RowId(1000, 0), nullptr));
+    for (int i = 0; i < n; i += 2) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+      ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(Row(fields), RowId(1000, i), nullptr));
+    }
+    ASSERT_EQ(DB_SUCCESS, index->Flush());
+    ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+  }
+  // reopen the database, the runs are found through the index roots page
+  DBStorageEngine engine(db_name, false);
+  auto *index = ALLOC(heap, LSM_INDEX)(0, index_schema, engine.bpm_);
+  std::vector<RowId> ret;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(Row(fields), ret, nullptr));
+    ASSERT_EQ(i % 2 == 0 ? 0u : 1u, ret.size());
+    if (!ret.empty()) {
+      ASSERT_EQ(RowId(1000, i).Get(), ret[0].Get());
+    }
+  }
+  std::vector<Field> low_fields{Field(TypeId::kTypeInt, 100)};
+  std::vector<Field> high_fields{Field(TypeId::kTypeInt, 199)};
+  Row low(low_fields), high(high_fields);
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanRange(&low, &high, ret, nullptr));
+  ASSERT_EQ(50u, ret.size());
+  for (size_t i = 0; i < ret.size(); i++) {
+    ASSERT_EQ(RowId(1000, 101 + 2 * i).Get(), ret[i].Get());
+  }
+  ASSERT_EQ(DB_SUCCESS, index->Destroy());
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanRange(nullptr, nullptr, ret, nullptr));
+  ASSERT_TRUE(ret.empty());
+  remove(db_name.c_str());
+}
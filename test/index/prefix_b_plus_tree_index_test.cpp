@@ -0,0 +1,207 @@
+#include "index/prefix_b_plus_tree_index.h"
+#include <set>
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "prefix_b_plus_tree_index_test.db";
+
+// URL keys of 40 tenants, sharing all but their last few bytes with their neighbours
+static std::string MakeUrl(int value) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "https://example.com/tenant-%04d/item-%06d", value / 500, value);
+  return buf;
+}
+
+static Row MakeRow(const Field &field) {
+  std::vector<Field> fields;
+  fields.push_back(field);
+  return Row(fields);
+}
+
+TEST(PrefixBPlusTreeTests, SampleTest) {
+  DBStorageEngine engine(db_name);
+  PrefixBPlusTree tree(0, engine.bpm_);
+  const int n = 20000;
+  vector<int> keys;
+  vector<int> delete_seq;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+    delete_seq.push_back(i);
+  }
+  ShuffleArray(keys);
+  ShuffleArray(delete_seq);
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.Insert(MakeUrl(keys[i]), RowId(keys[i], 0)));
+  }
+  ASSERT_FALSE(tree.Insert(MakeUrl(keys[0]), RowId(0, 1)));
+  RowId value;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(MakeUrl(i), value));
+    ASSERT_EQ(i, value.GetPageId());
+  }
+  ASSERT_FALSE(tree.GetValue(MakeUrl(n), value));
+  ASSERT_FALSE(tree.GetValue("https://example.com/", value));
+  // the 43 byte keys keep about 6 bytes per slot, a fixed 64 byte key slot fits 56 entries in a leaf
+  BPlusTreeStatistics stats = tree.GetStatistics();
+  ASSERT_EQ(static_cast<size_t>(n), stats.entries);
+  ASSERT_GT(stats.entries / stats.leaf_pages, 100u);
+  ASSERT_LE(stats.height, 3);
+
+  // Range scan in key order, bounds need not be keys
+  vector<RowId> result;
+  std::string low = MakeUrl(1234), high = MakeUrl(5678);
+  tree.Range(&low, &high, result);
+  ASSERT_EQ(5678u - 1234u + 1, result.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(1234 + static_cast<int>(i), result[i].GetPageId());
+  }
+  result.clear();
+  low = "https://example.com/tenant-0003";
+  high = "https://example.com/tenant-0004";
+  tree.Range(&low, &high, result);
+  ASSERT_EQ(500u, result.size());
+  ASSERT_EQ(1500, result.front().GetPageId());
+
+  // Delete half keys
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_TRUE(tree.Remove(MakeUrl(delete_seq[i])));
+  }
+  ASSERT_FALSE(tree.Remove(MakeUrl(delete_seq[0])));
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_FALSE(tree.GetValue(MakeUrl(delete_seq[i]), value));
+  }
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(MakeUrl(delete_seq[i]), value));
+    ASSERT_EQ(delete_seq[i], value.GetPageId());
+  }
+  result.clear();
+  tree.Range(nullptr, nullptr, result);
+  std::set<int> live(delete_seq.begin() + n / 2, delete_seq.end());
+  ASSERT_EQ(live.size(), result.size());
+  auto it = live.begin();
+  for (size_t i = 0; i < result.size(); i++, it++) {
+    ASSERT_EQ(*it, result[i].GetPageId());
+  }
+
+  // the root is kept in the index roots page
+  PrefixBPlusTree reopened(0, engine.bpm_);
+  ASSERT_TRUE(reopened.GetValue(MakeUrl(delete_seq[n - 1]), value));
+  ASSERT_EQ(delete_seq[n - 1], value.GetPageId());
+  tree.Destroy();
+  ASSERT_TRUE(tree.IsEmpty());
+  remove(db_name.c_str());
+}
+
+TEST(PrefixBPlusTreeTests, SuffixTruncationTest) {
+  DBStorageEngine engine(db_name);
+  PrefixBPlusTree tree(0, engine.bpm_);
+  // 210 byte keys that differ in their first 9 bytes, so a separator needs at most 9 of them
+  const int n = 2000;
+  vector<int> keys;
+  for (int i = 0; i < n; i++) {
+    keys.push_back(i);
+  }
+  ShuffleArray(keys);
+  auto make_key = [](int value) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "user%05d", value);
+    return std::string(buf) + '/' + std::string(200, 'x');
+  };
+  for (int key : keys) {
+    ASSERT_TRUE(tree.Insert(make_key(key), RowId(key, 0)));
+  }
+  page_id_t page_id = tree.GetRootPageId();
+  auto *root = reinterpret_cast<PrefixBPlusTreePage *>(engine.bpm_->FetchPage(page_id)->GetData());
+  ASSERT_FALSE(root->IsLeafPage());
+  ASSERT_GT(root->GetSize(), 1);
+  for (int i = 1; i < root->GetSize(); i++) {
+    ASSERT_LE(root->KeyAt(i).size(), 9u);
+  }
+  // a leaf stores the bytes its keys share once
+  page_id_t child = root->ChildAt(1);
+  engine.bpm_->UnpinPage(page_id, false);
+  auto *page = reinterpret_cast<PrefixBPlusTreePage *>(engine.bpm_->FetchPage(child)->GetData());
+  while (!page->IsLeafPage()) {
+    page_id_t next = page->ChildAt(0);
+    engine.bpm_->UnpinPage(child, false);
+    child = next;
+    page = reinterpret_cast<PrefixBPlusTreePage *>(engine.bpm_->FetchPage(child)->GetData());
+  }
+  ASSERT_GE(page->GetPrefixLength(), 5u);
+  engine.bpm_->UnpinPage(child, false);
+  RowId value;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(make_key(i), value));
+    ASSERT_EQ(i, value.GetPageId());
+  }
+  ASSERT_EQ("user0", PrefixBPlusTree::ShortestSeparator("user", "user01"));
+  ASSERT_EQ("b", PrefixBPlusTree::ShortestSeparator("abc", "bcd"));
+  tree.Destroy();
+  remove(db_name.c_str());
+}
+
+TEST(PrefixBPlusTreeTests, IndexTest) {
+  SimpleMemHeap heap;
+  auto engine = new DBStorageEngine(db_name, true);
+  auto &catalog = engine->catalog_mgr_;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("url", TypeId::kTypeChar, 64, 0, false, true),
+                                   ALLOC_COLUMN(heap)("score", TypeId::kTypeFloat, 1, false, true)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("pages", schema.get(), nullptr, table_info));
+  // replace the b+ tree indexes created for the unique columns
+  ASSERT_EQ(DB_SUCCESS, catalog->DropIndex("pages", "pages__unique__0"));
+  ASSERT_EQ(DB_SUCCESS, catalog->DropIndex("pages", "pages__unique__1"));
+  IndexInfo *url_index = nullptr;
+  IndexInfo *score_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("pages", "url_index", {"url"}, nullptr, url_index,
+                                             kIndexPrefixBPlusTree));
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("pages", "score_index", {"score"}, nullptr, score_index,
+                                             kIndexPrefixBPlusTree));
+  auto url_key = [](int value) {
+    std::string url = MakeUrl(value);
+    return MakeRow(Field(TypeId::kTypeChar, const_cast<char *>(url.c_str()), url.size(), true));
+  };
+  const int n = 3000;
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(DB_SUCCESS, url_index->GetIndex()->InsertIfAbsent(url_key(i), RowId(i, 0), nullptr));
+  }
+  ASSERT_EQ(DB_KEY_ALREADY_EXIST, url_index->GetIndex()->InsertIfAbsent(url_key(7), RowId(7, 1), nullptr));
+  ASSERT_EQ(DB_SUCCESS, url_index->GetIndex()->RemoveEntry(url_key(7), RowId(7, 0), nullptr));
+  ASSERT_EQ(DB_KEY_NOT_FOUND, url_index->GetIndex()->RemoveEntry(url_key(7), RowId(7, 0), nullptr));
+  // -0.0 and 0.0 are the same key
+  Row zero = MakeRow(Field(TypeId::kTypeFloat, 0.0f));
+  Row negative_zero = MakeRow(Field(TypeId::kTypeFloat, -0.0f));
+  Row one = MakeRow(Field(TypeId::kTypeFloat, 1.0f));
+  ASSERT_EQ(DB_SUCCESS, score_index->GetIndex()->InsertIfAbsent(negative_zero, RowId(1, 0), nullptr));
+  ASSERT_EQ(DB_KEY_ALREADY_EXIST, score_index->GetIndex()->InsertIfAbsent(zero, RowId(2, 0), nullptr));
+  ASSERT_EQ(DB_SUCCESS, score_index->GetIndex()->InsertIfAbsent(one, RowId(3, 0), nullptr));
+  delete engine;
+
+  // the indexes are found again, with their entries, when the database is reopened
+  engine = new DBStorageEngine(db_name, false);
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->GetIndex("pages", "url_index", url_index));
+  ASSERT_EQ(kIndexPrefixBPlusTree, url_index->GetIndexType());
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, url_index->GetIndex()->ScanKey(url_key(2999), result, nullptr));
+  ASSERT_EQ(1u, result.size());
+  ASSERT_EQ(2999, result[0].GetPageId());
+  result.clear();
+  ASSERT_EQ(DB_SUCCESS, url_index->GetIndex()->ScanKey(url_key(7), result, nullptr));
+  ASSERT_TRUE(result.empty());
+  Row low = url_key(5), high = url_key(10);
+  ASSERT_EQ(DB_SUCCESS, url_index->GetIndex()->ScanRange(&low, &high, result, nullptr));
+  std::vector<int> pages;
+  for (auto &row_id : result) {
+    pages.push_back(row_id.GetPageId());
+  }
+  ASSERT_EQ((std::vector<int>{5, 6, 8, 9, 10}), pages);
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->GetIndex("pages", "score_index", score_index));
+  result.clear();
+  ASSERT_EQ(DB_SUCCESS, score_index->GetIndex()->ScanRange(&zero, &one, result, nullptr));
+  ASSERT_EQ(2u, result.size());
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->DropIndex("pages", "url_index"));
+  delete engine;
+  remove(db_name.c_str());
+}
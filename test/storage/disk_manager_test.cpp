@@ -55,4 +55,38 @@ TEST(DiskManagerTest, FreePageAllocationTest) {
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 2, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 3, meta_page->GetExtentUsedPage(1));
   remove(db_name.c_str());
-}
\ No newline at end of file
+}
+
+TEST(DiskManagerTest, BatchDeAllocateTest) {
+  std::string db_name = "disk_batch_test.db";
+  remove(db_name.c_str());
+  DiskManager *disk_mgr = new DiskManager(db_name);
+  const uint32_t n = DiskManager::BITMAP_SIZE + 100;
+  for (uint32_t i = 0; i < n; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  // every other page of both extents, unsorted and with a duplicate
+  std::vector<page_id_t> pages;
+  for (uint32_t i = 0; i < n; i += 2) {
+    pages.push_back(n - 1 - i);
+  }
+  pages.push_back(n - 1);
+  disk_mgr->DeAllocatePages(pages);
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(n - (pages.size() - 1), meta_page->GetAllocatedPages());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE / 2, meta_page->GetExtentUsedPage(0));
+  EXPECT_EQ(50, meta_page->GetExtentUsedPage(1));
+  for (uint32_t i = 0; i + 1 < pages.size(); i++) {
+    EXPECT_TRUE(disk_mgr->IsPageFree(pages[i]));
+  }
+  delete disk_mgr;
+  // the meta page is written back on shutdown, freed pages are handed out again
+  disk_mgr = new DiskManager(db_name);
+  meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(n - (pages.size() - 1), meta_page->GetAllocatedPages());
+  EXPECT_EQ(2, meta_page->GetExtentNums());
+  EXPECT_EQ(1, disk_mgr->AllocatePage());
+  EXPECT_FALSE(disk_mgr->IsPageFree(0));
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
@@ -89,3 +89,33 @@ TEST(TableHeapTest, TableHeapSampleTest) {
     ASSERT_EQ(CmpBool::kTrue, testUpdated.GetField(i)->CompareEquals(updated_fields->at(i)));
   }
 }
+
+TEST(TableHeapTest, TableHeapFreeHeapTest) {
+  DBStorageEngine engine(db_file_name);
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  auto meta_page = reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData());
+  const uint32_t allocated = meta_page->GetAllocatedPages();
+  std::string name(60, 'a');
+  auto fill = [&](TableHeap *table_heap) {
+    for (int i = 0; i < 5000; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 60, true)};
+      Row row(fields);
+      ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    }
+  };
+  TableHeap *table_heap = TableHeap::Create(engine.bpm_, schema.get(), nullptr, nullptr, nullptr, &heap);
+  fill(table_heap);
+  const uint32_t heap_pages = meta_page->GetAllocatedPages() - allocated;
+  ASSERT_GT(heap_pages, 1u);
+  // every page of the heap goes back to the disk manager
+  table_heap->FreeHeap();
+  ASSERT_EQ(allocated, meta_page->GetAllocatedPages());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+  // and is reused by the next heap
+  table_heap = TableHeap::Create(engine.bpm_, schema.get(), nullptr, nullptr, nullptr, &heap);
+  fill(table_heap);
+  ASSERT_EQ(allocated + heap_pages, meta_page->GetAllocatedPages());
+}